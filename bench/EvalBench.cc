@@ -0,0 +1,129 @@
+// 실행 엔진 벤치마크
+// 클로저 평가기가 초당 몇 개의 노드를 평가하는지 잰다. 노드 수는 세기 모드로
+// 한 번 실행해서 얻고, 시간은 세기 모드를 끈 평가기로 잰다.
+// 같은 프로그램을 Zust Machine 바이트코드로 돌린 시간도 비교용으로 함께 출력한다.
+#include <BytecodeCompiler.hh>
+#include <Compiler.hh>
+#include <Evaluator.hh>
+#include <Program.hh>
+#include <ZustMachine.hh>
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+using Clock = std::chrono::steady_clock;
+
+template<typename F>
+static double measure(int rounds, F&& body) {
+    double best = 1e30;
+    for (int r = 0; r < rounds; ++r) {
+        auto start = Clock::now();
+        body();
+        double sec = std::chrono::duration<double>(Clock::now() - start).count();
+        if (sec < best) best = sec;
+    }
+    return best;
+}
+
+static const char* const Fib = R"(
+fn fib(int n) : int {
+    if (n < 2) { return n; }
+    return fib(n - 1) + fib(n - 2);
+}
+fn main() : int { return fib(25); }
+)";
+
+static const char* const Loops = R"(
+fn main() : int {
+    let total: int = 0;
+    let i: int = 0;
+    while (i < 1000) {
+        let j: int = 0;
+        while (j < 300) {
+            total = total + (i * j) % 7;
+            j = j + 1;
+        }
+        i = i + 1;
+    }
+    return total;
+}
+)";
+
+static const char* const FloatLoop = R"(
+fn main() : int {
+    let x: double = 0.0;
+    let i: int = 0;
+    while (i < 200000) {
+        x = x + i * 0.5;
+        i = i + 1;
+    }
+    if (x > 0.0) { return 1; }
+    return 0;
+}
+)";
+
+// src/main.cc 의 테스트 프로그램
+static const char* const Sample = R"(
+namespace TestNamespace {
+    fn add(int a, int b) {
+        return a + b;
+    }
+
+    fn main() {
+        let x: int = 10;
+        let y: int = 20;
+        let result: int = add(x, y);
+
+        if (result > 25) {
+            let message: string = "Result is greater than 25";
+        }
+
+        let i: int = 0;
+        while (i < 5) {
+            i = i + 1;
+        }
+
+        return 0;
+    }
+}
+)";
+
+static void run(const char* label, const char* source, int repeat) {
+    Compiler compiler;
+    std::unique_ptr<Program> program = compiler.analyze(SourceBuffer(std::string(source)));
+
+    Evaluator counting(true);
+    counting.load(program.get());
+    int64_t expected = counting.run();
+    double nodes = static_cast<double>(counting.nodesEvaluated()) * repeat;
+
+    Evaluator evaluator;
+    evaluator.load(program.get());
+    volatile int64_t sink = 0;
+    double closures = measure(5, [&] {
+        for (int r = 0; r < repeat; ++r) sink = sink + evaluator.run();
+    });
+
+    BytecodeCompiler lowering;
+    Module module = lowering.compile(program.get());
+    ZustMachine machine(module);
+    double vm = measure(5, [&] {
+        for (int r = 0; r < repeat; ++r) sink = sink + machine.run().i;
+    });
+
+    if (machine.run().i != expected) {
+        std::printf("%-12s result mismatch between evaluator and Zust Machine\n", label);
+    }
+    std::printf("%-12s %12.0f nodes   closures %8.2f ms %8.2f Mnodes/s   vm %8.2f ms\n",
+        label, nodes, closures * 1e3, nodes / closures / 1e6, vm * 1e3);
+}
+
+int main() {
+    run("fib(25)", Fib, 1);
+    run("loops", Loops, 1);
+    run("float loop", FloatLoop, 1);
+    run("sample", Sample, 10000);
+    return 0;
+}
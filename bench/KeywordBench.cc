@@ -0,0 +1,108 @@
+// 키워드 분류 마이크로 벤치마크
+// 예전 방식(Lexer 마다 채우는 std::map + find/operator[])과
+// 컴파일 타임 완전 해시(classifyKeyword)의 식별자 처리량을 비교한다.
+#include <Keywords.hh>
+#include <Lexer.hh>
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static std::vector<std::string> makeWords(size_t n) {
+    static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz_ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+    std::mt19937 rng(42);
+    std::vector<std::string> words;
+    words.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (rng() % 10 < 3) {
+            words.emplace_back(keywords::table[rng() % keywords::count].spelling);
+            continue;
+        }
+        std::string w(1, alphabet[rng() % 53]);
+        size_t len = 1 + rng() % 12;
+        for (size_t k = 1; k < len; ++k) w += alphabet[rng() % 63];
+        words.push_back(std::move(w));
+    }
+    return words;
+}
+
+// 예전 Lexer::initKeywords() 와 같은 테이블
+static std::map<std::string, TokenType> legacyTable() {
+    return {
+        {"let", TokenType::LET}, {"fn", TokenType::FN},
+        {"if", TokenType::IF}, {"while", TokenType::WHILE},
+        {"for", TokenType::FOR}, {"foreach", TokenType::FOREACH},
+        {"switch", TokenType::SWITCH}, {"case", TokenType::CASE},
+        {"default", TokenType::DEFAULT}, {"namespace", TokenType::NAMESPACE},
+        {"import", TokenType::IMPORT}, {"return", TokenType::RETURN},
+        {"break", TokenType::BREAK}, {"continue", TokenType::CONTINUE},
+        {"int", TokenType::INT}, {"float", TokenType::FLOAT},
+        {"char", TokenType::CHAR}, {"byte", TokenType::BYTE},
+        {"long", TokenType::LONG}, {"double", TokenType::DOUBLE},
+        {"short", TokenType::SHORT}, {"bool", TokenType::BOOL},
+        {"string", TokenType::STRING}, {"void", TokenType::VOID},
+        {"true", TokenType::BOOL_LITERAL}, {"false", TokenType::BOOL_LITERAL}
+    };
+}
+
+template<typename F>
+static double measure(const char* name, size_t items, int rounds, F&& body) {
+    double best = 1e30;
+    for (int r = 0; r < rounds; ++r) {
+        auto start = Clock::now();
+        body();
+        double sec = std::chrono::duration<double>(Clock::now() - start).count();
+        if (sec < best) best = sec;
+    }
+    double rate = items / best / 1e6;
+    std::printf("%-28s %10.2f M ident/s  (%.3f ms)\n", name, rate, best * 1e3);
+    return rate;
+}
+
+int main() {
+    const size_t n = 2000000;
+    const int rounds = 5;
+    auto words = makeWords(n);
+    volatile unsigned sink = 0;
+
+    double before = measure("std::map (before)", n, rounds, [&] {
+        auto table = legacyTable();
+        unsigned acc = 0;
+        for (const auto& w : words) {
+            std::string id(w.data(), w.size());
+            TokenType type = TokenType::IDENTIFIER;
+            if (table.find(id) != table.end()) {
+                type = table[id];
+            }
+            acc += static_cast<unsigned>(type);
+        }
+        sink = sink + acc;
+    });
+
+    double after = measure("perfect hash (after)", n, rounds, [&] {
+        unsigned acc = 0;
+        for (const auto& w : words) {
+            acc += static_cast<unsigned>(classifyKeyword(w));
+        }
+        sink = sink + acc;
+    });
+
+    std::printf("%-28s %10.2fx\n", "speedup", after / before);
+
+    // 렉서 전체 경로에서의 식별자 처리량
+    std::string source;
+    for (const auto& w : words) {
+        source += w;
+        source += ' ';
+    }
+    measure("Lexer::tokenize", n, rounds, [&] {
+        Lexer lexer(source);
+        sink = sink + static_cast<unsigned>(lexer.tokenize().size());
+    });
+    return 0;
+}
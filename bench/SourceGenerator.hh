@@ -0,0 +1,165 @@
+#ifndef SourceGenerator_hh
+#define SourceGenerator_hh
+
+// 벤치마크용 합성 Zust 소스 생성기
+// 크기와 모양을 Shape 로 정하면 의미 분석까지 통과하는 프로그램을 만든다.
+// 같은 Shape 와 seed 에서는 항상 같은 소스가 나온다.
+#include <cstdint>
+#include <random>
+#include <string>
+
+class SourceGenerator {
+public:
+    struct Shape {
+        int functions = 100;        // 함수 수
+        int statements = 8;         // 함수마다 문장 수
+        int expressionDepth = 3;    // 식의 괄호 중첩 깊이
+        int namespaces = 0;         // 함수를 나눠 담을 네임스페이스 수 (0 이면 최상위에 둔다)
+        int globals = 0;            // 네임스페이스(또는 최상위)마다 전역 변수 수
+        int commentLines = 0;       // 문장마다 앞에 붙는 주석 줄 수
+        int strings = 0;            // 함수마다 문자열 문장 수
+        uint32_t seed = 1;
+    };
+
+private:
+    Shape shape;
+    std::mt19937 random;
+    std::string out;
+    int locals = 0;     // 지금 함수에 선언된 int 지역 변수 v0..v(locals-1)
+
+    inline int pick(int n) {
+        return static_cast<int>(random() % static_cast<uint32_t>(n));
+    }
+
+    inline void line(int depth, const std::string& text) {
+        out.append(static_cast<size_t>(depth) * 4, ' ');
+        out += text;
+        out += '\n';
+    }
+
+    inline void comments(int depth) {
+        static const char* const Words[] = {
+            "지역 변수를 갱신한다", "loop invariant holds here", "TODO: 나중에 정리",
+            "see the note above", "경계 조건 확인", "fast path for small inputs",
+        };
+        for (int i = 0; i < shape.commentLines; ++i) {
+            line(depth, std::string("# ") + Words[pick(6)] + " (" + std::to_string(i) + ")");
+        }
+    }
+
+    // 깊이 0 이면 잎, 아니면 한쪽만 다시 내려가서 크기는 깊이에 비례한다
+    inline std::string leaf() {
+        int choice = pick(locals > 0 ? 4 : 3);
+        switch (choice) {
+            case 0: return "a";
+            case 1: return "b";
+            case 2: return std::to_string(1 + pick(99));
+            default: return "v" + std::to_string(pick(locals));
+        }
+    }
+
+    inline std::string expression(int depth) {
+        if (depth <= 0) return leaf();
+        static const char* const Ops[] = { " + ", " - ", " * ", " & ", " | ", " ^ " };
+        std::string inner = expression(depth - 1);
+        std::string op = Ops[pick(6)];
+        return pick(2) ? "(" + inner + op + leaf() + ")" : "(" + leaf() + op + inner + ")";
+    }
+
+    inline void statement(int depth, int index, int previousFunction) {
+        if (shape.commentLines > 0) comments(depth);
+        int kind = locals == 0 ? 0 : pick(previousFunction >= 0 ? 5 : 4);
+        std::string v = "v" + std::to_string(locals > 0 ? pick(locals) : 0);
+        switch (kind) {
+            case 0:
+                line(depth, "let v" + std::to_string(locals) + ": int = " + expression(shape.expressionDepth) + ";");
+                locals++;
+                break;
+            case 1:
+                line(depth, "if (" + v + " > " + expression(shape.expressionDepth / 2) + ") {");
+                line(depth + 1, v + " = " + v + " - 1;");
+                line(depth, "} else {");
+                line(depth + 1, v + " = " + expression(shape.expressionDepth) + ";");
+                line(depth, "}");
+                break;
+            case 2:
+                line(depth, "while (" + v + " < " + std::to_string(100 + index) + ") {");
+                line(depth + 1, v + " = " + v + " + " + expression(shape.expressionDepth / 2) + ";");
+                line(depth, "}");
+                break;
+            case 3:
+                line(depth, v + " = " + expression(shape.expressionDepth) + ";");
+                break;
+            default:
+                line(depth, "let v" + std::to_string(locals) + ": int = f" + std::to_string(previousFunction) +
+                    "(" + v + ", " + leaf() + ");");
+                locals++;
+                break;
+        }
+    }
+
+    inline void stringStatement(int depth, int index) {
+        static const char* const Texts[] = {
+            "lorem ipsum dolor sit amet", "escaped \\\"quotes\\\" and \\t tabs",
+            "한글 문자열도 섞는다", "line one\\nline two\\n", "a fairly long literal to stress the string scanner path",
+        };
+        std::string s = "s" + std::to_string(index);
+        line(depth, "let " + s + ": string = \"" + Texts[pick(5)] + "\";");
+        line(depth, s + " = " + s + " + \"" + Texts[pick(5)] + "\";");
+    }
+
+    inline void function(int depth, int index, int previousFunction) {
+        locals = 0;
+        line(depth, "fn f" + std::to_string(index) + "(int a, int b) : int {");
+        for (int i = 0; i < shape.statements; ++i) {
+            statement(depth + 1, i, previousFunction);
+        }
+        for (int i = 0; i < shape.strings; ++i) {
+            if (shape.commentLines > 0) comments(depth + 1);
+            stringStatement(depth + 1, i);
+        }
+        line(depth + 1, locals > 0 ? "return v" + std::to_string(locals - 1) + " + a;" : "return a + b;");
+        line(depth, "}");
+    }
+
+    inline void globalsAt(int depth, int group) {
+        for (int i = 0; i < shape.globals; ++i) {
+            if (shape.commentLines > 0) comments(depth);
+            line(depth, "let g" + std::to_string(group) + "_" + std::to_string(i) + ": int = " +
+                std::to_string(pick(1000)) + ";");
+        }
+    }
+
+public:
+    inline explicit SourceGenerator(Shape s) : shape(s), random(s.seed) {}
+
+    inline std::string generate() {
+        out.clear();
+        random.seed(shape.seed);
+        if (shape.namespaces <= 0) {
+            globalsAt(0, 0);
+            for (int f = 0; f < shape.functions; ++f) {
+                function(0, f, f - 1);
+            }
+        } else {
+            // 네임스페이스 본문은 블록 스코프이므로 같은 네임스페이스 안의 함수만 부른다
+            int perNamespace = (shape.functions + shape.namespaces - 1) / shape.namespaces;
+            int f = 0;
+            for (int n = 0; n < shape.namespaces; ++n) {
+                line(0, "namespace N" + std::to_string(n) + " {");
+                globalsAt(1, n);
+                int first = f;
+                for (int i = 0; i < perNamespace && f < shape.functions; ++i, ++f) {
+                    function(1, f, f > first ? f - 1 : -1);
+                }
+                line(0, "}");
+            }
+        }
+        line(0, "fn main() : int {");
+        line(1, "return 0;");
+        line(0, "}");
+        return out;
+    }
+};
+
+#endif
@@ -0,0 +1,114 @@
+// 심볼 테이블 벤치마크
+// 깊게 중첩된 블록과 수천 개의 지역 변수에서 예전 구조(스코프마다 unordered_map,
+// 문자열 키)와 평평한 개방 주소 테이블(Name 키)을 비교한다.
+#include <Symbol.hh>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// 예전 SymbolTable 과 같은 구조
+class LegacySymbolTable {
+    struct LegacySymbol {
+        std::string name;
+        std::string type;
+        bool isFunction = false;
+        std::vector<std::string> paramTypes;
+    };
+    std::vector<std::unordered_map<std::string, LegacySymbol>> scopes;
+
+public:
+    LegacySymbolTable() { pushScope(); }
+    void pushScope() { scopes.emplace_back(); }
+    void popScope() { if (scopes.size() > 1) scopes.pop_back(); }
+    void declare(const std::string& name, const std::string& type) {
+        if (scopes.back().find(name) != scopes.back().end()) {
+            throw std::runtime_error("already declared");
+        }
+        scopes.back()[name] = LegacySymbol{name, type, false, {}};
+    }
+    const LegacySymbol* lookup(const std::string& name) const {
+        for (auto it = scopes.rbegin(); it != scopes.rend(); ++it) {
+            auto found = it->find(name);
+            if (found != it->end()) return &found->second;
+        }
+        return nullptr;
+    }
+};
+
+struct Workload {
+    int depth;            // 중첩 블록 깊이
+    int localsPerScope;   // 블록마다 선언하는 지역 변수 수
+    int lookupsPerScope;  // 블록마다 바깥 변수를 찾는 횟수
+};
+
+template<typename F>
+static double measure(int rounds, F&& body) {
+    double best = 1e30;
+    for (int r = 0; r < rounds; ++r) {
+        auto start = Clock::now();
+        body();
+        double sec = std::chrono::duration<double>(Clock::now() - start).count();
+        if (sec < best) best = sec;
+    }
+    return best;
+}
+
+static void run(const char* label, const Workload& w) {
+    // 블록 d 의 i 번째 지역 변수 이름: v<d>_<i>
+    std::vector<std::vector<std::string>> spellings(w.depth);
+    std::vector<std::vector<Name>> names(w.depth);
+    for (int d = 0; d < w.depth; ++d) {
+        for (int i = 0; i < w.localsPerScope; ++i) {
+            spellings[d].push_back("v" + std::to_string(d) + "_" + std::to_string(i));
+            names[d].push_back(intern(spellings[d].back()));
+        }
+    }
+    const std::string intSpelling = "int";
+    size_t ops = 0;
+    volatile size_t sink = 0;
+
+    double legacy = measure(5, [&] {
+        LegacySymbolTable table;
+        size_t found = 0;
+        for (int d = 0; d < w.depth; ++d) {
+            table.pushScope();
+            for (const auto& s : spellings[d]) table.declare(s, intSpelling);
+            for (int k = 0; k < w.lookupsPerScope; ++k) {
+                found += table.lookup(spellings[(d * 7 + k) % (d + 1)][k % w.localsPerScope]) != nullptr;
+            }
+        }
+        for (int d = 0; d < w.depth; ++d) table.popScope();
+        sink = sink + found;
+    });
+
+    double flat = measure(5, [&] {
+        SymbolTable table;
+        size_t found = 0;
+        for (int d = 0; d < w.depth; ++d) {
+            table.pushScope();
+            for (Name n : names[d]) table.declare(n, &types::Int);
+            for (int k = 0; k < w.lookupsPerScope; ++k) {
+                found += table.lookup(names[(d * 7 + k) % (d + 1)][k % w.localsPerScope]) != nullptr;
+            }
+        }
+        for (int d = 0; d < w.depth; ++d) table.popScope();
+        sink = sink + found;
+    });
+
+    ops = static_cast<size_t>(w.depth) * (w.localsPerScope + w.lookupsPerScope);
+    std::printf("%-34s legacy %8.2f Mops/s   flat %8.2f Mops/s   %6.2fx\n",
+        label, ops / legacy / 1e6, ops / flat / 1e6, legacy / flat);
+}
+
+int main() {
+    run("deep nesting (512 x 8 locals)", Workload{512, 8, 64});
+    run("very deep nesting (4096 x 2)", Workload{4096, 2, 16});
+    run("thousands of locals (1 x 5000)", Workload{1, 5000, 20000});
+    run("wide blocks (64 x 1000)", Workload{64, 1000, 2000});
+    return 0;
+}
@@ -0,0 +1,386 @@
+// 컴파일러 단계별 벤치마크 (zust_bench)
+// SourceGenerator 로 모양이 다른 합성 프로그램을 만들고 토큰 버퍼 채우기(TokenBuffer),
+// Parser::parse, SemanticAnalyser::analyze, CodeGenerator::generate 를 따로 잰다.
+// 출력은 Google Benchmark 와 같은 모양이라 같은 도구(compare.py 등)로 비교할 수 있다:
+//   --benchmark_format=console|json|csv   표준 출력 형식
+//   --benchmark_out=FILE                  결과를 파일에도 쓴다 (--benchmark_out_format, 기본 json)
+//   --benchmark_filter=REGEX              이름이 맞는 벤치마크만 돌린다
+//   --benchmark_min_time=SEC              벤치마크마다 최소 측정 시간 (기본 0.5)
+//   --benchmark_list_tests                이름만 출력한다
+//   --scale=N                             작업량 크기 배수 (기본 1)
+//   --emit-source=WORKLOAD                생성한 소스를 출력하고 끝낸다
+// BM_LoadAst 는 --emit-ast 이미지를 검사하고 노드로 되살리는 시간(파싱 대신 드는 비용)을 잰다.
+// BM_Edit 은 열어 둔 Document 에 한 글자 편집을 넣고 다시 파싱하는 시간을 잰다.
+#include "./SourceGenerator.hh"
+
+#include <AstImage.hh>
+#include <CodeGenerator.hh>
+#include <Compiler.hh>
+#include <Document.hh>
+#include <Lexer.hh>
+#include <Parser.hh>
+#include <Profiler.hh>
+#include <Program.hh>
+#include <SemanticAnalyser.hh>
+#include <TokenBuffer.hh>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <regex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ===== 측정 =====
+// 한 번 돌 때마다 start/stop 사이만 잰다. 준비 작업(입력 복사, 새 분석기)은 바깥에 둔다.
+class State {
+private:
+    uint64_t wallStart = 0, cpuStart = 0;
+
+public:
+    uint64_t wallNs = 0, cpuNs = 0;
+
+    inline void start() {
+        wallStart = Profiler::nowNs();
+        cpuStart = Profiler::threadCpuNs();
+    }
+    inline void stop() {
+        wallNs += Profiler::nowNs() - wallStart;
+        cpuNs += Profiler::threadCpuNs() - cpuStart;
+    }
+};
+
+struct Workload {
+    std::string name;
+    std::string source;
+    size_t tokens = 0;
+    size_t nodes = 0;
+};
+
+struct Benchmark {
+    std::string name;
+    const Workload* workload;
+    std::function<void(State&)> body;   // 한 번 돌고, 잰 구간은 State 에 더한다
+};
+
+struct Result {
+    std::string name;
+    uint64_t iterations;
+    double realNs;      // 한 번 도는 데 걸린 시간
+    double cpuNs;
+    double bytesPerSecond;
+    double nodesPerSecond;
+};
+
+// 최소 시간을 넘길 때까지 반복 횟수를 늘린다 (Google Benchmark 와 같은 방식)
+static Result run(const Benchmark& bench, double minTime) {
+    uint64_t iterations = 1;
+    State state;
+    for (;;) {
+        state = State();
+        for (uint64_t i = 0; i < iterations; ++i) bench.body(state);
+        double sec = state.wallNs / 1e9;
+        if (sec >= minTime || iterations >= (1ull << 30)) break;
+        double grow = sec > 0 ? minTime * 1.4 / sec : 10.0;
+        if (grow > 10.0) grow = 10.0;
+        if (grow < 2.0 && sec < minTime / 2) grow = 2.0;
+        uint64_t next = static_cast<uint64_t>(iterations * grow);
+        iterations = next > iterations ? next : iterations + 1;
+    }
+
+    Result r;
+    r.name = bench.name;
+    r.iterations = iterations;
+    r.realNs = static_cast<double>(state.wallNs) / iterations;
+    r.cpuNs = static_cast<double>(state.cpuNs) / iterations;
+    double sec = r.realNs / 1e9;
+    r.bytesPerSecond = sec > 0 ? bench.workload->source.size() / sec : 0;
+    r.nodesPerSecond = sec > 0 ? bench.workload->nodes / sec : 0;
+    return r;
+}
+
+// ===== 작업량 =====
+static std::vector<Workload> makeWorkloads(int scale) {
+    struct Preset {
+        const char* name;
+        SourceGenerator::Shape shape;
+    };
+    std::vector<Preset> presets;
+
+    SourceGenerator::Shape s;
+    s.functions = 400 * scale;
+    presets.push_back({"many_functions", s});
+
+    s = SourceGenerator::Shape();
+    s.functions = 20 * scale;
+    s.statements = 6;
+    s.expressionDepth = 60;
+    presets.push_back({"deep_expressions", s});
+
+    s = SourceGenerator::Shape();
+    s.functions = 300 * scale;
+    s.namespaces = 1;
+    s.globals = 500 * scale;
+    presets.push_back({"long_namespace", s});
+
+    s = SourceGenerator::Shape();
+    s.functions = 100 * scale;
+    s.commentLines = 4;
+    presets.push_back({"comment_heavy", s});
+
+    s = SourceGenerator::Shape();
+    s.functions = 100 * scale;
+    s.statements = 2;
+    s.strings = 12;
+    presets.push_back({"string_heavy", s});
+
+    std::vector<Workload> workloads;
+    for (const Preset& p : presets) {
+        Workload w;
+        w.name = p.name;
+        w.source = SourceGenerator(p.shape).generate();
+
+        // 처리량 계산에 쓸 토큰 수와 노드 수. 생성한 소스가 분석을 통과하는지도 여기서 확인한다.
+        Lexer lexer(w.source);
+        TokenBuffer tokens(lexer);
+        w.tokens = tokens.size();
+        Parser parser(tokens);
+        std::unique_ptr<Program> program = parser.parse();
+        w.nodes = program->arena.nodeCount();
+        SemanticAnalyser analyzer;
+        analyzer.analyze(program.get());
+        workloads.push_back(std::move(w));
+    }
+    return workloads;
+}
+
+// ===== 벤치마크 =====
+// 단계마다 입력은 앞 단계를 한 번 돌려서 만들어 두고, 그 단계만 반복해서 잰다.
+static std::vector<Benchmark> makeBenchmarks(const std::vector<Workload>& workloads) {
+    std::vector<Benchmark> benches;
+    for (const Workload& w : workloads) {
+        benches.push_back({"BM_Tokenize/" + w.name, &w, [&w](State& state) {
+            Lexer lexer(w.source);
+            state.start();
+            TokenBuffer tokens(lexer);
+            state.stop();
+        }});
+
+        // 토큰이 렉서의 버퍼를 가리키므로 렉서를 벤치마크와 함께 살려 둔다
+        auto lexer = std::make_shared<Lexer>(w.source);
+        auto tokens = std::make_shared<TokenBuffer>(*lexer);
+        benches.push_back({"BM_Parse/" + w.name, &w, [lexer, tokens](State& state) {
+            Parser parser(*tokens);
+            state.start();
+            std::unique_ptr<Program> program = parser.parse();
+            state.stop();
+        }});
+
+        // 의미 분석은 같은 AST 에 다시 돌려도 결과가 같으므로 한 번 파싱한 것을 계속 쓴다
+        std::shared_ptr<Program> program = Parser(*tokens).parse();
+        benches.push_back({"BM_Analyze/" + w.name, &w, [program](State& state) {
+            SemanticAnalyser analyzer;
+            state.start();
+            analyzer.analyze(program.get());
+            state.stop();
+        }});
+
+        auto image = std::make_shared<std::string>(AstImage::serialize(program.get()));
+        benches.push_back({"BM_LoadAst/" + w.name, &w, [image](State& state) {
+            SourceBuffer buffer(*image);
+            state.start();
+            AstImage loaded(std::move(buffer));
+            std::unique_ptr<Program> restored = loaded.materialize();
+            state.stop();
+        }});
+
+        benches.push_back({"BM_Generate/" + w.name, &w, [program](State& state) {
+            CodeGenerator generator;
+            state.start();
+            std::string output = generator.generate(program.get());
+            state.stop();
+        }});
+
+        benches.push_back({"BM_Compile/" + w.name, &w, [&w](State& state) {
+            Compiler compiler;
+            state.start();
+            std::string output = compiler.compile(w.source);
+            state.stop();
+        }});
+
+        // 파일 한가운데 함수 본문에 공백 하나를 넣고, 다음 번에는 지운다
+        auto document = std::make_shared<Document>(w.source);
+        size_t middle = w.source.find("return", w.source.size() / 2);
+        if (middle == std::string::npos) middle = w.source.size() / 2;
+        auto inserted = std::make_shared<bool>(false);
+        benches.push_back({"BM_Edit/" + w.name, &w, [document, middle, inserted](State& state) {
+            state.start();
+            if (*inserted) {
+                document->edit(middle, 1, "");
+            } else {
+                document->edit(middle, 0, " ");
+            }
+            state.stop();
+            *inserted = !*inserted;
+        }});
+    }
+    return benches;
+}
+
+// ===== 출력 =====
+static std::string jsonString(const std::string& s) {
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out + "\"";
+}
+
+static void printJson(std::ostream& os, const std::vector<Workload>& workloads,
+                      const std::vector<Result>& results, int scale) {
+    os << "{\n  \"context\": {\n";
+    os << "    \"executable\": \"zust_bench\",\n";
+    os << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+    os << "    \"scale\": " << scale << ",\n";
+    os << "    \"compiler_version\": " << jsonString(Compiler::Version) << ",\n";
+    os << "    \"workloads\": [\n";
+    for (size_t i = 0; i < workloads.size(); ++i) {
+        const Workload& w = workloads[i];
+        os << "      {\"name\": " << jsonString(w.name) << ", \"bytes\": " << w.source.size()
+           << ", \"tokens\": " << w.tokens << ", \"nodes\": " << w.nodes << "}"
+           << (i + 1 < workloads.size() ? ",\n" : "\n");
+    }
+    os << "    ]\n  },\n  \"benchmarks\": [\n";
+    char buf[512];
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::snprintf(buf, sizeof buf,
+            "    {\n"
+            "      \"name\": %s,\n"
+            "      \"run_name\": %s,\n"
+            "      \"run_type\": \"iteration\",\n"
+            "      \"iterations\": %llu,\n"
+            "      \"real_time\": %.3f,\n"
+            "      \"cpu_time\": %.3f,\n"
+            "      \"time_unit\": \"ns\",\n"
+            "      \"bytes_per_second\": %.1f,\n"
+            "      \"items_per_second\": %.1f\n"
+            "    }%s\n",
+            jsonString(r.name).c_str(), jsonString(r.name).c_str(),
+            static_cast<unsigned long long>(r.iterations), r.realNs, r.cpuNs,
+            r.bytesPerSecond, r.nodesPerSecond, i + 1 < results.size() ? "," : "");
+        os << buf;
+    }
+    os << "  ]\n}\n";
+}
+
+static void printCsv(std::ostream& os, const std::vector<Result>& results) {
+    os << "name,iterations,real_time,cpu_time,time_unit,bytes_per_second,items_per_second\n";
+    char buf[256];
+    for (const Result& r : results) {
+        std::snprintf(buf, sizeof buf, "\"%s\",%llu,%.3f,%.3f,ns,%.1f,%.1f\n",
+            r.name.c_str(), static_cast<unsigned long long>(r.iterations),
+            r.realNs, r.cpuNs, r.bytesPerSecond, r.nodesPerSecond);
+        os << buf;
+    }
+}
+
+static void printConsoleHeader(const std::vector<Workload>& workloads) {
+    std::printf("%-18s %10s %10s %10s\n", "workload", "bytes", "tokens", "nodes");
+    for (const Workload& w : workloads) {
+        std::printf("%-18s %10zu %10zu %10zu\n", w.name.c_str(), w.source.size(), w.tokens, w.nodes);
+    }
+    std::printf("\n%-30s %13s %13s %11s %10s %12s\n",
+        "Benchmark", "Time", "CPU", "Iterations", "MB/s", "Mnodes/s");
+    std::printf("%s\n", std::string(94, '-').c_str());
+}
+
+static void printConsoleRow(const Result& r) {
+    std::printf("%-30s %10.0f ns %10.0f ns %11llu %10.1f %12.2f\n",
+        r.name.c_str(), r.realNs, r.cpuNs, static_cast<unsigned long long>(r.iterations),
+        r.bytesPerSecond / 1e6, r.nodesPerSecond / 1e6);
+    std::fflush(stdout);
+}
+
+static bool flag(const char* arg, const char* name, std::string& value) {
+    size_t n = std::strlen(name);
+    if (std::strncmp(arg, name, n) != 0 || arg[n] != '=') return false;
+    value = arg + n + 1;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::string format = "console", outFile, outFormat = "json", filter, emit;
+    double minTime = 0.5;
+    int scale = 1;
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string value;
+        if (flag(argv[i], "--benchmark_format", value)) format = value;
+        else if (flag(argv[i], "--benchmark_out", value)) outFile = value;
+        else if (flag(argv[i], "--benchmark_out_format", value)) outFormat = value;
+        else if (flag(argv[i], "--benchmark_filter", value)) filter = value;
+        else if (flag(argv[i], "--benchmark_min_time", value)) minTime = std::stod(value);
+        else if (flag(argv[i], "--scale", value)) scale = std::stoi(value);
+        else if (flag(argv[i], "--emit-source", value)) emit = value;
+        else if (std::strcmp(argv[i], "--benchmark_list_tests") == 0) list = true;
+        else {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if (scale < 1) scale = 1;
+    if (format != "console" && format != "json" && format != "csv") {
+        std::fprintf(stderr, "Unknown format: %s\n", format.c_str());
+        return 1;
+    }
+
+    std::vector<Workload> workloads = makeWorkloads(scale);
+    if (!emit.empty()) {
+        for (const Workload& w : workloads) {
+            if (w.name == emit) {
+                std::fwrite(w.source.data(), 1, w.source.size(), stdout);
+                return 0;
+            }
+        }
+        std::fprintf(stderr, "Unknown workload: %s\n", emit.c_str());
+        return 1;
+    }
+
+    std::vector<Benchmark> all = makeBenchmarks(workloads);
+    std::vector<const Benchmark*> selected;
+    std::regex pattern(filter.empty() ? "." : filter);
+    for (const Benchmark& b : all) {
+        if (std::regex_search(b.name, pattern)) selected.push_back(&b);
+    }
+    if (list) {
+        for (const Benchmark* b : selected) std::printf("%s\n", b->name.c_str());
+        return 0;
+    }
+
+    if (format == "console") printConsoleHeader(workloads);
+    std::vector<Result> results;
+    for (const Benchmark* b : selected) {
+        results.push_back(run(*b, minTime));
+        if (format == "console") printConsoleRow(results.back());
+    }
+
+    if (format == "json") printJson(std::cout, workloads, results, scale);
+    if (format == "csv") printCsv(std::cout, results);
+    if (!outFile.empty()) {
+        std::ofstream out(outFile);
+        if (!out) {
+            std::fprintf(stderr, "Cannot open output file: %s\n", outFile.c_str());
+            return 1;
+        }
+        if (outFormat == "csv") printCsv(out, results);
+        else printJson(out, workloads, results, scale);
+    }
+    return 0;
+}
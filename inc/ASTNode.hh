@@ -3,10 +3,14 @@
 
 #include "./NodeType.hh"
 
+// 노드는 Program 의 AstArena 에 할당되고 소멸자가 불리지 않는다.
+// 그래서 가상 소멸자 없이도 파생 노드의 멤버가 새지 않는다.
+struct Type;
+
 struct ASTNode {
     NodeType type;
-    // virtual ~ASTNode() = default;
-    constexpr ASTNode(NodeType type) : type(type) {}
+    const Type* valueType;   // 식이면 의미 분석이 추론한 타입
+    constexpr ASTNode(NodeType type) : type(type), valueType(nullptr) {}
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,98 @@
+#ifndef AstArena_hh
+#define AstArena_hh
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+// ===== 노드 리스트 =====
+// 아레나에 연속으로 놓인 배열을 가리키는 (포인터, 길이) 쌍
+template<typename T>
+struct NodeList {
+    T* items = nullptr;
+    uint32_t count = 0;
+
+    inline T* begin() const { return items; }
+    inline T* end() const { return items + count; }
+    inline size_t size() const { return count; }
+    inline bool empty() const { return count == 0; }
+    inline T& operator[](size_t i) const { return items[i]; }
+};
+
+// ===== AST 아레나 =====
+// Program 하나의 모든 노드, 리스트, 문자열 리터럴을 담는 범프 할당기.
+// 청크 단위로만 malloc 하고, 노드의 소멸자는 부르지 않으므로
+// 노드 타입은 trivially destructible 이어야 한다.
+class AstArena {
+private:
+    static constexpr size_t ChunkSize = 256 * 1024;
+
+    std::vector<std::unique_ptr<std::byte[]>> chunks;
+    std::byte* cursor = nullptr;
+    size_t remaining = 0;
+    size_t nodes = 0;
+
+    // 문자열 리터럴 중복 제거용 (값은 아레나 안의 문자열을 가리킨다)
+    std::unordered_set<std::string_view> names;
+
+public:
+    AstArena() = default;
+    AstArena(const AstArena&) = delete;
+    AstArena& operator=(const AstArena&) = delete;
+
+    inline void* allocate(size_t size, size_t align) {
+        size_t pad = (align - reinterpret_cast<uintptr_t>(cursor) % align) % align;
+        if (size + pad > remaining) {
+            size_t chunk = size + align > ChunkSize ? size + align : ChunkSize;
+            chunks.emplace_back(new std::byte[chunk]);
+            cursor = chunks.back().get();
+            remaining = chunk;
+            pad = (align - reinterpret_cast<uintptr_t>(cursor) % align) % align;
+        }
+        void* p = cursor + pad;
+        cursor += pad + size;
+        remaining -= pad + size;
+        return p;
+    }
+
+    template<typename T, typename... Args>
+    inline T* make(Args&&... args) {
+        static_assert(std::is_trivially_destructible_v<T>, "arena nodes are never destroyed");
+        nodes++;
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    // scratch[mark..] 를 아레나로 옮기고 scratch 를 mark 까지 되돌린다
+    template<typename T>
+    inline NodeList<T> list(std::vector<T>& scratch, size_t mark) {
+        static_assert(std::is_trivially_copyable_v<T>, "arena lists are copied with memcpy");
+        NodeList<T> result;
+        result.count = static_cast<uint32_t>(scratch.size() - mark);
+        if (result.count) {
+            result.items = static_cast<T*>(allocate(sizeof(T) * result.count, alignof(T)));
+            std::memcpy(result.items, scratch.data() + mark, sizeof(T) * result.count);
+        }
+        scratch.resize(mark);
+        return result;
+    }
+
+    // 같은 철자는 같은 포인터를 돌려준다
+    inline std::string_view intern(std::string_view s) {
+        auto found = names.find(s);
+        if (found != names.end()) return *found;
+        char* p = static_cast<char*>(allocate(s.size(), 1));
+        if (!s.empty()) std::memcpy(p, s.data(), s.size());
+        return *names.emplace(p, s.size()).first;
+    }
+
+    inline size_t nodeCount() const { return nodes; }
+    inline size_t chunkCount() const { return chunks.size(); }
+};
+
+#endif
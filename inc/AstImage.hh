@@ -0,0 +1,130 @@
+#ifndef AstImage_hh
+#define AstImage_hh
+
+#include "./NodeType.hh"
+#include "./SourceBuffer.hh"
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+
+struct Program;
+
+#define ccfn
+
+// ===== AST 이미지 =====
+// 파싱한 Program 을 파일에 그대로 매핑해서 쓸 수 있게 만든 이진 형식 (.zast).
+// 포인터 대신 파일 앞에서부터의 바이트 위치를 쓰므로 어느 주소에 매핑해도 되고,
+// 읽을 때 노드를 만들지 않고 매핑된 바이트 위에서 바로 걷는다.
+//
+// 형식 (리틀 엔디언, 모든 항목은 4바이트 정렬)
+//   머리:  "ZAS\0" u32:version u32:nodes u32:root u32:strings u32:size
+//   레코드: u8:tag u8:aux u16:flags u32:field...
+//     tag 가 NodeType 이면 노드다. 필드 수와 뜻은 타입마다 정해져 있다 (AstImage.cc 의 표).
+//     tag 가 List 이면 field[0] 이 개수이고 뒤에 노드 위치가 그만큼 온다.
+//     tag 가 Params 이면 field[0] 이 개수이고 뒤에 (타입, 이름) 문자열 번호 쌍이 온다.
+//   문자열 표: u32:count { u32:offset u32:length } bytes
+// 자식은 언제나 부모보다 앞에 쓴다. 위치 0 은 '없음'이다 (머리가 있는 자리라 노드일 수 없다).
+// 여러 부모가 한 노드를 가리키면(x += e 를 푼 x = x + e) 레코드도 하나만 쓰고 flags 에 표시한다.
+// 열 때 레코드를 한 번 훑어서 모든 위치가 앞쪽 레코드의 시작을 가리키는지, 파서가 언제나
+// 채우는 자식이 있는지, 자식이 그 자리에 올 수 있는 종류(식, 문장, 블록)인지 확인하므로
+// 손상된 파일이라도 걷다가 범위를 벗어나거나 돌거나 빈 자식을 만나지 않는다.
+class AstImage {
+public:
+    static constexpr uint32_t Version = 1;
+    static constexpr uint8_t List = 0xFF;
+    static constexpr uint8_t Params = 0xFE;
+
+    class NodeRef;
+
+    // 노드 위치의 배열
+    class ListRef {
+        const AstImage* image = nullptr;
+        uint32_t offset = 0;
+
+    public:
+        inline ListRef() = default;
+        inline ListRef(const AstImage* i, uint32_t o) : image(i), offset(o) {}
+        inline uint32_t size() const { return offset ? image->word(offset + 4) : 0; }
+        inline NodeRef operator[](uint32_t i) const;
+    };
+
+    // 매핑된 레코드 하나. 필드 번호는 AstImage.cc 의 표를 따른다.
+    class NodeRef {
+        const AstImage* image = nullptr;
+        uint32_t offset = 0;
+
+    public:
+        inline NodeRef() = default;
+        inline NodeRef(const AstImage* i, uint32_t o) : image(i), offset(o) {}
+
+        inline explicit operator bool() const { return offset != 0; }
+        inline NodeType type() const { return static_cast<NodeType>(image->byte(offset)); }
+        // 연산자(TokenType) 또는 bool 값
+        inline uint8_t aux() const { return image->byte(offset + 1); }
+        inline uint8_t flags() const { return image->byte(offset + 2); }
+        inline uint32_t position() const { return offset; }
+        inline uint32_t field(uint32_t i) const { return image->word(offset + 4 + 4 * i); }
+        inline NodeRef child(uint32_t i) const { return NodeRef(image, field(i)); }
+        inline ListRef list(uint32_t i) const { return ListRef(image, field(i)); }
+        inline std::string_view string(uint32_t i) const { return image->string(field(i)); }
+        // Params 레코드의 j 번째 매개변수 (타입, 이름)
+        inline std::string_view paramType(uint32_t i, uint32_t j) const;
+        inline std::string_view paramName(uint32_t i, uint32_t j) const;
+        inline uint32_t paramCount(uint32_t i) const { return field(i) ? image->word(field(i) + 4) : 0; }
+    };
+
+private:
+    SourceBuffer buffer;
+    std::string_view data;
+    uint32_t nodes = 0;
+    uint32_t rootOffset = 0;
+    uint32_t stringTable = 0;
+    uint32_t stringCount = 0;
+
+    inline uint8_t byte(uint32_t offset) const { return static_cast<uint8_t>(data[offset]); }
+    inline uint32_t word(uint32_t offset) const {
+        uint32_t value;
+        std::memcpy(&value, data.data() + offset, sizeof value);
+        return value;
+    }
+
+    void ccfn verify();
+
+public:
+    // buffer 는 보통 SourceBuffer::map 으로 연 .zast 파일이다. 형식이 틀리면 던진다.
+    explicit AstImage(SourceBuffer source);
+    // NodeRef 가 이 객체를 가리키므로 옮기지 않는다
+    AstImage(const AstImage&) = delete;
+    AstImage& operator=(const AstImage&) = delete;
+
+    static std::string ccfn serialize(const Program* program);
+    static bool ccfn isImage(std::string_view data);
+
+    // PROGRAM 레코드. field(0) 이 최상위 문장 목록이다.
+    inline NodeRef root() const { return NodeRef(this, rootOffset); }
+    inline size_t nodeCount() const { return nodes; }
+    inline std::string_view string(uint32_t index) const {
+        uint32_t entry = stringTable + 4 + 8 * index;
+        return data.substr(word(entry), word(entry + 4));
+    }
+
+    // 나머지 단계(분석, 최적화, 생성)가 쓸 수 있도록 아레나 노드로 되살린다.
+    // 렉싱과 파싱은 하지 않는다.
+    std::unique_ptr<Program> ccfn materialize() const;
+};
+
+inline AstImage::NodeRef AstImage::ListRef::operator[](uint32_t i) const {
+    return NodeRef(image, image->word(offset + 8 + 4 * i));
+}
+
+inline std::string_view AstImage::NodeRef::paramType(uint32_t i, uint32_t j) const {
+    return image->string(image->word(field(i) + 8 + 8 * j));
+}
+
+inline std::string_view AstImage::NodeRef::paramName(uint32_t i, uint32_t j) const {
+    return image->string(image->word(field(i) + 12 + 8 * j));
+}
+
+#endif
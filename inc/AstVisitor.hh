@@ -0,0 +1,53 @@
+#ifndef AstVisitor_hh
+#define AstVisitor_hh
+
+#include "./ASTNode.hh"
+#include "./Nodes.hh"
+
+// Node<T> 정의가 있는 노드 종류. 새 노드를 Nodes.hh 에 넣으면 여기에도 넣는다.
+#define ZUST_AST_NODES(X) \
+    X(VARIABLE_DECLARATION) X(FUNCTION_DECLARATION) X(BLOCK_STATEMENT) \
+    X(IF_STATEMENT) X(WHILE_STATEMENT) X(RETURN_STATEMENT) X(EXPRESSION_STATEMENT) \
+    X(BINARY_EXPRESSION) X(UNARY_EXPRESSION) X(CALL_EXPRESSION) \
+    X(IDENTIFIER) X(INTEGER_LITERAL) X(FLOAT_LITERAL) X(STRING_LITERAL) X(BOOL_LITERAL) \
+    X(ASSIGNMENT_EXPRESSION) X(NAMESPACE_DECLARATION) X(IMPORT_STATEMENT) X(ERROR_STATEMENT)
+
+// ===== AST 방문자 =====
+// CRTP 로 노드 종류마다 Derived::visit(Node<T>*) 를 부른다. 가상 함수 없이 switch 하나로
+// 갈라지고, 각 visit 는 이미 구체 타입을 받으므로 static_cast 를 패스마다 쓰지 않는다.
+// Derived 는 다루는 노드만 visit 를 정의하고 `using AstVisitor::visit;` 로 나머지를 물려받는다.
+// 물려받은 visit 는 visitOther 로 간다.
+template<typename Derived, typename R = void>
+class AstVisitor {
+public:
+    inline R dispatch(ASTNode* node) {
+        switch (node->type) {
+#define ZUST_VISIT_CASE(type) \
+            case NodeType::type: return self().visit(static_cast<Node<NodeType::type>*>(node));
+            ZUST_AST_NODES(ZUST_VISIT_CASE)
+#undef ZUST_VISIT_CASE
+            default: return self().visitOther(node);
+        }
+    }
+
+    template<NodeType T>
+    inline R visit(Node<T>* node) { return self().visitOther(node); }
+    inline R visitOther(ASTNode*) { return R(); }
+
+private:
+    inline Derived& self() { return static_cast<Derived&>(*this); }
+};
+
+// ===== 패스 합치기 =====
+// 최상위 선언마다 passes 의 declaration(stmt) 을 차례로 부른다. 한 선언을 모든 패스가 보고
+// 나서 다음 선언으로 넘어가므로, 프로그램 전체를 패스마다 한 번씩 걷는 것과 달리 선언의
+// 노드가 캐시에 있는 동안 다음 패스가 그 노드를 쓴다. 앞 패스가 던지면 뒤 패스는 그 선언을
+// 보지 않는다. 프로그램 전체를 봐야 하는 패스(죽은 코드 제거)는 합칠 수 없다.
+template<typename Statements, typename... Passes>
+inline void runFused(const Statements& statements, Passes&... passes) {
+    for (ASTNode* stmt : statements) {
+        (passes.declaration(stmt), ...);
+    }
+}
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef AtomicFile_hh
+#define AtomicFile_hh
+
+#include <string>
+#include <string_view>
+
+// ===== 원자적 파일 쓰기 =====
+// 같은 디렉터리의 임시 파일에 다 쓴 뒤 rename 으로 옮긴다. 같은 파일을 여러 프로세스나
+// 스레드가 동시에 써도 읽는 쪽은 반쯤 쓰인 파일을 보지 않는다.
+namespace atomic_file {
+
+// path 를 data 로 바꾼다. 쓰거나 옮기지 못하면 임시 파일을 지우고 false 를 돌려준다.
+bool write(const std::string& path, std::string_view data);
+
+}
+
+#endif
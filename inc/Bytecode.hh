@@ -0,0 +1,111 @@
+#ifndef Bytecode_hh
+#define Bytecode_hh
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ===== 바이트코드 (Zust Machine) =====
+// 레지스터 기반 명령어. 피연산자 A, B, C 는 16비트이며,
+// 32비트 즉시값/오프셋이 필요한 명령은 B 와 C 를 합쳐서 쓴다 (bx / sbx).
+//
+//  LOAD_INT   A sbx      A = sbx
+//  LOAD_CONST A bx       A = K[bx]
+//  LOAD_GLOBAL A bx      A = G[bx]
+//  STORE_GLOBAL A bx     G[bx] = A
+//  MOVE       A B        A = B
+//  I2F        A B        A = (double)B
+//  <binop>    A B C      A = B op C       (_I: 정수, _F: 실수, _S: 문자열)
+//  <unop>     A B        A = op B
+//  JMP        sbx        pc += sbx
+//  JMP_FALSE  A sbx      if (!A) pc += sbx
+//  JMP_TRUE   A sbx      if (A) pc += sbx
+//  CALL       A B C      A = F[B](C, C+1, ...)
+//  RET        A          return A
+//  RET_VOID
+#define ZUST_OPCODES(X) \
+    X(LOAD_INT) X(LOAD_CONST) X(LOAD_GLOBAL) X(STORE_GLOBAL) X(MOVE) X(I2F) \
+    X(ADD_I) X(SUB_I) X(MUL_I) X(DIV_I) X(MOD_I) \
+    X(ADD_F) X(SUB_F) X(MUL_F) X(DIV_F) X(MOD_F) \
+    X(BAND) X(BOR) X(BXOR) X(SHL) X(SHR) \
+    X(EQ_I) X(NE_I) X(LT_I) X(LE_I) X(GT_I) X(GE_I) \
+    X(EQ_F) X(NE_F) X(LT_F) X(LE_F) X(GT_F) X(GE_F) \
+    X(EQ_S) X(NE_S) X(CONCAT) \
+    X(NEG_I) X(NEG_F) X(NOT) X(BNOT) \
+    X(JMP) X(JMP_FALSE) X(JMP_TRUE) \
+    X(CALL) X(RET) X(RET_VOID)
+
+enum class Opcode : uint8_t {
+#define ZUST_OPCODE_ENUM(name) name,
+    ZUST_OPCODES(ZUST_OPCODE_ENUM)
+#undef ZUST_OPCODE_ENUM
+    COUNT
+};
+
+const char* opcodeName(Opcode op);
+
+struct Instruction {
+    Opcode op;
+    uint8_t reserved = 0;
+    uint16_t a = 0;
+    uint16_t b = 0;
+    uint16_t c = 0;
+
+    inline uint32_t bx() const { return static_cast<uint32_t>(b) | (static_cast<uint32_t>(c) << 16); }
+    inline int32_t sbx() const { return static_cast<int32_t>(bx()); }
+
+    static inline Instruction make(Opcode op, uint16_t a = 0, uint16_t b = 0, uint16_t c = 0) {
+        Instruction i;
+        i.op = op; i.a = a; i.b = b; i.c = c;
+        return i;
+    }
+    static inline Instruction makeBx(Opcode op, uint16_t a, uint32_t bx) {
+        return make(op, a, static_cast<uint16_t>(bx & 0xffff), static_cast<uint16_t>(bx >> 16));
+    }
+};
+
+static_assert(sizeof(Instruction) == 8, "instructions are packed into 8 bytes");
+
+// 상수 풀 항목
+struct Constant {
+    enum Kind : uint8_t { INT, FLOAT, STRING };
+    Kind kind;
+    int64_t i = 0;
+    double f = 0;
+    std::string s;
+};
+
+// 함수 테이블 항목
+struct Function {
+    std::string name;
+    uint16_t numParams = 0;
+    uint16_t numRegisters = 0;
+    std::vector<Instruction> code;
+};
+
+// ===== 모듈 =====
+// 직렬화 형식 (리틀 엔디언):
+//   "ZBC\0" u32:version
+//   u32:constants { u8:kind, i64 | f64 | u32:len bytes }
+//   u32:globals
+//   u32:functions { u32:len name, u16:params, u16:registers, u32:count, Instruction[count] }
+//   u32:init  u32:entry   (없으면 NoFunction)
+struct Module {
+    static constexpr uint32_t Version = 1;
+    static constexpr uint32_t NoFunction = UINT32_MAX;
+
+    std::vector<Constant> constants;
+    uint32_t numGlobals = 0;
+    std::vector<Function> functions;
+    uint32_t initFunction = NoFunction;    // 최상위 문장 (전역 변수 초기화)
+    uint32_t entryFunction = NoFunction;   // main
+
+    std::string serialize() const;
+    // 범위(레지스터, 상수, 전역, 점프, 호출)는 검증하지만 레지스터 타입은 검증하지 않는다.
+    // 신뢰할 수 없는 곳에서 받은 모듈을 실행하면 안 된다.
+    static Module deserialize(std::string_view data);
+    std::string disassemble() const;
+};
+
+#endif
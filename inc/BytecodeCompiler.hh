@@ -0,0 +1,85 @@
+#ifndef BytecodeCompiler_hh
+#define BytecodeCompiler_hh
+
+#include "./Bytecode.hh"
+#include "./Interner.hh"
+#include "./NodeType.hh"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+struct ASTNode;
+struct Program;
+struct Type;
+template<NodeType> struct Node;
+
+#define ccfn
+
+// ===== 바이트코드 컴파일러 =====
+// 의미 분석이 끝난 AST(노드마다 valueType 이 채워져 있어야 한다)를
+// Zust Machine 용 레지스터 바이트코드로 내린다.
+// 함수 매개변수는 r0.. 에, 지역 변수는 그 뒤에 스코프 순서대로 놓이고
+// 임시 레지스터는 문장이 끝날 때마다 반납된다.
+class BytecodeCompiler {
+private:
+    struct Local {
+        Name name;
+        uint16_t reg;
+        const Type* type;
+    };
+
+    struct FunctionInfo {
+        uint32_t index;
+        Node<NodeType::FUNCTION_DECLARATION>* decl;
+        std::vector<const Type*> paramTypes;
+        const Type* returnType;
+    };
+
+    Module module;
+    std::unordered_map<Name, FunctionInfo> functions;
+    std::vector<Name> functionOrder;
+    std::unordered_map<Name, std::pair<uint32_t, const Type*>> globals;
+    std::unordered_map<int64_t, uint32_t> intConstants;
+    std::unordered_map<uint64_t, uint32_t> floatConstants;
+    std::unordered_map<std::string, uint32_t> stringConstants;
+
+    // 지금 컴파일 중인 함수
+    Function* fn = nullptr;
+    const Type* returnType = nullptr;
+    std::vector<Local> locals;
+    std::vector<size_t> scopes;
+    uint16_t nextRegister = 0;
+
+    void ccfn collect(ASTNode* node, bool topLevel);
+    void ccfn compileFunction(const FunctionInfo& info);
+    void ccfn compileInit(Program* program);
+    void ccfn compileTopLevel(ASTNode* node);
+
+    void ccfn compileStatement(ASTNode* node);
+    uint16_t ccfn compileExpression(ASTNode* node, int target = -1);
+    uint16_t ccfn compileBinary(Node<NodeType::BINARY_EXPRESSION>* binary, int target);
+    uint16_t ccfn compileCall(Node<NodeType::CALL_EXPRESSION>* call, int target);
+    // 값을 dst 로 옮기며 필요하면 int -> float 변환한다
+    void ccfn convertInto(uint16_t dst, uint16_t src, const Type* from, const Type* to);
+    uint16_t ccfn asFloat(uint16_t reg, const Type* type);
+
+    uint16_t ccfn allocRegister();
+    inline uint16_t destination(int target) {
+        return target >= 0 ? static_cast<uint16_t>(target) : allocRegister();
+    }
+    const Local* ccfn findLocal(Name name) const;
+    void ccfn pushScope();
+    void ccfn popScope();
+
+    size_t ccfn emit(Instruction ins);
+    void ccfn emitInt(uint16_t dst, int64_t value);
+    void ccfn patchJump(size_t at);
+    uint32_t ccfn constant(int64_t value);
+    uint32_t ccfn constant(double value);
+    uint32_t ccfn constant(const std::string& value);
+
+public:
+    Module ccfn compile(Program* program);
+};
+
+#endif
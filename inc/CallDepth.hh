@@ -0,0 +1,11 @@
+#ifndef CallDepth_hh
+#define CallDepth_hh
+
+#include <cstddef>
+
+// ===== 호출 깊이 한도 =====
+// 두 실행 엔진(Zust Machine, 클로저 평가기)이 같은 깊이에서 "Stack overflow" 를 내도록
+// 한 곳에 둔다. main 도 한 프레임으로 센다.
+inline constexpr size_t MaxCallDepth = 1 << 16;
+
+#endif
@@ -1,28 +1,73 @@
 #ifndef CodeGenerator_hh
 #define CodeGenerator_hh
 
-#include <sstream>
-class ASTNode;
+#include <string>
+#include "./AstVisitor.hh"
+#include "./Interner.hh"
+#include "./OutputBuffer.hh"
 class Program;
+namespace ir { class Module; }
 
 #define ccfn
 
 // ===== 코드 생성기 =====
-class CodeGenerator {
+// 노드 종류마다 visit 하나가 C++ 코드를 쓴다. 최상위 선언 하나씩 쓸 수 있으므로
+// (declaration) 분석기와 함께 runFused 로 돌리면 선언마다 분석한 직후에 생성한다.
+class CodeGenerator : public AstVisitor<CodeGenerator> {
 private:
-    std::ostringstream output;
+    friend class AstVisitor<CodeGenerator>;
+
+    OutputBuffer buffer;
+    OutputBuffer& output;     // buffer 이거나 호출자가 준 싱크
     int indentLevel = 0;
+    const ir::Module* lowered = nullptr;     // 본문을 IR 에서 쓸 함수 (-O2)
     
     inline void indent() {
-        for (int i = 0; i < indentLevel; ++i) {
-            output << "    ";
-        }
+        output.indent(indentLevel);
     }
+
+    using AstVisitor::visit;
+    void ccfn visit(Node<NodeType::INTEGER_LITERAL>* lit);
+    void ccfn visit(Node<NodeType::FLOAT_LITERAL>* lit);
+    void ccfn visit(Node<NodeType::STRING_LITERAL>* lit);
+    void ccfn visit(Node<NodeType::BOOL_LITERAL>* lit);
+    void ccfn visit(Node<NodeType::IDENTIFIER>* id);
+    void ccfn visit(Node<NodeType::BINARY_EXPRESSION>* binary);
+    void ccfn visit(Node<NodeType::UNARY_EXPRESSION>* unary);
+    void ccfn visit(Node<NodeType::ASSIGNMENT_EXPRESSION>* assignment);
+    void ccfn visit(Node<NodeType::CALL_EXPRESSION>* call);
+    void ccfn visit(Node<NodeType::VARIABLE_DECLARATION>* var);
+    void ccfn visit(Node<NodeType::FUNCTION_DECLARATION>* func);
+    void ccfn visit(Node<NodeType::BLOCK_STATEMENT>* block);
+    void ccfn visit(Node<NodeType::IF_STATEMENT>* ifStmt);
+    void ccfn visit(Node<NodeType::WHILE_STATEMENT>* whileStmt);
+    void ccfn visit(Node<NodeType::RETURN_STATEMENT>* returnStmt);
+    void ccfn visit(Node<NodeType::EXPRESSION_STATEMENT>* exprStmt);
+    void ccfn visit(Node<NodeType::NAMESPACE_DECLARATION>* ns);
+    void ccfn visit(Node<NodeType::IMPORT_STATEMENT>* importStmt);
+
 public:
-    void ccfn generateExpression(ASTNode* node);
-    void ccfn generateStatement(ASTNode* node);
-    std::string ccfn mapToCppType(const std::string& type) const;
+    inline CodeGenerator() : output(buffer) {}
+    // 호출자의 버퍼(예: 파일 디스크립터 싱크)에 바로 쓴다
+    inline explicit CodeGenerator(OutputBuffer& sink) : output(sink) {}
+
+    inline void generateExpression(ASTNode* node) {
+        if (node) dispatch(node);
+    }
+    inline void generateStatement(ASTNode* node) {
+        if (node) dispatch(node);
+    }
+    // 여기 있는 함수는 AST 대신 IR 로 본문을 쓴다. module 은 생성이 끝날 때까지 살아 있어야 한다.
+    inline void setLowered(const ir::Module* module) { lowered = module; }
+    std::string ccfn mapToCppType(Name type) const;
+    // 파일 머리 (#include 들)
+    void ccfn prologue();
+    // 최상위 문장 하나를 쓴다 (runFused 의 패스)
+    inline void declaration(ASTNode* stmt) { generateStatement(stmt); }
+    // 프로그램 전체를 output 에 쓴다
+    void ccfn emit(Program* program);
     std::string ccfn generate(Program* program);
+    inline std::string str() const { return output.str(); }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,41 @@
+#ifndef CompileCache_hh
+#define CompileCache_hh
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+struct CompilerOptions;
+
+#define ccfn
+
+// ===== 컴파일 캐시 =====
+// 내용 주소 방식의 디스크 캐시. 키는 소스, 컴파일러 버전, 산출물 종류,
+// 출력에 영향을 주는 옵션의 SHA-256 이고 값은 만들어진 산출물 그대로다.
+// 항목은 임시 파일에 쓴 뒤 rename 으로 옮기므로 여러 zust 프로세스가
+// 같은 디렉터리를 함께 써도 반쯤 쓰인 파일을 읽는 일이 없다.
+class CompileCache {
+private:
+    std::string directory;
+    std::atomic<uint64_t> hitCount{0};
+    std::atomic<uint64_t> missCount{0};
+
+    std::string ccfn pathFor(const std::string& key) const;
+
+public:
+    explicit CompileCache(std::string directory);
+
+    static std::string ccfn key(std::string_view source, std::string_view artifact, const CompilerOptions& options);
+
+    // 있으면 out 에 채우고 true. 적중/실패 횟수를 센다.
+    bool ccfn lookup(const std::string& key, std::string& out);
+    // 캐시는 최선 노력이다: 쓰기에 실패해도 컴파일은 성공한 것으로 본다
+    void ccfn store(const std::string& key, std::string_view data);
+
+    inline uint64_t hits() const { return hitCount.load(); }
+    inline uint64_t misses() const { return missCount.load(); }
+    inline const std::string& path() const { return directory; }
+};
+
+#endif
@@ -2,7 +2,14 @@
 #define Compiler_hh
 
 #include <exception>
+#include <memory>
 #include <string>
+#include <vector>
+#include "./Bytecode.hh"
+#include "./SourceBuffer.hh"
+
+struct Program;
+namespace ir { class Module; }
 
 // ===== 에러 처리 =====
 class CompilerError : public std::exception {
@@ -14,13 +21,12 @@ private:
     std::string message;
     int line;
     int column;
+    // what() 이 여러 스레드에서 동시에 불려도 되도록 생성할 때 한 번 만들어 둔다
+    std::string fullMessage;
     
 public:
     inline CompilerError(Type type, const std::string& msg, int l = 0, int c = 0)
-        : errorType(type), message(msg), line(l), column(c) {}
-    
-    const char* what() const noexcept override {
-        static std::string fullMessage;
+        : errorType(type), message(msg), line(l), column(c) {
         fullMessage = getTypeString() + " Error";
         if (line > 0) {
             fullMessage += " at line " + std::to_string(line);
@@ -29,6 +35,9 @@ public:
             }
         }
         fullMessage += ": " + message;
+    }
+    
+    const char* what() const noexcept override {
         return fullMessage.c_str();
     }
     
@@ -45,12 +54,66 @@ public:
 
 
 
+class CompileCache;
+
+// ===== 컴파일 옵션 =====
+struct CompilerOptions {
+    // 없으면 캐시를 쓰지 않는다. 여러 Compiler 가 함께 쓸 수 있다.
+    std::shared_ptr<CompileCache> cache;
+
+    // 0 이면 AST 를 그대로 내보낸다. 1 이면 상수 접기와 대수 단순화,
+    // 죽은 코드 제거를 한다. 2 면 거기에 더해 함수 본문을 SSA IR 로 내려서
+    // 조건부 상수 전파, 복사 전파, 값 번호 매기기, 죽은 코드 제거를 하고 IR 에서 C++ 을 쓴다.
+    int optimizationLevel = 1;
+    // main 에서 닿지 않아도 남길 함수 이름
+    std::vector<std::string> exports;
+    // import 할 모듈을 찾을 디렉터리 (가져오는 파일의 디렉터리 다음에 본다)
+    std::vector<std::string> modulePaths;
+
+    // 생성 결과에 영향을 주는 옵션을 한 문자열로 만든다. 캐시 키에 들어가므로
+    // 출력을 바꾸는 옵션을 추가하면 여기에도 넣어야 한다.
+    std::string fingerprint() const;
+};
+
 #define ccfn
 
 // ===== 메인 컴파일러 클래스 =====
 class Compiler {
+private:
+    CompilerOptions options;
+
+    // 파싱하고 import 를 푼 AST (분석 전)
+    std::unique_ptr<Program> ccfn load(SourceBuffer source, const std::string& origin);
+    // 분석과 C++ 생성을 최상위 선언마다 함께 돌린다 (-O0)
+    std::string ccfn analyzeAndGenerate(SourceBuffer source, const std::string& origin);
+    // 분석한 AST 의 함수 본문을 IR 로 내린다. optimize 면 IR 패스를 돌린다.
+    ir::Module ccfn lowerToIr(Program* ast, bool optimize);
+
 public:
+    // 생성 결과가 바뀌는 변경을 하면 올려서 예전 캐시 항목을 무효로 만든다
+    static constexpr const char* Version = "0.3.1";
+
+    inline Compiler() = default;
+    inline explicit Compiler(CompilerOptions opts) : options(std::move(opts)) {}
+
+    // 렉싱과 파싱만 한 AST. 문법 오류가 있으면 모두 모아 던진다.
+    // source 가 AST 이미지(.zast)면 파싱하지 않고 이미지에서 되살린다.
+    static std::unique_ptr<Program> ccfn parse(SourceBuffer source);
+    // 렉싱, 파싱, 의미 분석까지 마친 AST. origin 은 import 를 찾을 때 기준이 되는 소스 경로다.
+    std::unique_ptr<Program> ccfn analyze(SourceBuffer source, const std::string& origin = "");
+
     std::string ccfn compile(const std::string& sourceCode);
+    std::string ccfn compile(SourceBuffer source, const std::string& origin = "");
     void ccfn compileFile(const std::string& inputFile, const std::string& outputFile);
+
+    // Zust Machine 바이트코드 백엔드
+    // 함수 본문을 내린 SSA IR (--dump-ir). -O0 이 아니면 IR 패스를 돌린 뒤의 모습이다.
+    std::string ccfn dumpIr(SourceBuffer source, const std::string& origin = "");
+
+    Module ccfn compileToBytecode(SourceBuffer source, const std::string& origin = "");
+    void ccfn compileFileToBytecode(const std::string& inputFile, const std::string& outputFile);
+
+    // 파싱한 AST 를 매핑해서 쓸 수 있는 이미지로 저장한다. 이미지는 소스 대신 어느 모드에나 넣을 수 있다.
+    void ccfn compileFileToAst(const std::string& inputFile, const std::string& outputFile);
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef DeadCodeEliminator_hh
+#define DeadCodeEliminator_hh
+
+#include "./AstArena.hh"
+#include "./Interner.hh"
+#include "./NodeType.hh"
+#include <cstddef>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class Program;
+class ASTNode;
+template<NodeType> struct Node;
+
+#define ccfn
+
+// ===== 죽은 코드 제거 =====
+// main 과 내보낸 이름에서 시작해서 호출 그래프를 따라가며 닿는 함수만 남긴다.
+// 그 밖에 읽히지 않는 let (초기값에 부작용이 없을 때), return 뒤의 문장,
+// 조건이 상수인 if / while 의 죽은 가지를 지운다. Optimizer 다음에 돌리면
+// 접힌 조건까지 정리된다.
+//
+// 이름은 스코프를 따지지 않고 철자로만 맞춘다. 같은 이름이 하나라도 쓰이면
+// 남기므로 지나치게 지우는 일은 없다.
+class DeadCodeEliminator {
+private:
+    using FunctionDeclaration = Node<NodeType::FUNCTION_DECLARATION>;
+
+    std::vector<Name> exports;
+    AstArena* arena = nullptr;
+    std::unordered_map<Name, std::vector<FunctionDeclaration*>> functions;   // 중첩 함수 포함
+    std::unordered_set<Name> referenced;        // 살아 있는 코드에서 쓰인 이름
+    std::unordered_set<Name> liveFunctions;
+    std::vector<FunctionDeclaration*> worklist;
+    size_t removed = 0;
+
+    void ccfn collectFunctions(ASTNode* node);
+    void ccfn reach(Name function);
+    void ccfn markStatement(ASTNode* node);
+    void ccfn markExpression(ASTNode* node);
+    void ccfn markReachable(Program* program);
+
+    // 남길 문장이면 (바뀌었을 수도 있는) 문장을, 지울 문장이면 nullptr 를 돌려준다
+    ASTNode* ccfn trimStatement(ASTNode* node);
+    ASTNode* ccfn sweepStatement(ASTNode* node);
+    // if / while 의 본문 자리. 지워졌으면 빈 블록을 넣는다.
+    ASTNode* ccfn branch(ASTNode* node);
+
+public:
+    // exports 에 있는 함수는 main 에서 닿지 않아도 남긴다
+    inline explicit DeadCodeEliminator(std::vector<Name> exported = {}) : exports(std::move(exported)) {}
+
+    void ccfn eliminate(Program* program);
+    // 지운 문장(함수 선언 포함)의 수
+    inline size_t removedStatements() const { return removed; }
+};
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef Document_hh
+#define Document_hh
+
+#include "./Lexer.hh"
+#include "./Parser.hh"
+#include "./Program.hh"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define ccfn
+
+// ===== 문서 (편집기용) =====
+// 편집기가 열어 둔 소스 하나를 계속 들고 있으면서 편집을 받아 토큰과 AST 를 고친다.
+// 문서는 선언 단위의 조각(Segment)으로 나뉘고, 조각마다 자기 텍스트와 토큰, AST,
+// 진단을 갖는다. 편집이 들어오면 편집에 걸친 조각과 그 바로 앞 조각만 다시 렉싱해서
+// 경계를 다시 찾고, 텍스트가 바뀐 조각만 다시 파싱한다. 나머지 조각의 토큰과 노드는
+// 그대로 쓴다.
+//
+// 조각 경계는 괄호 깊이 0 의 ';' 뒤, 또는 깊이 0 으로 돌아오는 '}' 뒤다. 다음 토큰이
+// else 이면 경계로 보지 않는다. 최상위 namespace 는 머리("namespace X {"), 멤버들,
+// 닫는 '}' 를 따로 조각으로 두므로 파일 전체를 감싼 namespace 안을 고쳐도 멤버 하나만
+// 다시 파싱한다. 조각 사이의 공백과 주석은 뒤 조각에 들어간다.
+// 조각 안의 토큰, 노드, 진단 위치는 조각 시작을 1행 1열로 본 값이다.
+class Document {
+public:
+    enum class SegmentKind : uint8_t { STATEMENTS, NAMESPACE_OPEN, NAMESPACE_CLOSE };
+
+    struct Segment {
+        SegmentKind kind = SegmentKind::STATEMENTS;
+        bool nested = false;                    // 최상위 namespace 본문 안에 있다
+        std::unique_ptr<Lexer> lexer;           // 조각 텍스트와 풀린 문자열 리터럴을 소유한다
+        TokenBuffer tokens;                     // 마지막은 EOF_TOKEN
+        std::unique_ptr<Program> program;       // STATEMENTS 조각만 파싱한다
+        std::vector<Diagnostic> diagnostics;
+        TokenType lead = TokenType::EOF_TOKEN;  // 공백/주석이 아닌 첫 토큰
+        size_t offset = 0;                      // 문서 안에서의 시작 위치
+        int line = 1;
+        int column = 1;
+        int newlines = 0;                       // 텍스트 안의 개행 수
+        int tail = 0;                           // 마지막 개행 뒤의 글자 수
+
+        inline std::string_view text() const { return lexer->text(); }
+    };
+
+    // 조각을 나눌 때 찾은 경계 하나
+    struct Boundary {
+        size_t end;
+        SegmentKind kind;
+        bool nested;
+    };
+
+private:
+    std::vector<Segment> segments;      // 항상 하나 이상
+    size_t length = 0;
+    size_t reparsed = 0;
+    // 조각들의 문장을 이어 붙인 프로그램. 편집하면 버리고 program() 에서 다시 만든다.
+    std::unique_ptr<Program> assembled;
+
+    Segment ccfn makeSegment(std::string text, const Boundary& boundary);
+    // offset 을 담은 조각. 문서 끝이면 마지막 조각
+    size_t ccfn segmentAt(size_t offset) const;
+    // first 부터 끝까지 조각의 문서 위치를 다시 계산한다
+    void ccfn relocate(size_t first);
+
+public:
+    explicit Document(std::string text = "");
+
+    // [offset, offset + removed) 를 inserted 로 바꾼다
+    void ccfn edit(size_t offset, size_t removed, std::string_view inserted);
+    // 줄/열(1 부터, 끝은 포함하지 않음) 범위를 바꾼다
+    void ccfn edit(int startLine, int startColumn, int endLine, int endColumn, std::string_view inserted);
+
+    size_t ccfn offsetOf(int line, int column) const;
+    std::string ccfn text() const;
+    // 조각 기준 위치를 문서 기준으로 바꾼 모든 문법 오류
+    std::vector<Diagnostic> ccfn diagnostics() const;
+    // 문서 전체를 한 번에 파싱한 것과 같은 모양의 프로그램. 노드는 조각들이 소유하므로
+    // 다음 편집까지만 유효하다. 오류가 난 문장은 ERROR_STATEMENT 로 들어 있다.
+    Program* ccfn program();
+
+    inline size_t size() const { return length; }
+    inline size_t segmentCount() const { return segments.size(); }
+    inline const Segment& segment(size_t i) const { return segments[i]; }
+    // 마지막 편집(또는 처음 열 때)에서 새로 만든 조각 수
+    inline size_t lastReparsed() const { return reparsed; }
+};
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef Driver_hh
+#define Driver_hh
+
+#include "./Compiler.hh"
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// 입력 파일 하나와 그 출력 경로
+struct CompileJob {
+    std::string input;
+    std::string output;
+};
+
+struct DriverOptions {
+    std::vector<std::string> inputs;   // 파일, 디렉터리, @목록파일
+    std::string outputDir;             // 비어 있으면 입력 옆에 .cpp 를 만든다
+    size_t threads = 0;                // 0 이면 하드웨어 스레드 수
+};
+
+#define ccfn
+
+// ===== 다중 파일 드라이버 =====
+// 여러 입력을 작업 훔치기 풀에서 동시에 컴파일한다. 파일마다 독립된
+// Compiler(렉서/파서/분석기/생성기)를 쓰고, 한 파일이 실패해도 나머지는 계속한다.
+class Driver {
+private:
+    CompilerOptions compilerOptions;
+
+public:
+    inline Driver() = default;
+    inline explicit Driver(CompilerOptions options) : compilerOptions(std::move(options)) {}
+
+    // zust [-j N] [-o dir] inputs...
+    static DriverOptions ccfn parseArguments(int argc, char* argv[]);
+    // 디렉터리는 *.zs 를 재귀로 찾고, @path 는 한 줄에 하나씩 경로가 적힌 목록이다
+    static std::vector<CompileJob> ccfn collect(const DriverOptions& options);
+    // 배치 모드로 처리해야 하는 입력인가 (디렉터리나 목록 파일)
+    static bool ccfn isBatchInput(const std::string& path);
+    // 컴파일러 입력 파일(.zs 소스, .zast 이미지)인가. 출력 자리에 오면 덮어쓰지 않고 입력으로 본다.
+    static bool ccfn isSourceFile(const std::string& path);
+
+    // 실패한 파일 수를 돌려준다. 오류는 입력 순서대로 err 에 쓴다.
+    size_t ccfn run(const std::vector<CompileJob>& jobs, size_t threads, std::ostream& err);
+};
+
+#endif
@@ -0,0 +1,176 @@
+#ifndef Evaluator_hh
+#define Evaluator_hh
+
+#include "./CallDepth.hh"
+#include "./Interner.hh"
+#include "./NodeType.hh"
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct ASTNode;
+struct Program;
+struct Type;
+template<NodeType> struct Node;
+
+// ===== 클로저 평가기 =====
+// 검사가 끝난 AST 를 노드마다 한 번씩 C++ 클로저로 바꿔 두고, 실행할 때는
+// 클로저만 호출한다. 값은 의미 분석이 정한 타입대로 박싱 없이 다룬다:
+// 정수/bool 은 int64_t, 실수는 double, 문자열은 std::string.
+namespace eval {
+
+union Slot {
+    int64_t i;
+    double f;
+};
+
+// 함수 호출 하나의 지역 변수. 숫자는 slots, 문자열은 strings 에 있다.
+struct Frame {
+    Slot* slots;
+    std::string* strings;
+    Slot result;
+    std::string resultString;
+};
+
+enum class Flow : uint8_t { NEXT, RETURN };
+
+enum class Kind : uint8_t { VOID, INT, FLOAT, STRING };
+
+using IntCode = std::function<int64_t(Frame&)>;
+using FloatCode = std::function<double(Frame&)>;
+using StringCode = std::function<std::string(Frame&)>;
+using StmtCode = std::function<Flow(Frame&)>;
+
+// 식 하나를 컴파일한 결과. kind 에 맞는 클로저 하나만 채워진다.
+struct Code {
+    Kind kind = Kind::VOID;
+    IntCode i;
+    FloatCode f;
+    StringCode s;
+    StmtCode v;    // VOID 식 (반환값 없는 호출)
+};
+
+struct Function {
+    std::string name;
+    Kind returnKind = Kind::VOID;
+    std::vector<Kind> paramKinds;
+    std::vector<uint32_t> paramIndex;   // 매개변수가 놓이는 slots / strings 위치
+    uint32_t numSlots = 0;
+    uint32_t numStrings = 0;
+    StmtCode body;
+};
+
+}
+
+#define ccfn
+
+class Evaluator {
+private:
+    struct Local {
+        Name name;
+        eval::Kind kind;
+        uint32_t index;
+    };
+
+    struct Global {
+        eval::Kind kind;
+        uint32_t index;
+    };
+
+    struct Scope {
+        size_t locals;
+        uint32_t slots;
+        uint32_t strings;
+    };
+
+    static constexpr int MaxDepth = static_cast<int>(MaxCallDepth);   // ZustMachine 과 같다
+    // 슬롯 스택은 조각으로 늘어난다. 프레임이 슬롯 포인터를 잡고 있으므로 옮기지 않는다.
+    static constexpr size_t SegmentSlots = 1 << 14;
+    // 클로저 호출은 네이티브 스택을 쓴다. 이 깊이를 넘는 호출은 큰 스택의 작업 스레드로 넘겨서
+    // MaxDepth 까지 견딘다. 얕은 프로그램은 스레드를 만들지 않는다.
+    static constexpr int HandoffDepth = 256;
+    static constexpr size_t DeepStackBytes = size_t{256} << 20;
+
+    struct Segment {
+        std::unique_ptr<eval::Slot[]> slots;
+        size_t size;
+    };
+    class DeepStack;
+
+    bool countNodes;
+    uint64_t nodes = 0;
+
+    std::deque<eval::Function> functions;     // 클로저가 포인터를 잡고 있으므로 deque
+    std::unordered_map<Name, eval::Function*> functionByName;
+    std::vector<Node<NodeType::FUNCTION_DECLARATION>*> declarations;
+    std::unordered_map<Name, Global> globalByName;
+    std::vector<eval::Slot> globals;
+    std::vector<std::string> globalStrings;
+    eval::Function init;
+
+    // 실행 스택
+    std::vector<Segment> segments;
+    size_t segment = 0;                 // top 이 있는 조각
+    eval::Slot* top = nullptr;
+    eval::Slot* limit = nullptr;        // 지금 조각의 끝
+    int depth = 0;
+    std::unique_ptr<DeepStack> deepStack;   // 처음 깊어질 때 만들고 다시 쓴다
+    bool deep = false;                  // 지금 deepStack 위에서 돌고 있다
+
+    // 컴파일 중인 함수
+    eval::Function* current = nullptr;
+    std::vector<Local> locals;
+    std::vector<Scope> scopes;
+    uint32_t nextSlot = 0;
+    uint32_t nextString = 0;
+
+    void ccfn collect(ASTNode* node, bool topLevel);
+    void ccfn compileFunction(Node<NodeType::FUNCTION_DECLARATION>* func);
+    void ccfn compileTopLevel(ASTNode* node, std::vector<eval::StmtCode>& out);
+
+    eval::StmtCode ccfn compileStatement(ASTNode* node);
+    eval::Code ccfn compileExpression(ASTNode* node);
+    eval::Code ccfn compileBinary(Node<NodeType::BINARY_EXPRESSION>* binary);
+    eval::Code ccfn compileCall(Node<NodeType::CALL_EXPRESSION>* call);
+    eval::Code ccfn compileAssignment(Node<NodeType::ASSIGNMENT_EXPRESSION>* assignment);
+    eval::IntCode ccfn asInt(ASTNode* node);
+    eval::FloatCode ccfn asFloat(ASTNode* node);
+    eval::StringCode ccfn asString(ASTNode* node);
+    // 선언된 kind 로 값을 저장하는 문장
+    eval::StmtCode ccfn store(eval::Kind kind, bool global, uint32_t index, ASTNode* value);
+
+    eval::Code ccfn counted(eval::Code code, uint32_t weight = 1);
+    eval::StmtCode ccfn counted(eval::StmtCode code);
+
+    uint32_t ccfn declareLocal(Name name, eval::Kind kind);
+    const Local* ccfn findLocal(Name name) const;
+    void ccfn pushScope();
+    void ccfn popScope();
+
+    // 인자를 평가해서 callee 프레임에 넣고 본문을 실행한다. 반환값은 callee.result 에 남는다.
+    void ccfn enter(const eval::Function* fn, const std::vector<eval::Code>& args,
+                    eval::Frame& caller, eval::Frame& callee);
+    // 슬롯 count 개를 잡는다. 지금 조각에 자리가 없으면 다음 조각으로 넘어간다.
+    eval::Slot* ccfn allocate(uint32_t count);
+
+public:
+    // countNodes 가 켜져 있으면 실행한 노드 수를 센다 (벤치마크용, 느려진다)
+    explicit Evaluator(bool countNodes = false);
+    // 클로저가 this 를 잡고 있으므로 옮길 수 없다
+    Evaluator(const Evaluator&) = delete;
+    Evaluator& operator=(const Evaluator&) = delete;
+    ~Evaluator();
+
+    // 프로그램을 클로저로 컴파일한다. 컴파일이 끝나면 AST 는 필요 없다.
+    void ccfn load(Program* program);
+    // 최상위 문장을 실행한 뒤 main 을 호출해서 그 반환값을 돌려준다
+    int64_t ccfn run();
+
+    inline uint64_t nodesEvaluated() const { return nodes; }
+};
+
+#endif
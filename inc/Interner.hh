@@ -0,0 +1,105 @@
+#ifndef Interner_hh
+#define Interner_hh
+
+#include "./StringArena.hh"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+
+// ===== 이름 (인턴된 문자열 ID) =====
+// 식별자, 타입 이름, 심볼 이름은 모두 전역 Interner 의 조밀한 정수 ID 로 다룬다.
+// 비교와 해시는 정수 연산이고, 같은 철자는 메모리에 한 번만 존재한다.
+struct Name {
+    uint32_t id = 0;   // 0 은 빈 이름
+
+    constexpr Name() = default;
+    explicit constexpr Name(uint32_t i) : id(i) {}
+
+    std::string_view str() const;
+    constexpr bool empty() const { return id == 0; }
+
+    constexpr bool operator==(Name o) const { return id == o.id; }
+    constexpr bool operator!=(Name o) const { return id != o.id; }
+    constexpr bool operator<(Name o) const { return id < o.id; }
+};
+
+namespace std {
+template<>
+struct hash<Name> {
+    inline size_t operator()(Name n) const noexcept {
+        return static_cast<size_t>(n.id) * 0x9E3779B97F4A7C15ull;
+    }
+};
+}
+
+// 미리 등록되는 이름. Interner 가 wellKnown 순서대로 ID 를 매긴다.
+namespace names {
+
+inline constexpr std::string_view wellKnown[] = {
+    "", "auto", "void", "bool", "char", "short", "int", "long",
+    "float", "double", "byte", "string", "main",
+};
+
+inline constexpr Name Empty{0};
+inline constexpr Name Auto{1};
+inline constexpr Name Void{2};
+inline constexpr Name Bool{3};
+inline constexpr Name Char{4};
+inline constexpr Name Short{5};
+inline constexpr Name Int{6};
+inline constexpr Name Long{7};
+inline constexpr Name Float{8};
+inline constexpr Name Double{9};
+inline constexpr Name Byte{10};
+inline constexpr Name String{11};
+inline constexpr Name Main{12};
+
+static_assert(sizeof(wellKnown) / sizeof(wellKnown[0]) == Main.id + 1, "wellKnown and the Name constants must match");
+
+}
+
+// ===== 전역 인터너 =====
+// intern 은 스레드 안전하다. 한 번 발급된 ID 의 철자는 바뀌지 않고 주소도 고정이므로
+// spelling 은 잠금 없이 읽는다 (ID 를 얻는 과정에서 이미 동기화가 이루어진다).
+class Interner {
+private:
+    static constexpr uint32_t BlockBits = 12;
+    static constexpr uint32_t BlockSize = 1u << BlockBits;
+    static constexpr uint32_t MaxBlocks = 4096;
+
+    mutable std::shared_mutex mutex;
+    std::unordered_map<std::string_view, uint32_t> ids;
+    StringArena storage;
+    std::unique_ptr<std::string_view[]> blocks[MaxBlocks];
+    uint32_t count = 0;
+
+    Interner();
+    uint32_t insert(std::string_view s);
+
+public:
+    Interner(const Interner&) = delete;
+    Interner& operator=(const Interner&) = delete;
+
+    static Interner& global();
+
+    Name intern(std::string_view s);
+
+    inline std::string_view spelling(Name n) const {
+        return blocks[n.id >> BlockBits][n.id & (BlockSize - 1)];
+    }
+
+    size_t size() const;
+};
+
+inline std::string_view Name::str() const {
+    return Interner::global().spelling(*this);
+}
+
+inline Name intern(std::string_view s) {
+    return Interner::global().intern(s);
+}
+
+#endif
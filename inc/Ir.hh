@@ -0,0 +1,163 @@
+#ifndef Ir_hh
+#define Ir_hh
+
+#include "./Interner.hh"
+#include "./NodeType.hh"
+#include "./TokenType.hh"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct Type;
+template<NodeType> struct Node;
+
+#define ccfn
+
+// ===== SSA 중간 표현 =====
+// 함수 본문을 기본 블록과 SSA 값으로 내린 것. IrBuilder 가 AST 에서 만들고 IrPasses 가 다듬고
+// IrEmitter 가 C++ 로 쓴다.
+//
+// 명령 하나가 값 하나를 정의하고 값의 번호는 명령의 번호(Function::values 의 위치)다.
+// 값의 타입은 분석기의 타입이 아니라 생성된 C++ 에서의 타입이다 (1.5 는 double,
+// float + double 은 double). 그래서 값마다 그 타입의 임시 변수에 담아도 AST 를 그대로
+// 쓴 C++ 과 계산 결과가 같다.
+//
+// 값을 다른 값으로 바꿀 때는 쓰는 쪽을 찾아 고치지 않고 forward 에 적어 둔다.
+// 피연산자는 resolve 를 거쳐 읽고, 패스가 끝날 때 canonicalize 로 한 번에 정리한다.
+namespace ir {
+
+using Value = uint32_t;
+using BlockId = uint32_t;
+inline constexpr uint32_t None = UINT32_MAX;
+
+enum class Op : uint8_t {
+    Const,      // 리터럴. integer(정수, bool) / real / text
+    Undef,      // 초기값 없는 지역 변수
+    Param,      // integer 번째 매개변수
+    Phi,        // 블록의 선행 블록마다 피연산자 하나 (preds 와 같은 순서)
+    Copy,
+    Cast,       // 피연산자를 type 으로 바꾼다
+    Binary,     // operator_
+    Unary,
+    Load,       // 전역 변수 name 을 읽는다
+    Store,      // 전역 변수 name 에 operands[0] 을 쓴다
+    Call,       // name(operands...). 반환 타입이 void 면 값이 없다
+    Jump,       // targets[0] 으로
+    Branch,     // operands[0] 이 참이면 targets[0], 아니면 targets[1]
+    Return,     // 피연산자가 없으면 값 없이 돌아간다
+};
+
+struct Instruction {
+    Op op;
+    TokenType operator_ = TokenType::EOF_TOKEN;
+    bool dead = false;
+    BlockId block = 0;
+    const Type* type = nullptr;     // 값의 C++ 타입. 값이 없는 명령은 nullptr
+    Name name;
+    int64_t integer = 0;
+    double real = 0;
+    std::string_view text;          // 프로그램 아레나의 문자열
+    std::vector<Value> operands;
+    BlockId targets[2] = {None, None};
+
+    inline explicit Instruction(Op o, const Type* t = nullptr) : op(o), type(t) {}
+};
+
+struct Block {
+    std::vector<Value> phis;
+    std::vector<Value> code;            // 마지막이 Jump / Branch / Return
+    std::vector<BlockId> preds;
+    std::vector<BlockId> succs;
+    bool closed = false;                // 종결 명령이 붙었다
+    bool dead = false;
+};
+
+// 부작용이 있어서 쓰이지 않아도 지울 수 없는 명령
+inline bool hasSideEffects(Op op) {
+    return op == Op::Store || op == Op::Call || op == Op::Jump || op == Op::Branch || op == Op::Return;
+}
+
+// 입력만으로 값이 정해지는 명령 (같은 입력이면 같은 값)
+inline bool isPure(Op op) {
+    return op == Op::Const || op == Op::Copy || op == Op::Cast || op == Op::Binary || op == Op::Unary;
+}
+
+std::string_view ccfn spelling(TokenType op);
+
+class Function {
+public:
+    using Declaration = Node<NodeType::FUNCTION_DECLARATION>;
+
+    const Declaration* decl = nullptr;
+    Name name;
+    const Type* returnType = nullptr;   // 선언에서 풀지 못했으면 nullptr
+    std::vector<Instruction> values;
+    std::vector<Block> blocks;          // 0 번이 입구
+    std::vector<Value> params;
+    std::vector<Value> undefs;          // 어느 블록에도 속하지 않는다
+    std::vector<Value> forward;         // None 이면 바뀌지 않았다
+
+    inline explicit Function(const Declaration* declaration) : decl(declaration) {}
+
+    BlockId ccfn addBlock();
+    // 명령을 값으로 등록한다. 블록에 넣는 것은 호출자 몫이다.
+    Value ccfn make(Instruction instruction);
+    // block 의 코드 끝에 붙인다. 종결 명령이면 후속 블록과 이어 준다.
+    Value ccfn append(BlockId block, Instruction instruction);
+    void ccfn addEdge(BlockId from, BlockId to);
+    // from → to 간선을 지운다. to 의 phi 에서 그 간선의 피연산자도 뺀다.
+    void ccfn removeEdge(BlockId from, BlockId to);
+
+    inline Value resolve(Value v) {
+        Value root = v;
+        while (forward[root] != None) root = forward[root];
+        while (forward[v] != None) {
+            Value next = forward[v];
+            forward[v] = root;
+            v = next;
+        }
+        return root;
+    }
+    // from 을 쓰는 곳이 모두 to 를 쓰게 하고 from 을 지운다
+    void ccfn replace(Value from, Value to);
+    // 모든 피연산자를 resolve 하고 지운 명령을 블록에서 뺀다
+    void ccfn canonicalize();
+    // 입구에서 닿지 않는 블록을 지운다. 지운 블록이 있으면 true.
+    bool ccfn removeUnreachable();
+    // 입구에서 닿는 블록의 역후위 순서
+    std::vector<BlockId> ccfn reversePostorder() const;
+    // 살아 있는 명령 수 (phi 포함, undef 제외)
+    size_t ccfn size() const;
+
+    std::string ccfn dump() const;
+};
+
+// 프로그램에서 IR 로 내린 함수들. 내리지 못한 함수는 여기에 없고 AST 에서 바로 생성한다.
+class Module {
+private:
+    std::vector<std::unique_ptr<Function>> list;
+    std::unordered_map<const Function::Declaration*, Function*> byDecl;
+
+public:
+    // 내리지 못해서 AST 로 생성할 함수의 수
+    size_t skipped = 0;
+
+    inline void add(std::unique_ptr<Function> function) {
+        byDecl[function->decl] = function.get();
+        list.push_back(std::move(function));
+    }
+    inline const Function* find(const Function::Declaration* decl) const {
+        auto it = byDecl.find(decl);
+        return it == byDecl.end() ? nullptr : it->second;
+    }
+    inline const std::vector<std::unique_ptr<Function>>& functions() const { return list; }
+
+    std::string ccfn dump() const;
+};
+
+}
+
+#endif
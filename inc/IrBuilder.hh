@@ -0,0 +1,100 @@
+#ifndef IrBuilder_hh
+#define IrBuilder_hh
+
+#include "./AstVisitor.hh"
+#include "./Interner.hh"
+#include "./Ir.hh"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct Program;
+struct Type;
+
+#define ccfn
+
+// ===== IR 내리기 =====
+// 분석이 끝난 함수 본문을 SSA 로 내린다. 지역 변수는 블록마다 마지막 정의를 기억해 두고
+// 읽을 때 선행 블록을 거슬러 찾는다 (Braun et al., "Simple and Efficient Construction of
+// Static Single Assignment Form"). 선행 블록이 다 정해지지 않은 블록(while 의 머리)에서는
+// 빈 phi 를 두었다가 블록을 닫을(seal) 때 채운다. 피연산자가 모두 같은 phi 는 바로 지운다.
+//
+// 전역 변수는 Load / Store 로 남기고, && / || 는 오른쪽에 부작용이나 0 으로 나누기가 있을 때만
+// 분기로 푼다. 함수 안의 함수, 이름 아닌 호출/대입 대상, C++ 타입을 알 수 없는 값처럼
+// IR 로 나타내지 않는 것이 하나라도 있으면 그 함수는 내리지 않고 AST 로 생성한다.
+class IrBuilder : public AstVisitor<IrBuilder, ir::Value> {
+private:
+    friend class AstVisitor<IrBuilder, ir::Value>;
+    using FunctionDeclaration = Node<NodeType::FUNCTION_DECLARATION>;
+
+    struct Unsupported {};
+
+    struct Variable {
+        Name name;
+        const Type* type;
+    };
+
+    // 이름으로 찾는 전역 정보. 같은 이름이 다른 타입으로 두 번 나오면 nullptr 로 둔다.
+    std::unordered_map<Name, const Type*> globals;
+    std::unordered_map<Name, const Type*> functions;
+
+    std::unique_ptr<ir::Function> fn;
+    ir::BlockId current = 0;
+    std::vector<Variable> variables;                 // 선언 순서. 번호가 변수의 id
+    std::vector<std::pair<Name, uint32_t>> scope;    // 보이는 이름 → 변수 id (뒤가 안쪽)
+    std::unordered_map<uint64_t, ir::Value> definitions;   // (블록, 변수) → 값
+    std::vector<bool> sealed;
+    std::vector<std::vector<std::pair<uint32_t, ir::Value>>> incomplete;   // 블록마다 채울 phi
+
+    void ccfn collect(ASTNode* node);
+    void ccfn declare(std::unordered_map<Name, const Type*>& table, Name name, const Type* type);
+    std::unique_ptr<ir::Function> ccfn lower(FunctionDeclaration* func);
+
+    // ===== 블록과 변수 =====
+    ir::BlockId ccfn newBlock(bool seal);
+    void ccfn seal(ir::BlockId block);
+    void ccfn writeVariable(uint32_t variable, ir::BlockId block, ir::Value value);
+    ir::Value ccfn readVariable(uint32_t variable, ir::BlockId block);
+    ir::Value ccfn readRecursive(uint32_t variable, ir::BlockId block);
+    ir::Value ccfn addPhiOperands(uint32_t variable, ir::Value phi);
+    ir::Value ccfn removeTrivialPhi(ir::Value phi);
+    uint32_t ccfn lookup(Name name) const;
+
+    // ===== 명령 =====
+    ir::Value ccfn emit(ir::Instruction instruction);
+    ir::Value ccfn constant(const Type* type, int64_t value);
+    ir::Value ccfn convert(ir::Value value, const Type* type);
+    void ccfn jump(ir::BlockId target);
+    // 값이 있어야 하는 자리의 식 (void 호출이면 내리지 않는다)
+    ir::Value ccfn operand(ASTNode* node);
+    inline const Type* typeOf(ir::Value v) const { return fn->values[v].type; }
+
+    void ccfn lowerStatement(ASTNode* node);
+    ir::Value ccfn lowerShortCircuit(Node<NodeType::BINARY_EXPRESSION>* binary);
+
+    using AstVisitor::visit;
+    ir::Value ccfn visit(Node<NodeType::INTEGER_LITERAL>* lit);
+    ir::Value ccfn visit(Node<NodeType::FLOAT_LITERAL>* lit);
+    ir::Value ccfn visit(Node<NodeType::STRING_LITERAL>* lit);
+    ir::Value ccfn visit(Node<NodeType::BOOL_LITERAL>* lit);
+    ir::Value ccfn visit(Node<NodeType::IDENTIFIER>* id);
+    ir::Value ccfn visit(Node<NodeType::BINARY_EXPRESSION>* binary);
+    ir::Value ccfn visit(Node<NodeType::UNARY_EXPRESSION>* unary);
+    ir::Value ccfn visit(Node<NodeType::ASSIGNMENT_EXPRESSION>* assignment);
+    ir::Value ccfn visit(Node<NodeType::CALL_EXPRESSION>* call);
+    ir::Value ccfn visit(Node<NodeType::VARIABLE_DECLARATION>* var);
+    ir::Value ccfn visit(Node<NodeType::BLOCK_STATEMENT>* block);
+    ir::Value ccfn visit(Node<NodeType::IF_STATEMENT>* ifStmt);
+    ir::Value ccfn visit(Node<NodeType::WHILE_STATEMENT>* whileStmt);
+    ir::Value ccfn visit(Node<NodeType::RETURN_STATEMENT>* returnStmt);
+    ir::Value ccfn visit(Node<NodeType::EXPRESSION_STATEMENT>* exprStmt);
+    inline ir::Value visitOther(ASTNode*) { throw Unsupported{}; }
+
+public:
+    // 최상위와 namespace 안의 함수를 모두 내린다. 내리지 못한 함수는 Module::skipped 에 센다.
+    ir::Module ccfn build(Program* program);
+};
+
+#endif
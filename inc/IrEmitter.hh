@@ -0,0 +1,46 @@
+#ifndef IrEmitter_hh
+#define IrEmitter_hh
+
+#include "./Ir.hh"
+#include "./OutputBuffer.hh"
+#include <string>
+#include <vector>
+
+class CodeGenerator;
+
+#define ccfn
+
+// ===== IR → C++ =====
+// 함수 본문 하나를 C++ 블록으로 쓴다. 값마다 _t<번호> 임시 변수를 함수 머리에 선언하고,
+// 기본 블록은 역후위 순서로 _L<번호> 레이블과 goto 로 잇는다. 다음 블록으로 그냥 넘어가는
+// 점프와 아무도 가지 않는 레이블은 쓰지 않는다.
+//
+// phi 는 간선마다 복사로 푼다. 같은 블록의 phi 끼리 서로를 읽으면 (돌아가며 바꾸는 루프 변수)
+// 새 값을 모두 먼저 읽어 둔 다음에 쓴다. 상수는 임시 변수 없이 쓰는 자리에 바로 쓴다.
+class IrEmitter {
+private:
+    OutputBuffer& output;
+    const CodeGenerator& generator;     // 타입 이름
+    const ir::Function* fn = nullptr;
+    int indentLevel = 0;
+    std::vector<uint32_t> uses;         // 값마다 쓰는 명령 수
+    std::vector<bool> labelled;         // goto 가 가는 블록
+
+    void ccfn declarations();
+    void ccfn value(ir::Value v);
+    void ccfn instruction(ir::Value v);
+    // from → to 로 갈 때 phi 에 넣을 복사
+    void ccfn copies(ir::BlockId from, ir::BlockId to, bool write);
+    bool ccfn hasCopies(ir::BlockId from, ir::BlockId to) const;
+    void ccfn branchTo(ir::BlockId from, ir::BlockId to, ir::BlockId next, bool write);
+    void ccfn terminator(ir::BlockId block, ir::BlockId next, bool write);
+    std::string ccfn typeName(const Type* type) const;
+
+public:
+    inline IrEmitter(OutputBuffer& sink, const CodeGenerator& types) : output(sink), generator(types) {}
+
+    // { ... } 를 쓴다. 여는 중괄호 앞의 함수 머리는 호출자가 쓴다.
+    void ccfn body(const ir::Function& function, int level);
+};
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef IrPasses_hh
+#define IrPasses_hh
+
+#include "./Ir.hh"
+#include <cstddef>
+#include <vector>
+
+#define ccfn
+
+// ===== IR 패스 =====
+// 패스는 함수 하나를 받아 고치고, 바꾼 것이 있으면 true 를 돌려준다. 모두 SSA 를 지킨다.
+namespace ir {
+
+using Pass = bool (*)(Function& fn);
+
+// 조건부 상수 전파 (Wegman & Zadeck). 실행될 수 있는 간선만 따라가며 int / bool 값을
+// 상수로 좁히고, 조건이 상수인 분기를 점프로 바꾸고, 실행되지 않는 블록을 지운다.
+// 접는 규칙은 Optimizer 와 같다 (int 에 들어가지 않거나 0 으로 나누면 접지 않는다).
+bool ccfn propagateConstants(Function& fn);
+// 복사 전파. Copy, 같은 타입으로의 Cast, 피연산자가 하나뿐인 phi 를 그 피연산자로 바꾼다.
+bool ccfn propagateCopies(Function& fn);
+// 지배 트리를 따라가는 전역 값 번호 매기기. 지배하는 블록에 같은 연산(같은 피연산자)이
+// 있으면 그 값을 쓴다. 교환 법칙이 있는 연산은 피연산자를 정렬해서 본다.
+bool ccfn numberValues(Function& fn);
+// 죽은 코드 제거. 부작용이 있는 명령에서 피연산자를 따라 닿지 않는 명령과 블록을 지운다.
+bool ccfn eliminateDeadCode(Function& fn);
+
+// ===== 패스 관리자 =====
+// 패스를 하나씩 모든 함수에 돌린다. 패스마다 ZUST_PROFILE_SCOPE 구간 하나가 생기므로
+// --time-report 에 패스별 시간과 패스가 끝난 뒤의 명령 수(nodes 칸)가 나온다.
+class PassManager {
+private:
+    struct Entry {
+        const char* name;       // 계측 구간 이름
+        Pass run;
+        size_t changed = 0;     // 바꾼 함수 수
+    };
+    std::vector<Entry> passes;
+
+public:
+    inline void add(const char* name, Pass pass) { passes.push_back({name, pass}); }
+    void ccfn run(Module& module);
+
+    // sccp → copyprop → gvn → dce
+    static PassManager ccfn standard();
+};
+
+}
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef Keywords_hh
+#define Keywords_hh
+
+#include "./TokenType.hh"
+#include <cstdint>
+#include <string_view>
+
+// ===== 키워드 테이블 =====
+// 키워드 분류는 컴파일 타임에 만든 완전 해시(perfect hash)로 한다.
+// 렉서 생성 시 테이블을 채울 필요가 없고, 식별자 하나당 해시 한 번과
+// 문자열 비교 한 번으로 끝난다.
+namespace keywords {
+
+struct Keyword {
+    std::string_view spelling;
+    TokenType type;
+};
+
+inline constexpr Keyword table[] = {
+    {"let", TokenType::LET},             {"fn", TokenType::FN},
+    {"if", TokenType::IF},               {"else", TokenType::ELSE},
+    {"while", TokenType::WHILE},         {"for", TokenType::FOR},
+    {"foreach", TokenType::FOREACH},     {"switch", TokenType::SWITCH},
+    {"case", TokenType::CASE},           {"default", TokenType::DEFAULT},
+    {"namespace", TokenType::NAMESPACE}, {"import", TokenType::IMPORT},
+    {"return", TokenType::RETURN},       {"break", TokenType::BREAK},
+    {"continue", TokenType::CONTINUE},   {"class", TokenType::CLASS},
+    {"struct", TokenType::STRUCT},       {"enum", TokenType::ENUM},
+    {"extends", TokenType::EXTENDS},     {"new", TokenType::NEW},
+    {"this", TokenType::THIS},           {"try", TokenType::TRY},
+    {"catch", TokenType::CATCH},         {"throw", TokenType::THROW},
+    {"const", TokenType::CONST},         {"static", TokenType::STATIC},
+    {"public", TokenType::PUBLIC},       {"private", TokenType::PRIVATE},
+    {"protected", TokenType::PROTECTED},
+    {"int", TokenType::INT},             {"float", TokenType::FLOAT},
+    {"char", TokenType::CHAR},           {"byte", TokenType::BYTE},
+    {"long", TokenType::LONG},           {"double", TokenType::DOUBLE},
+    {"short", TokenType::SHORT},         {"bool", TokenType::BOOL},
+    {"string", TokenType::STRING},       {"void", TokenType::VOID},
+    {"true", TokenType::BOOL_LITERAL},   {"false", TokenType::BOOL_LITERAL},
+};
+
+inline constexpr size_t count = sizeof(table) / sizeof(table[0]);
+inline constexpr size_t slots = 128;
+inline constexpr uint8_t emptySlot = 0xff;
+
+// 길이, 첫 글자, 두 번째 글자, 마지막 글자만 섞는다 (키워드는 모두 2글자 이상)
+constexpr uint32_t hash(std::string_view s, uint32_t seed) {
+    uint32_t h = seed ^ static_cast<uint32_t>(s.size());
+    h = h * 0x9E3779B1u + static_cast<unsigned char>(s[0]);
+    h = h * 0x9E3779B1u + static_cast<unsigned char>(s[1]);
+    h = h * 0x9E3779B1u + static_cast<unsigned char>(s[s.size() - 1]);
+    return (h ^ (h >> 15)) & (slots - 1);
+}
+
+constexpr bool collisionFree(uint32_t seed) {
+    bool used[slots] = {};
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t h = hash(table[i].spelling, seed);
+        if (used[h]) return false;
+        used[h] = true;
+    }
+    return true;
+}
+
+constexpr uint32_t findSeed() {
+    for (uint32_t seed = 1; seed < 100000; ++seed) {
+        if (collisionFree(seed)) return seed;
+    }
+    return 0;
+}
+
+inline constexpr uint32_t seed = findSeed();
+static_assert(seed != 0, "no perfect hash seed for the keyword table");
+
+struct Slots {
+    uint8_t index[slots];
+};
+
+constexpr Slots buildSlots() {
+    Slots s{};
+    for (size_t i = 0; i < slots; ++i) s.index[i] = emptySlot;
+    for (size_t i = 0; i < count; ++i) {
+        s.index[hash(table[i].spelling, seed)] = static_cast<uint8_t>(i);
+    }
+    return s;
+}
+
+inline constexpr Slots lookup = buildSlots();
+
+inline constexpr size_t minLength = 2;
+inline constexpr size_t maxLength = 9;
+
+} // namespace keywords
+
+// 키워드면 해당 토큰 타입을, 아니면 IDENTIFIER 를 돌려준다
+constexpr TokenType classifyKeyword(std::string_view id) {
+    if (id.size() < keywords::minLength || id.size() > keywords::maxLength) {
+        return TokenType::IDENTIFIER;
+    }
+    uint8_t i = keywords::lookup.index[keywords::hash(id, keywords::seed)];
+    if (i != keywords::emptySlot && keywords::table[i].spelling == id) {
+        return keywords::table[i].type;
+    }
+    return TokenType::IDENTIFIER;
+}
+
+static_assert(classifyKeyword("namespace") == TokenType::NAMESPACE);
+static_assert(classifyKeyword("protected") == TokenType::PROTECTED);
+static_assert(classifyKeyword("lets") == TokenType::IDENTIFIER);
+static_assert(classifyKeyword("x") == TokenType::IDENTIFIER);
+
+#endif
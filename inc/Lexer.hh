@@ -2,7 +2,9 @@
 #define Lexer_hh
 
 #include "./Token.hh" 
-#include <map>
+#include "./StringArena.hh"
+#include "./SourceBuffer.hh"
+#include <string>
 #include <vector>
 
 #define ccfunc
@@ -10,15 +12,17 @@
 // ===== 렉서 (Lexer) =====
 class Lexer {
 private:
-    std::string source;
+    SourceBuffer buffer;
+    std::string_view source;
+    StringArena literals;   // 이스케이프를 푼 문자열 리터럴
     size_t pos;
+    size_t start = 0;       // 방금 읽은 토큰이 시작한 위치
     int line;
     int column;
-    std::map<std::string, TokenType> keywords;
     
-    void ccfunc initKeywords();
     char ccfunc peek(int offset = 0) const;
     char ccfunc advance();
+    void ccfunc skipTo(const char* to);
     void ccfunc skipWhitespace();
     
     Token ccfunc readNumber();
@@ -27,13 +31,28 @@ private:
     Token ccfunc readIdentifier();
     Token ccfunc readComment();
 
+    inline std::string_view slice(size_t start) const {
+        return source.substr(start, pos - start);
+    }
     
 public:
-    inline Lexer(const std::string& src) : source(src), pos(0), line(1), column(1) {
-        initKeywords();
-    }
+    inline Lexer(SourceBuffer src)
+        : buffer(std::move(src)), source(buffer.view()), pos(0), line(1), column(1) {}
+    inline Lexer(std::string src) : Lexer(SourceBuffer(std::move(src))) {}
+
+    // 토큰이 source 를 가리키므로 복사/이동을 막는다
+    Lexer(const Lexer&) = delete;
+    Lexer& operator=(const Lexer&) = delete;
     
+    // 다음 토큰 하나를 읽는다. 입력 끝에서는 EOF_TOKEN 을 계속 돌려준다.
+    Token ccfunc next();
     std::vector<Token> ccfunc tokenize();
+
+    // 다음에 읽을 위치 (방금 읽은 토큰의 끝)
+    inline size_t position() const { return pos; }
+    // 방금 읽은 토큰의 시작 위치 (앞의 공백은 빼고)
+    inline size_t tokenStart() const { return start; }
+    inline std::string_view text() const { return source; }
     
 };
 
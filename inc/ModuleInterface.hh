@@ -0,0 +1,72 @@
+#ifndef ModuleInterface_hh
+#define ModuleInterface_hh
+
+#include "./Interner.hh"
+#include "./Nodes.hh"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct Program;
+
+#define ccfn
+
+// 소스 파일이 바뀌었는지 보는 표식 (크기와 마지막 수정 시각)
+struct SourceStamp {
+    uint64_t size = 0;
+    int64_t time = 0;
+
+    inline bool operator==(const SourceStamp& other) const { return size == other.size && time == other.time; }
+    inline bool operator!=(const SourceStamp& other) const { return !(*this == other); }
+};
+
+// 모듈이 내보내는 최상위 선언 하나 (함수 또는 let)
+struct ExportedSymbol {
+    Name name;
+    Name type;                  // 변수의 타입 또는 함수의 반환 타입 (분석이 추론한 철자)
+    bool isFunction = false;
+    uint32_t paramBegin = 0;    // ModuleInterface::params 에서의 위치
+    uint32_t paramCount = 0;
+};
+
+// 이 모듈을 만들 때 가져온 모듈과 그때의 소스 표식
+struct ImportedModule {
+    Name name;
+    SourceStamp stamp;
+};
+
+// ===== 모듈 인터페이스 =====
+// 가져오는 쪽이 모듈 소스를 다시 렉싱/분석하지 않도록 내보낸 선언만 담아 둔 것.
+// 분석이 끝난 모듈 AST 에서 뽑아 .zsi 파일에 쓰고, 다음부터는 그 파일을 매핑해서 읽는다.
+//
+// 직렬화 형식 (리틀 엔디언). 이름은 모두 문자열 표의 번호다.
+//   "ZSI\0" u32:version u64:sourceSize i64:sourceTime
+//   u32:strings { u32:len bytes }
+//   u32:name
+//   u32:imports { u32:name u64:size i64:time }
+//   u32:symbols { u8:isFunction u32:name u32:type u32:params { u32:type u32:name } }
+struct ModuleInterface {
+    // 2: return 이 없는 함수를 auto 대신 void 로 내보낸다
+    static constexpr uint32_t Version = 2;
+
+    Name name;                          // "std.io"
+    SourceStamp source;
+    std::vector<ImportedModule> imports;
+    std::vector<ExportedSymbol> symbols;
+    std::vector<Parameter> params;
+
+    // 분석이 끝난 program 의 최상위 함수와 let 을 모은다 (main 은 빼고)
+    static ModuleInterface ccfn extract(Name name, const Program* program);
+
+    std::string ccfn serialize() const;
+    static ModuleInterface ccfn deserialize(std::string_view data);
+    // 파일 전체를 읽지 않고 머리(형식, 버전, 소스 표식)만 확인한다
+    static bool ccfn readStamp(std::string_view data, SourceStamp& stamp);
+
+    inline const Parameter* paramsOf(const ExportedSymbol& symbol) const {
+        return params.data() + symbol.paramBegin;
+    }
+};
+
+#endif
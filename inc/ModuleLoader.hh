@@ -0,0 +1,74 @@
+#ifndef ModuleLoader_hh
+#define ModuleLoader_hh
+
+#include "./Interner.hh"
+#include "./ModuleInterface.hh"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct Program;
+
+#define ccfn
+
+// ===== 모듈 로더 =====
+// import 문을 모듈 소스 파일로 찾아서 그 모듈의 인터페이스를 채운다.
+// 모듈 a.b 는 가져오는 파일의 디렉터리, 처음 컴파일한 파일의 디렉터리, 검색 경로에서
+// 차례로 a/b.zs 를 찾는다.
+//
+// 모듈을 처음 분석하면 내보낸 선언을 소스 옆의 a/b.zsi 에 쓴다. 다음부터는 소스와
+// 그 모듈이 가져온 모듈들의 크기/수정 시각이 기록과 같으면 .zsi 를 매핑해서 읽기만
+// 하고 소스는 렉싱하지 않는다. 가져온 모듈이 다시 만들어지면 그 모듈도 다시 만든다.
+//
+// 그래프는 두 단계로 돈다. 먼저 import 를 따라가며 모듈을 찾고(물결마다 병렬로),
+// 다음에 의존하는 모듈이 모두 끝난 모듈들을 한 물결로 묶어 병렬로 분석한다.
+class ModuleLoader {
+private:
+    struct Unit {
+        Name name;
+        std::string path;                   // a/b.zs
+        SourceStamp stamp;
+        std::vector<Name> imports;
+        // 디스크에서 읽었거나 새로 만든 인터페이스. 읽은 것은 아직 최신인지 모른다.
+        std::shared_ptr<const ModuleInterface> interface;
+        std::unique_ptr<Program> program;   // 소스를 파싱했을 때만
+        bool done = false;
+        bool rebuilt = false;               // 이번에 소스에서 다시 만들었다
+    };
+
+    std::vector<std::string> searchPaths;
+    std::string rootDirectory;              // resolve 에 넘긴 파일의 디렉터리
+    size_t threads;
+    // 물결 사이에 호출한 스레드에서만 늘린다. 작업자들은 읽기만 한다.
+    std::unordered_map<Name, std::unique_ptr<Unit>> units;
+    std::atomic<size_t> loaded{0};          // .zsi 를 그대로 쓴 모듈 수
+    std::atomic<size_t> built{0};           // 소스에서 다시 만든 모듈 수
+
+    std::string ccfn locate(Name module, const std::string& directory) const;
+    // 소스 또는 인터페이스를 읽어 unit 의 import 목록을 채운다
+    void ccfn discover(Unit& unit);
+    // 의존하는 모듈이 모두 끝난 unit 의 인터페이스를 확정한다
+    void ccfn build(Unit& unit);
+    // program 의 import 문에 (끝난) 모듈의 인터페이스를 붙인다
+    void ccfn link(Program* program) const;
+    // 끝나지 않은 모듈들 사이의 순환 하나를 "a -> b -> a" 꼴로
+    std::string ccfn describeCycle() const;
+
+public:
+    // threads 가 0 이면 하드웨어 스레드 수
+    explicit ModuleLoader(std::vector<std::string> paths, size_t threads = 0);
+    ~ModuleLoader();
+
+    // program 의 import 문을 모두 풀어서 IMPORT_STATEMENT 의 interface 를 채운다.
+    // origin 은 program 의 소스 파일 경로 (비어 있으면 현재 디렉터리를 기준으로 찾는다).
+    // 쓰인 인터페이스는 program->modules 에도 들어가므로 로더보다 오래 살 수 있다.
+    void ccfn resolve(Program* program, const std::string& origin);
+
+    inline size_t loadedModules() const { return loaded; }
+    inline size_t builtModules() const { return built; }
+};
+
+#endif
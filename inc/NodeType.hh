@@ -9,7 +9,8 @@ typedef enum class NodeType {
     BINARY_EXPRESSION, UNARY_EXPRESSION, CALL_EXPRESSION,
     IDENTIFIER, INTEGER_LITERAL, FLOAT_LITERAL, STRING_LITERAL,
     CHAR_LITERAL, BOOL_LITERAL, ASSIGNMENT_EXPRESSION,
-    NAMESPACE_DECLARATION, IMPORT_STATEMENT
+    NAMESPACE_DECLARATION, IMPORT_STATEMENT,
+    ERROR_STATEMENT
 } NodeType;
 
 #endif
\ No newline at end of file
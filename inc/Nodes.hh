@@ -1,11 +1,12 @@
 #ifndef Nodes_hh
 #define  Nodes_hh
 
-#include <string>
+#include <string_view>
 #include "./ASTNode.hh"
-#include <memory>
-#include <vector>
+#include "./AstArena.hh"
+#include "./Interner.hh"
 
+// 자식 노드는 아레나 포인터, 식별자와 타입 이름은 전역 Interner 의 Name 이다
 template<NodeType a>
 struct NodeVAR : public ASTNode {
     constexpr static NodeType var = a;
@@ -18,74 +19,78 @@ struct Node;
 
 
 NodeDef(NodeType::VARIABLE_DECLARATION) {
-    std::string dataType;
-    std::string name;
-    std::unique_ptr<ASTNode> initializer;
+    Name dataType;
+    Name name;
+    ASTNode* initializer = nullptr;
     inline NodeConstruct() {}
 };
 
 
+struct Parameter {
+    Name type;
+    Name name;
+};
+
 NodeDef(NodeType::FUNCTION_DECLARATION) {
-    std::string returnType;
-    std::string name;
-    std::vector<std::pair<std::string, std::string>> parameters; // type, name
-    std::unique_ptr<ASTNode> body;
+    Name returnType;
+    Name name;
+    NodeList<Parameter> parameters;
+    ASTNode* body = nullptr;
     inline NodeConstruct() {}
 };
 
 NodeDef(NodeType::BLOCK_STATEMENT) {
-    std::vector<std::unique_ptr<ASTNode>> statements;
+    NodeList<ASTNode*> statements;
     inline NodeConstruct() {}
 };
 
 NodeDef(NodeType::IF_STATEMENT) {
-    std::unique_ptr<ASTNode> condition;
-    std::unique_ptr<ASTNode> thenStatement;
-    std::unique_ptr<ASTNode> elseStatement;
+    ASTNode* condition = nullptr;
+    ASTNode* thenStatement = nullptr;
+    ASTNode* elseStatement = nullptr;
     inline NodeConstruct() {}
 };
 
 NodeDef(NodeType::WHILE_STATEMENT) {
-    std::unique_ptr<ASTNode> condition;
-    std::unique_ptr<ASTNode> body;
+    ASTNode* condition = nullptr;
+    ASTNode* body = nullptr;
     inline NodeConstruct() {}
 };
 
 NodeDef(NodeType::RETURN_STATEMENT) {
-    std::unique_ptr<ASTNode> expression;
+    ASTNode* expression = nullptr;
 };
 
 NodeDef(NodeType::EXPRESSION_STATEMENT) {
-    std::unique_ptr<ASTNode> expression;
+    ASTNode* expression = nullptr;
     inline NodeConstruct() {}
-    inline ~Node() {}
 };
 
 
 #include "./TokenType.hh"
 
 NodeDef(NodeType::BINARY_EXPRESSION) {
-    std::unique_ptr<ASTNode> left;
+    ASTNode* left = nullptr;
     TokenType operator_;
-    std::unique_ptr<ASTNode> right;
+    ASTNode* right = nullptr;
     inline NodeConstruct(), operator_() {}
 };
 
 NodeDef(NodeType::UNARY_EXPRESSION) {
     TokenType operator_;
-    std::unique_ptr<ASTNode> operand;
+    ASTNode* operand = nullptr;
     inline NodeConstruct(), operator_() {}
 };
 
 NodeDef(NodeType::CALL_EXPRESSION) {
-    std::unique_ptr<ASTNode> callee;
-    std::vector<std::unique_ptr<ASTNode>> arguments;
+    ASTNode* callee = nullptr;
+    NodeList<ASTNode*> arguments;
     inline NodeConstruct() {}
 };
 
 NodeDef(NodeType::IDENTIFIER) {
-    std::string name;
-    inline NodeConstruct(const std::string& a), name(a) {}
+    Name name;
+    inline NodeConstruct(Name a), name(a) {}
 };
 
 NodeDef(NodeType::INTEGER_LITERAL) {
@@ -99,9 +104,8 @@ NodeDef(NodeType::FLOAT_LITERAL) {
 };
 
 NodeDef(NodeType::STRING_LITERAL) {
-    std::string value;
-    inline NodeConstruct(const std::string& v) , value(v) {}
-    inline NodeConstruct(const char* v) , value(v) {}
+    std::string_view value;
+    inline NodeConstruct(std::string_view v) , value(v) {}
 };
 
 NodeDef(NodeType::BOOL_LITERAL) {
@@ -110,15 +114,36 @@ NodeDef(NodeType::BOOL_LITERAL) {
 };
 
 NodeDef(NodeType::ASSIGNMENT_EXPRESSION) {
-    std::unique_ptr<ASTNode> left;
-    std::unique_ptr<ASTNode> right;
+    ASTNode* left = nullptr;
+    ASTNode* right = nullptr;
+    // 복합 대입 (x += e) 은 x = x + e 로 풀어서 담고, 여기에 원래 연산자(PLUS)를
+    // 남겨 둔다. 코드 생성기만 이 값을 보고 += 로 되돌려 쓴다.
+    TokenType operator_ = TokenType::ASSIGN;
     inline NodeConstruct() {}
 };
 
 NodeDef(NodeType::NAMESPACE_DECLARATION) {
-    std::string name;
-    std::unique_ptr<ASTNode> body;
+    Name name;
+    ASTNode* body = nullptr;
+    inline NodeConstruct() {}
+};
+
+struct ModuleInterface;
+
+// import a.b; 모듈 이름은 점으로 이은 철자 그대로다. interface 는 ModuleLoader 가
+// 모듈을 찾아 채운다. 분석기는 여기서 내보낸 선언을 전역 스코프에 들인다.
+NodeDef(NodeType::IMPORT_STATEMENT) {
+    Name module;
+    const ModuleInterface* interface = nullptr;
     inline NodeConstruct() {}
 };
 
-#endif
\ No newline at end of file
+// 문법 오류로 읽지 못한 문장 자리. 진단이 하나라도 있으면 컴파일러는 분석 전에
+// 멈추므로 이 노드는 파서 바깥(편집기 등)에서만 보인다.
+NodeDef(NodeType::ERROR_STATEMENT) {
+    int line;
+    int column;
+    inline NodeConstruct(int l, int c), line(l), column(c) {}
+};
+
+#endif
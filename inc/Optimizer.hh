@@ -0,0 +1,52 @@
+#ifndef Optimizer_hh
+#define Optimizer_hh
+
+#include "./AstVisitor.hh"
+#include "./NodeType.hh"
+#include <cstdint>
+
+class ASTNode;
+class AstArena;
+struct Type;
+template<NodeType> struct Node;
+
+#define ccfn
+
+// ===== 최적화기 =====
+// 식 노드를 더 간단한 식으로 바꾼다. 노드의 valueType 을 믿으므로 의미 분석기가
+// 그 식의 타입을 정한 다음에만 접을 수 있다.
+//  - 상수 접기: 리터럴끼리의 이항/단항 식을 리터럴 하나로 바꾼다
+//  - 대수 항등식: x*1, x+0, x-0, x/1, x|0, x^0, 시프트 0 은 x, 정수 x*0 / x&0 은 0
+//  - 이중 부정: -(-x), !!x, ~~x 는 x
+// 결과가 원래 식과 타입이 같고 관찰 가능한 동작이 같을 때만 바꾼다. 넘치는 정수,
+// 0 으로 나누기, 유한하지 않은 실수 결과는 접지 않고 그대로 둔다.
+//
+// 따로 AST 를 걷지 않는다. 의미 분석기가 자식까지 분석한 식마다 fold 를 부르므로
+// (SemanticAnalyser 의 folder) 접기는 분석과 같은 한 번의 순회 안에서 끝난다.
+class Optimizer : public AstVisitor<Optimizer, ASTNode*> {
+private:
+    friend class AstVisitor<Optimizer, ASTNode*>;
+
+    AstArena* arena = nullptr;
+
+    using AstVisitor::visit;
+    ASTNode* ccfn visit(Node<NodeType::BINARY_EXPRESSION>* binary);
+    ASTNode* ccfn visit(Node<NodeType::UNARY_EXPRESSION>* unary);
+    inline ASTNode* visitOther(ASTNode* node) { return node; }
+
+    // 새 리터럴은 바꿀 식의 타입을 그대로 물려받는다
+    ASTNode* ccfn makeInt(int64_t value, const Type* type);
+    ASTNode* ccfn makeFloat(double value, const Type* type);
+    ASTNode* ccfn makeBool(bool value);
+
+public:
+    // 새 리터럴을 만들 아레나 (보통 분석 중인 Program 의 아레나)
+    inline explicit Optimizer(AstArena* nodes) : arena(nodes) {}
+
+    // 자식이 이미 접힌 식 노드 하나를 접는다. 바꾼 노드나 node 를 그대로 돌려준다.
+    inline ASTNode* fold(ASTNode* node) { return dispatch(node); }
+    // 식을 통째로 버려도 되는가 (호출, 대입, 0 으로 나눌 수 있는 정수 나눗셈이 없다)
+    static bool ccfn isPure(const ASTNode* node);
+};
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef OutputBuffer_hh
+#define OutputBuffer_hh
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define ccfn
+
+// ===== 출력 버퍼 =====
+// 코드 생성기가 쓰는 문자열 빌더. 고정 크기 청크에 memcpy 로 이어 붙인다.
+// 메모리에 모을 때는 청크를 새로 잡기만 하고 이미 쓴 내용을 옮기지 않는다.
+// 파일 디스크립터에 연결하면 청크가 찰 때마다 통째로 write 하고 같은 청크를 다시 쓰므로
+// 출력이 아무리 커도 메모리는 청크 하나만 쓴다.
+class OutputBuffer {
+private:
+    static constexpr size_t ChunkSize = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> chunks;
+    std::vector<size_t> used;     // 다 찬 청크마다 쓴 바이트 수 (마지막 청크는 cursor 로 안다)
+    char* cursor = nullptr;
+    char* limit = nullptr;
+    size_t flushed = 0;           // 디스크립터로 이미 내보낸 바이트 수
+
+    int fd = -1;
+    bool ownsFd = false;
+
+    void ccfn grow();
+    void ccfn appendSlow(const char* data, size_t size);
+    void ccfn writeAll(const char* data, size_t size);
+
+public:
+    // 메모리에 모은다. 다 쓴 뒤 str() 로 꺼낸다.
+    OutputBuffer();
+    // 이미 열린 디스크립터로 흘려보낸다 (닫지 않는다)
+    explicit OutputBuffer(int fd);
+    ~OutputBuffer();
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    // 파일을 새로 만들어 그 디스크립터로 흘려보낸다. 소멸할 때 남은 내용을 쓰고 닫는다.
+    void ccfn openFile(const std::string& path);
+    // 청크에 남은 내용을 디스크립터로 내보낸다. 메모리 모드에서는 아무것도 하지 않는다.
+    void ccfn flush();
+
+    // 지금까지 쓴 전체 바이트 수
+    size_t ccfn size() const;
+    // 메모리 모드에서 모은 내용을 한 번에 이어 붙여 돌려준다
+    std::string ccfn str() const;
+
+    inline void append(const char* data, size_t size) {
+        if (static_cast<size_t>(limit - cursor) >= size) {
+            std::memcpy(cursor, data, size);
+            cursor += size;
+            return;
+        }
+        appendSlow(data, size);
+    }
+
+    // 들여쓰기 한 단계는 공백 네 칸. 미리 만든 공백 문자열에서 잘라 쓴다.
+    void ccfn indent(int level);
+
+    inline OutputBuffer& operator<<(std::string_view s) {
+        append(s.data(), s.size());
+        return *this;
+    }
+    // 문자열 리터럴은 길이를 컴파일 타임에 안다
+    template<size_t N>
+    inline OutputBuffer& operator<<(const char (&literal)[N]) {
+        append(literal, N - 1);
+        return *this;
+    }
+    inline OutputBuffer& operator<<(const std::string& s) {
+        append(s.data(), s.size());
+        return *this;
+    }
+    inline OutputBuffer& operator<<(char c) {
+        if (cursor == limit) grow();
+        *cursor++ = c;
+        return *this;
+    }
+    OutputBuffer& ccfn operator<<(int64_t value);
+    inline OutputBuffer& operator<<(int value) { return *this << static_cast<int64_t>(value); }
+    // std::ostream 의 기본 형식(%g, 유효숫자 6자리)과 같게 쓴다
+    OutputBuffer& ccfn operator<<(double value);
+};
+
+#endif
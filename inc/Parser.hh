@@ -2,84 +2,126 @@
 #define Parser_hh
 
 #include "./Token.hh"
+#include "./Lexer.hh"
+#include "./TokenBuffer.hh"
 #include "./ASTNode.hh"
+#include <cstdint>
+#include <string>
 #include <vector>
 #include <memory>
 #include <stdexcept>
 #include "./Nodes.hh"
 #include "./Program.hh"
 
-#define MkUniqueNode(e) std::make_unique<Node<e>>
+#define MkNode(e) arena->make<Node<e>>
 #define ccfn
 
+// ===== 진단 =====
+// 파서는 첫 오류에서 멈추지 않고 오류마다 진단을 하나씩 남긴다
+struct Diagnostic {
+    int line;
+    int column;
+    std::string message;
+};
+
 // ===== 파서 (Parser) =====
 class Parser {
 private:
-    std::vector<Token> tokens;
-    size_t pos;
-    
-    const inline Token& current() const {
-        if (pos >= tokens.size()) return tokens.back(); // EOF 토큰
-        return tokens[pos];
-    }
+    // 토큰은 TokenBuffer 의 종류 배열을 바로 읽는다. 렉서에서 읽을 때는 Chunk 개씩
+    // 당겨 오고, 미리 만든 버퍼를 받으면 그대로 읽는다.
+    // 항상 [at, at + Lookahead) 가 버퍼 안에 있어서 current()/peek() 는 범위를 확인하지 않는다.
+    // 끝까지 읽은 버퍼는 EOF 뒤에 패딩이 있으므로 EOF 에 멈춰 있어도 그렇다.
+    static constexpr size_t Lookahead = TokenBuffer::Padding;
+    Lexer* lexer = nullptr;
+    TokenBuffer stream;                     // 렉서에서 당겨 온 토큰
+    const TokenBuffer* tokens = &stream;
+    const uint8_t* types = nullptr;         // tokens 의 종류 배열
+    size_t at = 0;                          // 지금 토큰의 버퍼 안 위치
+    size_t limit = 0;                       // at 이 여기 닿으면 다시 채운다
+    size_t head = 0;                        // 지금까지 소비한 토큰 수
 
-    inline Token& current() {
-        if (pos >= tokens.size()) return tokens.back(); // EOF 토큰
-        return tokens[pos];
-    }
-    
-    const Token& peek(int offset = 1) const {
-        if (pos + offset >= tokens.size()) return tokens.back();
-        return tokens[pos + offset];
+    // 노드는 만들고 있는 Program 의 아레나에 할당한다.
+    // 자식 목록은 scratch 스택에 모았다가 완성되면 아레나 배열로 옮긴다.
+    AstArena* arena = nullptr;
+    std::vector<ASTNode*> scratch;
+    std::vector<Parameter> paramScratch;
+    std::vector<TokenType> prefixScratch;   // 단항 연산자 스택
+
+    // 오류 복구 (panic mode). error() 는 진단을 남기고 SyntaxError 를 던진다.
+    // 문장 경계의 recover() 가 받아서 동기화 지점까지 건너뛰고 오류 노드를 넣는다.
+    struct SyntaxError {};
+    static constexpr size_t MaxDiagnostics = 100;
+    std::vector<Diagnostic> errors;
+    size_t lastErrorAt = SIZE_MAX;      // 같은 토큰에서 잇따라 나는 오류는 한 번만 남긴다
+
+    void ccfn refill();
+
+    inline void advance() {
+        head++;
+        if (++at >= limit) refill();
     }
 
-    Token& peek(int offset = 1) {
-        if (pos + offset >= tokens.size()) return tokens.back();
-        return tokens[pos + offset];
+    inline TokenRef current() const {
+        return TokenRef{static_cast<TokenType>(types[at]), tokens, at};
     }
 
+    // offset 은 Lookahead 보다 작아야 한다
+    inline TokenRef peek(int offset = 1) const {
+        return TokenRef{static_cast<TokenType>(types[at + offset]), tokens, at + offset};
+    }
 
     bool ccfn match(TokenType type, bool skip = 1);
     void ccfn expect(TokenType type);
     void ccfn skipNewlines();
 
+    [[noreturn]] void ccfn error(TokenRef token, const std::string& message);
+    // ';' 다음, 짝이 맞는 '}' 다음, 또는 '}' 나 문장을 여는 키워드 앞까지 건너뛴다
+    void ccfn synchronize();
+    ASTNode* ccfn recover(ASTNode* (Parser::*parseOne)());
+    ASTNode* ccfn parseTopLevelStatement();
+
     
-    std::unique_ptr<ASTNode> ccfn parseExpression();
-    std::unique_ptr<ASTNode> ccfn parseAssignmentExpression();
-    std::unique_ptr<ASTNode> ccfn parseLogicalOrExpression();
-    std::unique_ptr<ASTNode> ccfn parseLogicalAndExpression();
-    std::unique_ptr<ASTNode> ccfn parseBitwiseOrExpression();
-    std::unique_ptr<ASTNode> ccfn parseBitwiseXorExpression();
-    std::unique_ptr<ASTNode> ccfn parseBitwiseAndExpression();
-    std::unique_ptr<ASTNode> ccfn parseEqualityExpression();
-    std::unique_ptr<ASTNode> ccfn parseRelationalExpression();
-    std::unique_ptr<ASTNode> ccfn parseShiftExpression();
-    std::unique_ptr<ASTNode> ccfn parseAdditiveExpression();
-    std::unique_ptr<ASTNode> ccfn parseMultiplicativeExpression();
-    std::unique_ptr<ASTNode> ccfn parseUnaryExpression();
-    std::unique_ptr<ASTNode> ccfn parsePostfixExpression();
-    std::unique_ptr<ASTNode> ccfn parsePrimaryExpression();
+    ASTNode* ccfn parseExpression();
+    // 우선순위가 minPrecedence 이상인 이항 연산자만 묶는다 (Expr.cc 의 연산자 표 참고)
+    ASTNode* ccfn parseBinaryExpression(int minPrecedence);
+    ASTNode* ccfn parseUnaryExpression();
+    ASTNode* ccfn parsePostfixExpression();
+    ASTNode* ccfn parsePrimaryExpression();
     
 public:
-    inline Parser(const std::vector<Token>& toks) : tokens(toks), pos(0) {}
+    // tokens 는 끝까지 읽은 버퍼여야 하고 파서보다 오래 살아야 한다
+    inline Parser(const TokenBuffer& buffer) : tokens(&buffer) { refill(); }
+    inline Parser(Lexer& lex) : lexer(&lex) { refill(); }
+    // tokens 가 자기 stream 을 가리킬 수 있으므로 복사하지 않는다
+    Parser(const Parser&) = delete;
+    Parser& operator=(const Parser&) = delete;
     
+    // 문법 오류가 있어도 끝까지 읽는다. 오류가 난 문장은 ERROR_STATEMENT 로 남는다.
     std::unique_ptr<Program> ccfn parse();
-    std::unique_ptr<ASTNode> ccfn parseNamespaceDeclaration();    
-    std::unique_ptr<ASTNode> ccfn parseImportStatement();
-    std::unique_ptr<ASTNode> ccfn parseFunctionDeclaration();
-    std::unique_ptr<ASTNode> ccfn parseVariableDeclaration();
-    std::unique_ptr<ASTNode> ccfn parseStatement();
-    std::unique_ptr<ASTNode> ccfn parseBlockStatement();
-    std::unique_ptr<ASTNode> ccfn parseIfStatement();
-    std::unique_ptr<ASTNode> ccfn parseWhileStatement();
+    inline size_t tokensConsumed() const { return head; }
+    inline const std::vector<Diagnostic>& diagnostics() const { return errors; }
+    inline bool hasErrors() const { return !errors.empty(); }
+    ASTNode* ccfn parseNamespaceDeclaration();    
+    ASTNode* ccfn parseImportStatement();
+    ASTNode* ccfn parseFunctionDeclaration();
+    ASTNode* ccfn parseVariableDeclaration();
+    ASTNode* ccfn parseStatement();
+    ASTNode* ccfn parseBlockStatement();
+    ASTNode* ccfn parseIfStatement();
+    ASTNode* ccfn parseWhileStatement();
 
 
-    std::unique_ptr<ASTNode> ccfn parseReturnStatement();
+    ASTNode* ccfn parseReturnStatement();
 
     
-    std::unique_ptr<ASTNode> ccfn parseExpressionStatement();
+    ASTNode* ccfn parseExpressionStatement();
 
     
+    // 자료형 토큰이 가리키는 타입 이름 (식별자면 렉서가 인턴한 이름)
+    Name ccfn typeName(TokenRef tok) const;
+    // 자료형 하나를 읽는다 (기본형, 클래스 이름, 그리고 뒤따르는 [])
+    Name ccfn parseTypeName();
+
     bool isDataType(TokenType type) {
         return type == TokenType::INT || type == TokenType::FLOAT ||
                type == TokenType::CHAR || type == TokenType::BYTE ||
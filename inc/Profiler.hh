@@ -0,0 +1,86 @@
+#ifndef Profiler_hh
+#define Profiler_hh
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define ccfn
+
+// ===== 단계별 계측 (--time-report / --time-trace) =====
+// ProfileScope 를 단계 앞에 두면 벽시계 시간, 스레드 CPU 시간, 최대 RSS 증가량과
+// 단계가 보고한 카운터(토큰, 노드, 심볼)가 기록된다.
+//
+// 비용: ZUST_PROFILING 없이 빌드하면 매크로가 아무것도 남기지 않는다.
+// 켜고 빌드해도 Profiler 가 설치되지 않았으면 포인터 하나만 읽고 끝난다.
+class Profiler {
+public:
+    enum Counter { TOKENS, NODES, SYMBOLS, COUNTER_COUNT };
+
+    struct Event {
+        const char* name;
+        std::string detail;          // 파일 이름 등
+        uint64_t startNs = 0;        // 프로파일러 시작 기준
+        uint64_t wallNs = 0;
+        uint64_t cpuNs = 0;
+        int64_t rssDeltaKb = 0;
+        uint32_t thread = 0;
+        int64_t counters[COUNTER_COUNT] = {-1, -1, -1};
+    };
+
+private:
+    mutable std::mutex mutex;
+    std::vector<Event> events;
+    uint64_t origin;
+
+public:
+    Profiler();
+
+    // 설치된 프로파일러. 없으면 nullptr 이고 계측은 아무 일도 하지 않는다.
+    static Profiler* active();
+    static void install(Profiler* profiler);
+
+    static uint64_t ccfn nowNs();
+    static uint64_t ccfn threadCpuNs();
+    static int64_t ccfn peakRssKb();
+    static uint32_t ccfn threadIndex();
+
+    inline uint64_t sinceOrigin(uint64_t ns) const { return ns - origin; }
+    void ccfn record(Event event);
+
+    // 단계 이름별로 합친 표
+    std::string ccfn table() const;
+    // Chrome trace-event JSON (chrome://tracing, Perfetto)
+    std::string ccfn chromeTrace() const;
+};
+
+class ProfileScope {
+private:
+    Profiler* profiler;
+    Profiler::Event event;
+    uint64_t cpuStart = 0;
+    int64_t rssStart = 0;
+
+public:
+    explicit ProfileScope(const char* name, std::string_view detail = {});
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+    inline void count(Profiler::Counter which, int64_t value) {
+        if (profiler) event.counters[which] = value;
+    }
+};
+
+#ifdef ZUST_PROFILING
+#define ZUST_PROFILE_SCOPE(var, ...) ProfileScope var(__VA_ARGS__)
+#define ZUST_PROFILE_COUNT(var, which, value) var.count(Profiler::which, static_cast<int64_t>(value))
+#else
+#define ZUST_PROFILE_SCOPE(var, ...) ((void)0)
+#define ZUST_PROFILE_COUNT(var, which, value) ((void)0)
+#endif
+
+#endif
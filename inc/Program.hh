@@ -2,12 +2,18 @@
 #define Program_hh
 
 #include "./ASTNode.hh"
-#include <vector>
+#include "./AstArena.hh"
 #include <memory>
+#include <vector>
+
+struct ModuleInterface;
 
 struct Program : ASTNode {
-    std::vector<std::unique_ptr<ASTNode>> statements;
+    AstArena arena;   // 이 프로그램의 모든 노드를 소유한다
+    NodeList<ASTNode*> statements;
+    // import 문이 가리키는 모듈 인터페이스. 노드는 포인터만 들고 있으므로 여기서 소유한다.
+    std::vector<std::shared_ptr<const ModuleInterface>> modules;
     inline Program() : ASTNode(NodeType::PROGRAM) {  }
 };
 
-#endif
\ No newline at end of file
+#endif
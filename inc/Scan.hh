@@ -0,0 +1,29 @@
+#ifndef Scan_hh
+#define Scan_hh
+
+#include <cstddef>
+
+// ===== 바이트 스캐너 =====
+// 렉서의 핫 루프(공백, 주석, 문자열)를 16/32 바이트 단위로 훑는 함수들.
+// x86 에서는 실행 시점에 AVX2/SSE2 구현을 고르고, 그 외에는 스칼라로 동작한다.
+// 모든 함수는 [p, end) 범위만 읽고, 찾지 못하면 end 를 돌려준다.
+namespace scan {
+
+// 개행을 제외한 공백(' ', '\t', '\r', '\v', '\f')이 아닌 첫 바이트
+const char* skipBlanks(const char* p, const char* end);
+
+// 첫 '\n'
+const char* findNewline(const char* p, const char* end);
+
+// 첫 '"' 또는 '\\'
+const char* findQuoteOrBackslash(const char* p, const char* end);
+
+// 범위 안의 '\n' 개수
+size_t countNewlines(const char* p, const char* end);
+
+// 현재 선택된 구현 이름 ("avx2", "sse2", "scalar")
+const char* implementation();
+
+}
+
+#endif
@@ -1,23 +1,70 @@
 #ifndef SemanticAnalyser_hh
 #define SemanticAnalyser_hh
 
+#include "./AstVisitor.hh"
 #include "./Symbol.hh"
+#include "./Type.hh"
+#include "./NodeType.hh"
+#include <vector>
 
 
 class Program;
-class ASTNode;
+class Optimizer;
 
 #define ccfn
 
 // ===== 의미 분석기 =====
-class SemanticAnalyser {
+// 노드 종류마다 visit 하나가 타입을 검사하고 식의 타입을 돌려준다 (문장은 Void).
+// folder 가 있으면 식의 타입을 정한 직후 그 노드를 접는다. 자식은 그 전에 분석되고
+// 접히므로 분석과 상수 접기가 한 번의 후위 순회로 끝난다.
+class SemanticAnalyser : public AstVisitor<SemanticAnalyser, const Type*> {
 private:
+    friend class AstVisitor<SemanticAnalyser, const Type*>;
+
     SymbolTable symbolTable;
-    std::string ccfn analyzeExpression(ASTNode* node);
-    void ccfn analyzeStatement(ASTNode* node);
+    Optimizer* folder = nullptr;
+    Node<NodeType::FUNCTION_DECLARATION>* currentFunction = nullptr;
+    const Type* currentReturnType = nullptr;
+    std::vector<const Type*> paramScratch;
+
+    const Type* ccfn resolveType(Name spelling);
+    // 식의 타입을 검사하고 노드의 valueType 에 기록한다
+    const Type* ccfn typeOf(ASTNode* node);
+    // typeOf 다음에 folder 로 접어서 node 자리를 바꾼다
+    const Type* ccfn analyzeExpression(ASTNode*& node);
+    inline void analyzeStatement(ASTNode* node) {
+        if (node) dispatch(node);
+    }
+
+    using AstVisitor::visit;
+    const Type* ccfn visit(Node<NodeType::INTEGER_LITERAL>* node);
+    const Type* ccfn visit(Node<NodeType::FLOAT_LITERAL>* node);
+    const Type* ccfn visit(Node<NodeType::STRING_LITERAL>* node);
+    const Type* ccfn visit(Node<NodeType::BOOL_LITERAL>* node);
+    const Type* ccfn visit(Node<NodeType::IDENTIFIER>* id);
+    const Type* ccfn visit(Node<NodeType::BINARY_EXPRESSION>* binary);
+    const Type* ccfn visit(Node<NodeType::UNARY_EXPRESSION>* unary);
+    const Type* ccfn visit(Node<NodeType::ASSIGNMENT_EXPRESSION>* assignment);
+    const Type* ccfn visit(Node<NodeType::CALL_EXPRESSION>* call);
+    const Type* ccfn visit(Node<NodeType::VARIABLE_DECLARATION>* var);
+    const Type* ccfn visit(Node<NodeType::FUNCTION_DECLARATION>* func);
+    const Type* ccfn visit(Node<NodeType::BLOCK_STATEMENT>* block);
+    const Type* ccfn visit(Node<NodeType::IF_STATEMENT>* ifStmt);
+    const Type* ccfn visit(Node<NodeType::WHILE_STATEMENT>* whileStmt);
+    const Type* ccfn visit(Node<NodeType::RETURN_STATEMENT>* returnStmt);
+    const Type* ccfn visit(Node<NodeType::EXPRESSION_STATEMENT>* exprStmt);
+    const Type* ccfn visit(Node<NodeType::NAMESPACE_DECLARATION>* ns);
+    const Type* ccfn visit(Node<NodeType::IMPORT_STATEMENT>* importStmt);
+    inline const Type* visitOther(ASTNode*) { return &types::Void; }
 
 public:
+    // folder 는 분석하는 프로그램의 아레나에 노드를 만들어야 한다
+    inline explicit SemanticAnalyser(Optimizer* fold = nullptr) : folder(fold) {}
+
     void ccfn analyze(Program* program);
+    // 최상위 문장 하나를 분석한다. 앞 문장들의 선언을 본다. (runFused 의 패스)
+    inline void declaration(ASTNode* stmt) { analyzeStatement(stmt); }
+    inline size_t declaredSymbols() const { return symbolTable.declaredCount(); }
 };
 
-#endif
\ No newline at end of file
+#endif
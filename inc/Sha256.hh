@@ -0,0 +1,32 @@
+#ifndef Sha256_hh
+#define Sha256_hh
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#define ccfn
+
+// ===== SHA-256 =====
+// 캐시 키를 만들기 위한 작은 구현. update 를 여러 번 불러 이어서 해시할 수 있다.
+class Sha256 {
+private:
+    std::array<uint32_t, 8> state;
+    std::array<uint8_t, 64> block;
+    size_t blockSize = 0;
+    uint64_t totalBytes = 0;
+
+    void ccfn compress(const uint8_t* chunk);
+
+public:
+    Sha256();
+
+    void ccfn update(std::string_view data);
+    // 길이 접두사를 붙여서 넣는다. 필드 경계가 섞이지 않게 할 때 쓴다.
+    void ccfn field(std::string_view data);
+    std::array<uint8_t, 32> ccfn digest();
+    std::string ccfn hexDigest();
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef SourceBuffer_hh
+#define SourceBuffer_hh
+
+#include <string>
+#include <string_view>
+
+// ===== 소스 버퍼 =====
+// 렉서가 읽는 원문. 문자열을 소유하거나, 파일을 메모리 매핑해서 들고 있다.
+// 매핑된 파일은 힙에 복사되지 않으므로 큰 입력도 필요한 페이지만 올라온다.
+class SourceBuffer {
+private:
+    std::string owned;
+    void* mapping = nullptr;
+    size_t mappingSize = 0;
+    std::string_view text;
+
+    void release();
+
+public:
+    SourceBuffer() = default;
+    explicit SourceBuffer(std::string src);
+    ~SourceBuffer();
+
+    SourceBuffer(SourceBuffer&& other) noexcept;
+    SourceBuffer& operator=(SourceBuffer&& other) noexcept;
+    SourceBuffer(const SourceBuffer&) = delete;
+    SourceBuffer& operator=(const SourceBuffer&) = delete;
+
+    // 파일을 읽기 전용으로 매핑한다 (매핑을 지원하지 않는 환경에서는 읽어 들인다)
+    static SourceBuffer map(const std::string& path);
+
+    inline std::string_view view() const { return text; }
+    inline bool isMapped() const { return mapping != nullptr; }
+};
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef StringArena_hh
+#define StringArena_hh
+
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// ===== 문자열 아레나 =====
+// 이스케이프가 풀린 문자열 리터럴처럼 소스 버퍼에 그대로 존재하지 않는
+// 문자열을 담는 저장소. 청크 단위로만 할당하고 개별 해제는 하지 않는다.
+// 반환된 string_view 는 아레나가 살아 있는 동안 유효하다.
+class StringArena {
+private:
+    static constexpr size_t ChunkSize = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> chunks;
+    char* cursor = nullptr;
+    size_t remaining = 0;
+
+public:
+    StringArena() = default;
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+    inline char* allocate(size_t n) {
+        if (n > remaining) {
+            size_t size = n > ChunkSize ? n : ChunkSize;
+            chunks.emplace_back(new char[size]);
+            cursor = chunks.back().get();
+            remaining = size;
+        }
+        char* p = cursor;
+        cursor += n;
+        remaining -= n;
+        return p;
+    }
+
+    inline std::string_view store(std::string_view s) {
+        char* p = allocate(s.size());
+        if (!s.empty()) std::memcpy(p, s.data(), s.size());
+        return std::string_view(p, s.size());
+    }
+};
+
+#endif
@@ -1,68 +1,124 @@
 #ifndef Symbol_h
 #define Symbol_h
 
+#include "./Interner.hh"
+#include "./Type.hh"
+#include <cstdint>
 #include <string>
-#include <unordered_map>
 #include <vector>
 #include <stdexcept>
 
 // ===== 심볼 테이블 및 타입 검사 =====
+struct TypeSpan {
+    const Type* const* items = nullptr;
+    uint32_t count = 0;
+
+    inline size_t size() const { return count; }
+    inline const Type* operator[](size_t i) const { return items[i]; }
+    inline const Type* const* begin() const { return items; }
+    inline const Type* const* end() const { return items + count; }
+};
+
 struct Symbol {
-    std::string name;
-    std::string type;
+    Name name;
+    const Type* type;
     bool isFunction;
-    std::vector<std::string> paramTypes;
+    uint32_t depth;        // 선언된 스코프 깊이
+    uint32_t shadowed;     // 같은 이름으로 가려진 바깥 심볼 (없으면 SymbolTable::None)
+    uint32_t paramBegin;   // SymbolTable 의 매개변수 풀에서의 위치
+    uint32_t paramCount;
 
-    inline Symbol() : name(""), type(""), isFunction(0), paramTypes() {}
-    inline Symbol(const std::string& n, const std::string& t, bool func = false) 
-        : name(n), type(t), isFunction(func) {}
+    inline Symbol(Name n, const Type* t, bool func = false) 
+        : name(n), type(t), isFunction(func), depth(0), shadowed(0), paramBegin(0), paramCount(0) {}
 };
 
+// 하나의 평평한 개방 주소 해시(이름 -> 가장 안쪽 심볼)와 선언 순서 로그로 이루어진다.
+// 같은 이름의 바깥 심볼은 shadowed 체인으로 이어져 있고,
+// popScope 는 그 스코프에서 선언된 심볼만 로그에서 되돌린다.
 class SymbolTable {
+public:
+    static constexpr uint32_t None = UINT32_MAX;
+
 private:
-    std::vector<std::unordered_map<std::string, Symbol>> scopes;
+    struct Slot {
+        uint32_t key = 0;      // Name::id + 1 (0 은 빈 칸)
+        uint32_t head = None;  // 가장 안쪽 심볼
+    };
+
+    struct ScopeMark {
+        uint32_t symbols;
+        uint32_t params;
+    };
+
+    std::vector<Slot> slots;
+    uint32_t used = 0;
+    std::vector<Symbol> symbols;       // 선언 순서 = 되돌리기 로그
+    std::vector<const Type*> params;
+    std::vector<ScopeMark> scopes;
+    size_t declaredTotal = 0;
+
+    inline Slot& slotFor(Name name) {
+        uint32_t mask = static_cast<uint32_t>(slots.size() - 1);
+        uint32_t i = static_cast<uint32_t>(name.id * 0x9E3779B1u) & mask;
+        while (slots[i].key != 0 && slots[i].key != name.id + 1) {
+            i = (i + 1) & mask;
+        }
+        return slots[i];
+    }
+
+    inline const Slot* findSlot(Name name) const {
+        uint32_t mask = static_cast<uint32_t>(slots.size() - 1);
+        uint32_t i = static_cast<uint32_t>(name.id * 0x9E3779B1u) & mask;
+        while (slots[i].key != 0) {
+            if (slots[i].key == name.id + 1) return &slots[i];
+            i = (i + 1) & mask;
+        }
+        return nullptr;
+    }
+
+    void grow();
+    Symbol& insert(Symbol symbol);
     
 public:
-    inline SymbolTable() {
+    inline SymbolTable() : slots(64) {
         pushScope(); // 전역 스코프
     }
     
     inline void pushScope() {
-        scopes.emplace_back();
+        scopes.push_back(ScopeMark{static_cast<uint32_t>(symbols.size()), static_cast<uint32_t>(params.size())});
     }
     
-    inline void popScope() {
-        if (scopes.size() > 1) {
-            scopes.pop_back();
-        }
-    }
+    void popScope();
     
-    inline void declare(const Symbol& symbol) {
-        if (scopes.back().find(symbol.name) != scopes.back().end()) {
-            throw std::runtime_error("Variable '" + symbol.name + "' already declared in this scope");
-        }
-        scopes.back()[symbol.name] = symbol;
+    inline void declare(Name name, const Type* type) {
+        insert(Symbol(name, type));
+    }
+
+    inline void declareFunction(Name name, const Type* returnType, TypeSpan paramTypes) {
+        Symbol symbol(name, returnType, true);
+        symbol.paramBegin = static_cast<uint32_t>(params.size());
+        symbol.paramCount = paramTypes.count;
+        params.insert(params.end(), paramTypes.begin(), paramTypes.end());
+        insert(symbol);
     }
     
-    inline Symbol* lookup(const std::string& name) {
-        for (auto it = scopes.rbegin(); it != scopes.rend(); ++it) {
-            auto found = it->find(name);
-            if (found != it->end()) {
-                return &found->second;
-            }
-        }
-        return nullptr;
+    // 반환된 포인터는 다음 declare 전까지 유효하다
+    inline Symbol* lookup(Name name) {
+        const Slot* slot = findSlot(name);
+        return (slot && slot->head != None) ? &symbols[slot->head] : nullptr;
     }
 
-    const inline Symbol* lookup(const std::string& name) const {
-        for (auto it = scopes.rbegin(); it != scopes.rend(); ++it) {
-            auto found = it->find(name);
-            if (found != it->end()) {
-                return &found->second;
-            }
-        }
-        return nullptr;
+    const inline Symbol* lookup(Name name) const {
+        const Slot* slot = findSlot(name);
+        return (slot && slot->head != None) ? &symbols[slot->head] : nullptr;
     }
+
+    inline TypeSpan paramTypes(const Symbol& symbol) const {
+        return TypeSpan{params.data() + symbol.paramBegin, symbol.paramCount};
+    }
+
+    inline size_t depth() const { return scopes.size(); }
+    inline size_t declaredCount() const { return declaredTotal; }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,62 @@
+#ifndef ThreadPool_hh
+#define ThreadPool_hh
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define ccfn
+
+// ===== 작업 훔치기 스레드 풀 =====
+// 작업자마다 자기 큐를 가진다. 자기 큐는 뒤에서 꺼내고(LIFO), 비었으면
+// 다른 작업자의 큐 앞에서 훔쳐 온다(FIFO). 작업 안에서 submit 하면
+// 그 작업자의 큐에 들어가므로 일이 자연스럽게 나뉜다.
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+
+    std::mutex sleepMutex;
+    std::condition_variable wake;      // 새 작업이 들어왔다
+    std::condition_variable idle;      // 모든 작업이 끝났다
+    std::atomic<int64_t> queued{0};    // 큐에 들어 있는 작업 수
+    std::atomic<size_t> pending{0};    // 아직 끝나지 않은 작업 수
+    std::atomic<size_t> nextQueue{0};
+    bool stopping = false;
+    std::exception_ptr failure;
+
+    bool ccfn pop(size_t self, Task& task);
+    bool ccfn steal(size_t self, Task& task);
+    void ccfn work(size_t self);
+
+public:
+    // threads 가 0 이면 하드웨어 스레드 수만큼 만든다
+    explicit ThreadPool(size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void ccfn submit(Task task);
+    // 제출된 작업이 모두 끝날 때까지 기다린다. 작업이 던진 첫 예외를 다시 던진다.
+    void ccfn wait();
+
+    inline size_t size() const { return threads.size(); }
+};
+
+#endif
@@ -2,16 +2,24 @@
 #define Token_hh
 
 #include "./TokenType.hh"
-#include <string>
+#include "./Interner.hh"
+#include <string_view>
 
+// 토큰 값은 복사하지 않고 렉서가 소유한 소스 버퍼(또는 문자열 아레나)를 가리킨다.
+// 따라서 토큰은 자신을 만든 Lexer 보다 오래 살 수 없다.
+// 식별자 토큰은 렉서가 인턴한 이름(name)도 함께 들고 있다.
 struct Token {
     TokenType type;
-    std::string value;
+    Name name;
+    std::string_view value;
     int line;
     int column;
     
-    inline Token(TokenType t, const std::string& v, int l, int c) 
+    inline Token() : type(TokenType::EOF_TOKEN), line(0), column(0) {}
+    inline Token(TokenType t, std::string_view v, int l, int c) 
         : type(t), value(v), line(l), column(c) {}
+    inline Token(TokenType t, Name n, std::string_view v, int l, int c) 
+        : type(t), name(n), value(v), line(l), column(c) {}
 };
 
-#endif
\ No newline at end of file
+#endif
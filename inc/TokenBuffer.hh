@@ -0,0 +1,86 @@
+#ifndef TokenBuffer_hh
+#define TokenBuffer_hh
+
+#include "./Token.hh"
+#include "./Lexer.hh"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#define ccfn
+
+// 소스 안의 위치 (줄과 열은 1부터 센다)
+struct SourceLocation {
+    int line;
+    int column;
+};
+
+class TokenBuffer;
+
+// 버퍼 안의 토큰 하나. 종류만 들고 있고 나머지는 필요할 때 버퍼에서 읽는다.
+// 버퍼가 다시 채워지면(refill) 무효가 된다.
+struct TokenRef {
+    TokenType type;
+    const TokenBuffer* buffer;
+    size_t index;
+
+    inline Name name() const;
+    inline std::string_view value() const;
+};
+
+// ===== 토큰 버퍼 =====
+// 토큰을 필드별 배열로 나눠 담는다 (struct of arrays). 파서가 가장 자주 보는 것은 종류뿐이라
+// 종류만 1바이트 배열에 모아서 캐시 줄 하나에 토큰 64개가 들어가게 한다.
+// 줄/열은 들고 있지 않고 소스 위치만 둔다. 진단을 낼 때 줄 시작 표를 한 번 만들어서 찾는다.
+//
+// 마지막 토큰(EOF_TOKEN) 뒤에는 EOF 를 Padding 개 더 채워 두므로, 읽는 쪽은
+// 토큰 i 에서 i + Padding 까지 범위를 확인하지 않고 볼 수 있다.
+// 렉서를 한 번에 끝까지 읽거나(생성자), 파서처럼 Chunk 개씩 당겨 올 수 있다(refill).
+class TokenBuffer {
+public:
+    static constexpr size_t Padding = 4;
+    static constexpr size_t Chunk = 1024;
+
+private:
+    std::vector<uint8_t> types;
+    std::vector<uint32_t> offsets;          // 토큰이 시작하는 소스 위치
+    std::vector<Name> names;                // 식별자가 아니면 빈 이름
+    std::vector<std::string_view> values;
+    size_t count = 0;                       // 패딩을 뺀 토큰 수
+    size_t first = 0;                       // 버퍼의 첫 토큰이 전체에서 몇 번째인지
+    bool complete = false;                  // EOF_TOKEN 까지 담았다
+    std::string_view source;
+    mutable std::vector<uint32_t> lineStarts;   // location 이 처음 불릴 때 만든다
+
+    // count 자리에 쓴다. 배열이 모자라면 두 배로 늘린다.
+    void ccfn push(const Token& tok, size_t offset);
+    // 렉서에서 limit 개가 될 때까지 (또는 EOF 까지) 읽는다
+    void ccfn lex(Lexer& lexer, size_t limit);
+
+public:
+    TokenBuffer() = default;
+    // 렉서를 끝까지 읽는다. 토큰 값이 렉서를 가리키므로 렉서보다 오래 살 수 없다.
+    explicit TokenBuffer(Lexer& lexer);
+
+    // [keep, size()) 를 앞으로 옮기고 나머지를 렉서에서 새로 채운다
+    void ccfn refill(Lexer& lexer, size_t keep);
+
+    inline size_t size() const { return count; }
+    inline bool finished() const { return complete; }
+    inline size_t base() const { return first; }
+    inline const uint8_t* typeData() const { return types.data(); }
+
+    inline TokenType type(size_t i) const { return static_cast<TokenType>(types[i]); }
+    inline Name name(size_t i) const { return names[i]; }
+    inline std::string_view value(size_t i) const { return values[i]; }
+    inline size_t offset(size_t i) const { return offsets[i]; }
+    inline TokenRef at(size_t i) const { return TokenRef{type(i), this, i}; }
+
+    SourceLocation ccfn location(size_t i) const;
+};
+
+inline Name TokenRef::name() const { return buffer->name(index); }
+inline std::string_view TokenRef::value() const { return buffer->value(index); }
+
+#endif
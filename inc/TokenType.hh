@@ -7,8 +7,11 @@ typedef enum class TokenType {
     NIL, COMMENT = NIL, NEWLINE, EOF_TOKEN, UNKNOWN,
 
     // 키워드
-    LET, FN, IF, WHILE, FOR, FOREACH, SWITCH, CASE, DEFAULT,
+    LET, FN, IF, ELSE, WHILE, FOR, FOREACH, SWITCH, CASE, DEFAULT,
     NAMESPACE, IMPORT, RETURN, BREAK, CONTINUE,
+    CLASS, STRUCT, ENUM, EXTENDS, NEW, THIS,
+    TRY, CATCH, THROW, CONST, STATIC,
+    PUBLIC, PRIVATE, PROTECTED,
     
     // 자료형
     INT, FLOAT, CHAR, BYTE, LONG, DOUBLE, SHORT, BOOL,
@@ -19,6 +22,8 @@ typedef enum class TokenType {
     ASSIGN, EQUAL, NOT_EQUAL, LESS, GREATER, LESS_EQUAL, GREATER_EQUAL,
     LOGICAL_AND, LOGICAL_OR, LOGICAL_NOT,
     BIT_AND, BIT_OR, BIT_XOR, BIT_NOT, LEFT_SHIFT, RIGHT_SHIFT,
+    PLUS_ASSIGN, MINUS_ASSIGN, MULTIPLY_ASSIGN, DIVIDE_ASSIGN, MODULO_ASSIGN,
+    AND_ASSIGN, OR_ASSIGN, XOR_ASSIGN, LEFT_SHIFT_ASSIGN, RIGHT_SHIFT_ASSIGN,
     
     // 구분자
     COLUMN, SEMICOLON, COMMA, DOT,
@@ -0,0 +1,94 @@
+#ifndef Type_hh
+#define Type_hh
+
+#include "./Interner.hh"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+// ===== 타입 =====
+// 모든 타입 객체는 정규화(hash-consing)되어 있어서 같은 타입은 같은 포인터다.
+// 따라서 타입 비교는 포인터 비교로 끝난다.
+struct Type {
+    enum Kind : uint8_t {
+        AUTO,       // 아직 추론되지 않은 타입 (선언 없는 반환 타입 등)
+        VOID, BOOL,
+        BYTE, CHAR, SHORT, INT, LONG,
+        FLOAT, DOUBLE,
+        STRING,
+        ARRAY,      // element[]
+        NAMED,      // class / struct 이름
+    };
+
+    Kind kind;
+    Name name;              // 정규 철자 ("int", "int[]", "Point")
+    const Type* element;    // ARRAY 의 원소 타입
+
+    constexpr Type(Kind k, Name n, const Type* e = nullptr) : kind(k), name(n), element(e) {}
+
+    constexpr bool isIntegral() const { return kind >= BYTE && kind <= LONG; }
+    constexpr bool isFloating() const { return kind == FLOAT || kind == DOUBLE; }
+    constexpr bool isNumeric() const { return kind >= BYTE && kind <= DOUBLE; }
+    constexpr bool isAuto() const { return kind == AUTO; }
+};
+
+namespace types {
+
+inline constexpr Type Auto{Type::AUTO, names::Auto};
+inline constexpr Type Void{Type::VOID, names::Void};
+inline constexpr Type Bool{Type::BOOL, names::Bool};
+inline constexpr Type Byte{Type::BYTE, names::Byte};
+inline constexpr Type Char{Type::CHAR, names::Char};
+inline constexpr Type Short{Type::SHORT, names::Short};
+inline constexpr Type Int{Type::INT, names::Int};
+inline constexpr Type Long{Type::LONG, names::Long};
+inline constexpr Type Float{Type::FLOAT, names::Float};
+inline constexpr Type Double{Type::DOUBLE, names::Double};
+inline constexpr Type String{Type::STRING, names::String};
+
+// 산술 연산의 결과 타입 (정수는 최소 int 로 승격, 실수가 섞이면 넓은 실수 쪽)
+inline const Type* promote(const Type* a, const Type* b) {
+    if (a->kind == Type::DOUBLE || b->kind == Type::DOUBLE) return &Double;
+    if (a->kind == Type::FLOAT || b->kind == Type::FLOAT) return &Float;
+    if (a->kind == Type::LONG || b->kind == Type::LONG) return &Long;
+    return &Int;
+}
+
+// from 값을 to 자리에 암시적으로 넣을 수 있는가 (같은 타입이거나 손실 없는 숫자 확장)
+inline bool isAssignable(const Type* to, const Type* from) {
+    if (to == from || to->isAuto() || from->isAuto()) return true;
+    if (!to->isNumeric() || !from->isNumeric()) return false;
+    if (to->isFloating()) return from->isIntegral() || to->kind >= from->kind;
+    return from->isIntegral() && to->kind >= from->kind;
+}
+
+}
+
+// ===== 타입 테이블 =====
+// 배열 타입과 이름 붙은 타입을 정규화해서 보관한다. 스레드 안전하다.
+class TypeTable {
+private:
+    std::mutex mutex;
+    std::unordered_map<const Type*, std::unique_ptr<Type>> arrays;
+    std::unordered_map<Name, std::unique_ptr<Type>> namedTypes;
+    std::unordered_map<Name, const Type*> bySpelling;
+
+    TypeTable() = default;
+    const Type* arrayOfLocked(const Type* element);
+    const Type* namedLocked(Name name);
+
+public:
+    TypeTable(const TypeTable&) = delete;
+    TypeTable& operator=(const TypeTable&) = delete;
+
+    static TypeTable& global();
+
+    const Type* arrayOf(const Type* element);
+    const Type* named(Name name);
+
+    // 철자("int", "int[]", "Point")로 타입을 찾는다. 빈 이름은 nullptr.
+    const Type* fromName(Name spelling);
+};
+
+#endif
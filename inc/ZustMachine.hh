@@ -0,0 +1,54 @@
+#ifndef ZustMachine_hh
+#define ZustMachine_hh
+
+#include "./Bytecode.hh"
+#include "./CallDepth.hh"
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+// 레지스터 하나. 타입은 바이트코드가 이미 정해 두었으므로 태그가 없다.
+// bool 은 0/1 정수, 문자열은 머신이 소유한 std::string 을 가리킨다.
+union Value {
+    int64_t i;
+    double f;
+    const std::string* s;
+};
+
+#define ccfn
+
+// ===== Zust Machine =====
+// 모듈 하나를 실행하는 인터프리터. GCC/Clang 에서는 computed goto 로
+// 명령마다 직접 다음 핸들러로 뛰고, 그 외 컴파일러에서는 switch 로 돈다.
+class ZustMachine {
+private:
+    struct Frame {
+        const Function* function;
+        const Instruction* pc;
+        size_t base;         // 이 프레임의 r0 위치
+        uint16_t result;     // 호출한 쪽에서 반환값을 받을 레지스터
+    };
+
+    static constexpr size_t MaxFrames = MaxCallDepth;
+
+    const Module& module;
+    std::vector<std::string> strings;    // 상수 풀의 문자열
+    std::vector<Value> constants;
+    std::vector<Value> globals;
+    std::vector<Value> stack;
+    std::vector<Frame> frames;
+    std::deque<std::string> heap;        // 실행 중에 만들어진 문자열
+
+    Value ccfn execute(uint32_t function, const Value* args, size_t count);
+    const std::string* ccfn concat(const std::string* a, const std::string* b);
+
+public:
+    explicit ZustMachine(const Module& module);
+
+    // 초기화 함수를 실행한 뒤 main 을 호출해서 그 반환값을 돌려준다
+    Value ccfn run();
+    Value ccfn call(uint32_t function, const std::vector<Value>& args);
+};
+
+#endif
@@ -0,0 +1,571 @@
+#include <AstImage.hh>
+#include <ASTNode.hh>
+#include <Nodes.hh>
+#include <Program.hh>
+
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#undef ccfn
+#define ccfn AstImage::
+
+using NodeRef = AstImage::NodeRef;
+
+namespace {
+
+// 레코드 필드의 종류. 노드 필드는 가리킬 수 있는 노드의 종류까지 정한다.
+enum class Field : uint8_t {
+    EXPRESSION,     // 식 노드
+    STATEMENT,      // 문장 노드 (블록, 선언 포함)
+    BLOCK,          // BLOCK_STATEMENT
+    STATEMENTS,     // 문장 목록
+    ARGUMENTS,      // 식 목록
+    PARAMS, STRING, VALUE
+};
+
+struct Layout {
+    bool supported;
+    uint8_t count;
+    Field fields[4];
+    uint8_t optional;   // 0 (없음) 이어도 되는 필드의 비트
+};
+
+constexpr Field E = Field::EXPRESSION, T = Field::STATEMENT, B = Field::BLOCK, Ls = Field::STATEMENTS,
+                La = Field::ARGUMENTS, P = Field::PARAMS, S = Field::STRING, V = Field::VALUE;
+
+// NodeType 순서대로. aux 는 BINARY/UNARY/ASSIGNMENT 의 연산자, BOOL 의 값이다.
+// optional 에 없는 노드/목록 필드는 파서가 언제나 채우므로 0 이면 손상된 이미지다.
+constexpr Layout Layouts[] = {
+    {true, 1, {Ls}, 0},             // PROGRAM: statements
+    {true, 3, {S, S, E}, 1 << 2},   // VARIABLE_DECLARATION: dataType name initializer?
+    {true, 4, {S, S, P, B}, 1 << 3},// FUNCTION_DECLARATION: returnType name parameters body?
+    {true, 1, {Ls}, 0},             // BLOCK_STATEMENT: statements
+    {true, 3, {E, T, T}, 1 << 2},   // IF_STATEMENT: condition then else?
+    {true, 2, {E, T}, 0},           // WHILE_STATEMENT: condition body
+    {false, 0, {}, 0},              // FOR_STATEMENT
+    {true, 1, {E}, 1 << 0},         // RETURN_STATEMENT: expression?
+    {true, 1, {E}, 0},              // EXPRESSION_STATEMENT: expression
+    {true, 2, {E, E}, 0},           // BINARY_EXPRESSION: left right
+    {true, 1, {E}, 0},              // UNARY_EXPRESSION: operand
+    {true, 2, {E, La}, 0},          // CALL_EXPRESSION: callee arguments
+    {true, 1, {S}, 0},              // IDENTIFIER: name
+    {true, 1, {V}, 0},              // INTEGER_LITERAL: value
+    {true, 2, {V, V}, 0},           // FLOAT_LITERAL: 하위 32비트, 상위 32비트
+    {true, 1, {S}, 0},              // STRING_LITERAL: value
+    {false, 0, {}, 0},              // CHAR_LITERAL
+    {true, 0, {}, 0},               // BOOL_LITERAL
+    {true, 2, {E, E}, 0},           // ASSIGNMENT_EXPRESSION: left right
+    {true, 2, {S, B}, 0},           // NAMESPACE_DECLARATION: name body
+    {true, 1, {S}, 0},              // IMPORT_STATEMENT: module
+    {true, 2, {V, V}, 0},           // ERROR_STATEMENT: line column
+};
+constexpr size_t LayoutCount = sizeof(Layouts) / sizeof(Layouts[0]);
+static_assert(LayoutCount == static_cast<size_t>(NodeType::ERROR_STATEMENT) + 1, "Layouts must cover every NodeType");
+
+// 노드 필드가 이 태그의 노드를 가리켜도 되는가
+bool accepts(Field field, uint8_t tag) {
+    NodeType type = static_cast<NodeType>(tag);
+    bool expression = type >= NodeType::BINARY_EXPRESSION && type <= NodeType::ASSIGNMENT_EXPRESSION;
+    switch (field) {
+        case Field::EXPRESSION:
+        case Field::ARGUMENTS: return expression;
+        case Field::STATEMENT:
+        case Field::STATEMENTS: return !expression && type != NodeType::PROGRAM;
+        case Field::BLOCK: return type == NodeType::BLOCK_STATEMENT;
+        default: return false;
+    }
+}
+
+const char Magic[4] = {'Z', 'A', 'S', '\0'};
+constexpr uint32_t HeaderSize = 24;
+
+// 레코드 위치 표시 (verify 에서 위치 / 4 마다 하나)
+enum Mark : uint8_t { NONE, NODE_START, LIST_START, PARAMS_START };
+
+// 레코드의 u16 플래그
+constexpr uint8_t Shared = 1;     // 둘 이상의 부모가 가리킨다 (x += e 를 푼 x = x + e 의 x)
+
+class Writer {
+public:
+    std::string out;
+    std::unordered_map<const ASTNode*, uint32_t> written;
+    std::unordered_map<std::string_view, uint32_t> index;
+    std::vector<std::string_view> strings;
+    uint32_t nodes = 0;
+
+    Writer() : out(HeaderSize, '\0') {}
+
+    void put(uint32_t value) {
+        char bytes[4];
+        std::memcpy(bytes, &value, 4);
+        out.append(bytes, 4);
+    }
+
+    uint32_t string(std::string_view s) {
+        auto [it, added] = index.emplace(s, static_cast<uint32_t>(strings.size()));
+        if (added) strings.push_back(s);
+        return it->second;
+    }
+
+    // 레코드를 쓰고 그 위치를 돌려준다
+    uint32_t record(uint8_t tag, uint8_t aux, std::initializer_list<uint32_t> fields) {
+        if (out.size() > UINT32_MAX - 64) {
+            throw std::runtime_error("AST image is larger than 4 GiB");
+        }
+        uint32_t offset = static_cast<uint32_t>(out.size());
+        put(static_cast<uint32_t>(tag) | static_cast<uint32_t>(aux) << 8);
+        for (uint32_t field : fields) put(field);
+        return offset;
+    }
+
+    uint32_t list(const NodeList<ASTNode*>& items) {
+        std::vector<uint32_t> children;
+        children.reserve(items.size());
+        for (ASTNode* item : items) {
+            children.push_back(node(item));
+        }
+        uint32_t offset = record(AstImage::List, 0, {static_cast<uint32_t>(children.size())});
+        for (uint32_t child : children) put(child);
+        return offset;
+    }
+
+    uint32_t params(const NodeList<Parameter>& items) {
+        uint32_t offset = record(AstImage::Params, 0, {static_cast<uint32_t>(items.size())});
+        for (const Parameter& param : items) {
+            put(string(param.type.str()));
+            put(string(param.name.str()));
+        }
+        return offset;
+    }
+
+    uint32_t node(const ASTNode* node) {
+        if (!node) return 0;
+        // 같은 노드를 두 번 만나면 다시 쓰지 않고 처음 쓴 레코드를 가리킨다
+        auto found = written.find(node);
+        if (found != written.end()) {
+            out[found->second + 2] = static_cast<char>(Shared);
+            return found->second;
+        }
+        uint8_t tag = static_cast<uint8_t>(node->type);
+
+        uint32_t offset;
+        switch (node->type) {
+            case NodeType::VARIABLE_DECLARATION: {
+                auto var = static_cast<const Node<NodeType::VARIABLE_DECLARATION>*>(node);
+                uint32_t initializer = this->node(var->initializer);
+                offset = record(tag, 0, {string(var->dataType.str()), string(var->name.str()), initializer});
+                break;
+            }
+            case NodeType::FUNCTION_DECLARATION: {
+                auto func = static_cast<const Node<NodeType::FUNCTION_DECLARATION>*>(node);
+                uint32_t parameters = params(func->parameters);
+                uint32_t body = this->node(func->body);
+                offset = record(tag, 0, {string(func->returnType.str()), string(func->name.str()), parameters, body});
+                break;
+            }
+            case NodeType::BLOCK_STATEMENT: {
+                uint32_t statements = list(static_cast<const Node<NodeType::BLOCK_STATEMENT>*>(node)->statements);
+                offset = record(tag, 0, {statements});
+                break;
+            }
+            case NodeType::IF_STATEMENT: {
+                auto ifStmt = static_cast<const Node<NodeType::IF_STATEMENT>*>(node);
+                uint32_t condition = this->node(ifStmt->condition);
+                uint32_t thenStatement = this->node(ifStmt->thenStatement);
+                uint32_t elseStatement = this->node(ifStmt->elseStatement);
+                offset = record(tag, 0, {condition, thenStatement, elseStatement});
+                break;
+            }
+            case NodeType::WHILE_STATEMENT: {
+                auto whileStmt = static_cast<const Node<NodeType::WHILE_STATEMENT>*>(node);
+                uint32_t condition = this->node(whileStmt->condition);
+                uint32_t body = this->node(whileStmt->body);
+                offset = record(tag, 0, {condition, body});
+                break;
+            }
+            case NodeType::RETURN_STATEMENT: {
+                uint32_t expression = this->node(static_cast<const Node<NodeType::RETURN_STATEMENT>*>(node)->expression);
+                offset = record(tag, 0, {expression});
+                break;
+            }
+            case NodeType::EXPRESSION_STATEMENT: {
+                uint32_t expression = this->node(static_cast<const Node<NodeType::EXPRESSION_STATEMENT>*>(node)->expression);
+                offset = record(tag, 0, {expression});
+                break;
+            }
+            case NodeType::BINARY_EXPRESSION: {
+                auto binary = static_cast<const Node<NodeType::BINARY_EXPRESSION>*>(node);
+                uint32_t left = this->node(binary->left);
+                uint32_t right = this->node(binary->right);
+                offset = record(tag, static_cast<uint8_t>(binary->operator_), {left, right});
+                break;
+            }
+            case NodeType::UNARY_EXPRESSION: {
+                auto unary = static_cast<const Node<NodeType::UNARY_EXPRESSION>*>(node);
+                uint32_t operand = this->node(unary->operand);
+                offset = record(tag, static_cast<uint8_t>(unary->operator_), {operand});
+                break;
+            }
+            case NodeType::CALL_EXPRESSION: {
+                auto call = static_cast<const Node<NodeType::CALL_EXPRESSION>*>(node);
+                uint32_t callee = this->node(call->callee);
+                uint32_t arguments = list(call->arguments);
+                offset = record(tag, 0, {callee, arguments});
+                break;
+            }
+            case NodeType::IDENTIFIER:
+                offset = record(tag, 0, {string(static_cast<const Node<NodeType::IDENTIFIER>*>(node)->name.str())});
+                break;
+            case NodeType::INTEGER_LITERAL:
+                offset = record(tag, 0, {static_cast<uint32_t>(static_cast<const Node<NodeType::INTEGER_LITERAL>*>(node)->value)});
+                break;
+            case NodeType::FLOAT_LITERAL: {
+                uint64_t bits;
+                double value = static_cast<const Node<NodeType::FLOAT_LITERAL>*>(node)->value;
+                std::memcpy(&bits, &value, sizeof bits);
+                offset = record(tag, 0, {static_cast<uint32_t>(bits), static_cast<uint32_t>(bits >> 32)});
+                break;
+            }
+            case NodeType::STRING_LITERAL:
+                offset = record(tag, 0, {string(static_cast<const Node<NodeType::STRING_LITERAL>*>(node)->value)});
+                break;
+            case NodeType::BOOL_LITERAL:
+                offset = record(tag, static_cast<const Node<NodeType::BOOL_LITERAL>*>(node)->value ? 1 : 0, {});
+                break;
+            case NodeType::ASSIGNMENT_EXPRESSION: {
+                auto assignment = static_cast<const Node<NodeType::ASSIGNMENT_EXPRESSION>*>(node);
+                uint32_t left = this->node(assignment->left);
+                uint32_t right = this->node(assignment->right);
+                offset = record(tag, static_cast<uint8_t>(assignment->operator_), {left, right});
+                break;
+            }
+            case NodeType::NAMESPACE_DECLARATION: {
+                auto ns = static_cast<const Node<NodeType::NAMESPACE_DECLARATION>*>(node);
+                uint32_t body = this->node(ns->body);
+                offset = record(tag, 0, {string(ns->name.str()), body});
+                break;
+            }
+            case NodeType::IMPORT_STATEMENT:
+                offset = record(tag, 0, {string(static_cast<const Node<NodeType::IMPORT_STATEMENT>*>(node)->module.str())});
+                break;
+            case NodeType::ERROR_STATEMENT: {
+                auto error = static_cast<const Node<NodeType::ERROR_STATEMENT>*>(node);
+                offset = record(tag, 0, {static_cast<uint32_t>(error->line), static_cast<uint32_t>(error->column)});
+                break;
+            }
+            default:
+                throw std::runtime_error("AST node type " + std::to_string(tag) + " cannot be written to an AST image");
+        }
+        nodes++;
+        written.emplace(node, offset);
+        return offset;
+    }
+};
+
+// 매핑된 레코드에서 아레나 노드를 만든다
+class Materializer {
+private:
+    const AstImage& image;
+    Program& program;
+    std::vector<uint32_t> nameCache;      // 문자열 번호 -> Name.id, 아직 없으면 Unknown
+    std::unordered_map<uint32_t, ASTNode*> shared;  // Shared 레코드 위치 -> 만든 노드
+    std::vector<ASTNode*> scratch;
+    std::vector<Parameter> paramScratch;
+
+    static constexpr uint32_t Unknown = UINT32_MAX;
+
+    template<NodeType T, typename... Args>
+    inline Node<T>* make(Args&&... args) {
+        return program.arena.make<Node<T>>(std::forward<Args>(args)...);
+    }
+
+    Name name(const NodeRef& node, uint32_t i) {
+        uint32_t index = node.field(i);
+        if (nameCache[index] == Unknown) {
+            nameCache[index] = intern(image.string(index)).id;
+        }
+        return Name{nameCache[index]};
+    }
+
+    NodeList<ASTNode*> list(const AstImage::ListRef& items) {
+        size_t mark = scratch.size();
+        for (uint32_t i = 0; i < items.size(); ++i) {
+            ASTNode* item = build(items[i]);
+            scratch.push_back(item);
+        }
+        return program.arena.list(scratch, mark);
+    }
+
+public:
+    Materializer(const AstImage& i, Program& p, size_t strings)
+        : image(i), program(p), nameCache(strings, Unknown) {}
+
+    ASTNode* build(NodeRef node) {
+        if (!node) return nullptr;
+        if (!(node.flags() & Shared)) return create(node);
+
+        auto found = shared.find(node.position());
+        if (found != shared.end()) return found->second;
+        ASTNode* created = create(node);
+        shared.emplace(node.position(), created);
+        return created;
+    }
+
+    ASTNode* create(NodeRef node) {
+        switch (node.type()) {
+            case NodeType::VARIABLE_DECLARATION: {
+                auto var = make<NodeType::VARIABLE_DECLARATION>();
+                var->dataType = name(node, 0);
+                var->name = name(node, 1);
+                var->initializer = build(node.child(2));
+                return var;
+            }
+            case NodeType::FUNCTION_DECLARATION: {
+                auto func = make<NodeType::FUNCTION_DECLARATION>();
+                func->returnType = name(node, 0);
+                func->name = name(node, 1);
+                size_t mark = paramScratch.size();
+                for (uint32_t j = 0; j < node.paramCount(2); ++j) {
+                    paramScratch.push_back(Parameter{intern(node.paramType(2, j)), intern(node.paramName(2, j))});
+                }
+                func->parameters = program.arena.list(paramScratch, mark);
+                func->body = build(node.child(3));
+                return func;
+            }
+            case NodeType::BLOCK_STATEMENT: {
+                auto block = make<NodeType::BLOCK_STATEMENT>();
+                block->statements = list(node.list(0));
+                return block;
+            }
+            case NodeType::IF_STATEMENT: {
+                auto ifStmt = make<NodeType::IF_STATEMENT>();
+                ifStmt->condition = build(node.child(0));
+                ifStmt->thenStatement = build(node.child(1));
+                ifStmt->elseStatement = build(node.child(2));
+                return ifStmt;
+            }
+            case NodeType::WHILE_STATEMENT: {
+                auto whileStmt = make<NodeType::WHILE_STATEMENT>();
+                whileStmt->condition = build(node.child(0));
+                whileStmt->body = build(node.child(1));
+                return whileStmt;
+            }
+            case NodeType::RETURN_STATEMENT: {
+                auto returnStmt = make<NodeType::RETURN_STATEMENT>();
+                returnStmt->expression = build(node.child(0));
+                return returnStmt;
+            }
+            case NodeType::EXPRESSION_STATEMENT: {
+                auto exprStmt = make<NodeType::EXPRESSION_STATEMENT>();
+                exprStmt->expression = build(node.child(0));
+                return exprStmt;
+            }
+            case NodeType::BINARY_EXPRESSION: {
+                auto binary = make<NodeType::BINARY_EXPRESSION>();
+                binary->operator_ = static_cast<TokenType>(node.aux());
+                binary->left = build(node.child(0));
+                binary->right = build(node.child(1));
+                return binary;
+            }
+            case NodeType::UNARY_EXPRESSION: {
+                auto unary = make<NodeType::UNARY_EXPRESSION>();
+                unary->operator_ = static_cast<TokenType>(node.aux());
+                unary->operand = build(node.child(0));
+                return unary;
+            }
+            case NodeType::CALL_EXPRESSION: {
+                auto call = make<NodeType::CALL_EXPRESSION>();
+                call->callee = build(node.child(0));
+                call->arguments = list(node.list(1));
+                return call;
+            }
+            case NodeType::IDENTIFIER:
+                return make<NodeType::IDENTIFIER>(name(node, 0));
+            case NodeType::INTEGER_LITERAL:
+                return make<NodeType::INTEGER_LITERAL>(static_cast<int>(node.field(0)));
+            case NodeType::FLOAT_LITERAL: {
+                uint64_t bits = node.field(0) | static_cast<uint64_t>(node.field(1)) << 32;
+                double value;
+                std::memcpy(&value, &bits, sizeof value);
+                return make<NodeType::FLOAT_LITERAL>(value);
+            }
+            case NodeType::STRING_LITERAL:
+                return make<NodeType::STRING_LITERAL>(program.arena.intern(node.string(0)));
+            case NodeType::BOOL_LITERAL:
+                return make<NodeType::BOOL_LITERAL>(node.aux() != 0);
+            case NodeType::ASSIGNMENT_EXPRESSION: {
+                auto assignment = make<NodeType::ASSIGNMENT_EXPRESSION>();
+                assignment->operator_ = static_cast<TokenType>(node.aux());
+                assignment->left = build(node.child(0));
+                assignment->right = build(node.child(1));
+                return assignment;
+            }
+            case NodeType::NAMESPACE_DECLARATION: {
+                auto ns = make<NodeType::NAMESPACE_DECLARATION>();
+                ns->name = name(node, 0);
+                ns->body = build(node.child(1));
+                return ns;
+            }
+            case NodeType::IMPORT_STATEMENT: {
+                auto importStmt = make<NodeType::IMPORT_STATEMENT>();
+                importStmt->module = name(node, 0);
+                return importStmt;
+            }
+            case NodeType::ERROR_STATEMENT:
+                return make<NodeType::ERROR_STATEMENT>(static_cast<int>(node.field(0)), static_cast<int>(node.field(1)));
+            default:
+                throw std::runtime_error("Bad node type in AST image");
+        }
+    }
+
+    NodeList<ASTNode*> statements(NodeRef root) {
+        return list(root.list(0));
+    }
+};
+
+}
+
+// ===== 쓰기 =====
+
+std::string ccfn serialize(const Program* program) {
+    Writer w;
+    uint32_t statements = w.list(program->statements);
+    uint32_t root = w.record(static_cast<uint8_t>(NodeType::PROGRAM), 0, {statements});
+    w.nodes++;
+
+    uint32_t strings = static_cast<uint32_t>(w.out.size());
+    w.put(static_cast<uint32_t>(w.strings.size()));
+    uint32_t bytes = strings + 4 + 8 * static_cast<uint32_t>(w.strings.size());
+    for (std::string_view s : w.strings) {
+        w.put(bytes);
+        w.put(static_cast<uint32_t>(s.size()));
+        bytes += static_cast<uint32_t>(s.size());
+    }
+    for (std::string_view s : w.strings) {
+        w.out.append(s);
+    }
+
+    uint32_t header[5] = {Version, w.nodes, root, strings, static_cast<uint32_t>(w.out.size())};
+    std::memcpy(&w.out[0], Magic, 4);
+    std::memcpy(&w.out[4], header, sizeof header);
+    return std::move(w.out);
+}
+
+// ===== 읽기 =====
+
+bool ccfn isImage(std::string_view data) {
+    return data.size() >= 4 && data.substr(0, 4) == std::string_view(Magic, 4);
+}
+
+ccfn AstImage(SourceBuffer source) : buffer(std::move(source)), data(buffer.view()) {
+    verify();
+}
+
+void ccfn verify() {
+    auto fail = [](const char* why) {
+        throw std::runtime_error(std::string("Corrupt AST image: ") + why);
+    };
+
+    if (!isImage(data) || data.size() < HeaderSize) fail("bad header");
+    if (word(4) != Version) {
+        throw std::runtime_error("Unsupported AST image version");
+    }
+    nodes = word(8);
+    rootOffset = word(12);
+    stringTable = word(16);
+    if (word(20) != data.size() || data.size() > UINT32_MAX) fail("size mismatch");
+    if (stringTable < HeaderSize || stringTable % 4 != 0 || stringTable > data.size() - 4) fail("bad string table");
+
+    // 문자열 표
+    stringCount = word(stringTable);
+    if ((data.size() - stringTable - 4) / 8 < stringCount) fail("truncated string table");
+    for (uint32_t i = 0; i < stringCount; ++i) {
+        uint32_t entry = stringTable + 4 + 8 * i;
+        uint64_t begin = word(entry), length = word(entry + 4);
+        if (begin > data.size() || length > data.size() - begin) fail("string out of range");
+    }
+
+    // 레코드를 앞에서부터 훑는다. 위치는 모두 앞쪽 레코드의 시작이어야 한다.
+    std::vector<uint8_t> marks(stringTable / 4, NONE);
+    auto expect = [&](uint32_t target, uint32_t at, Mark mark) {
+        if (target == 0) return;
+        if (target >= at || target % 4 != 0 || marks[target / 4] != mark) fail("bad child offset");
+    };
+    uint32_t counted = 0;
+    uint32_t at = HeaderSize;
+    while (at < stringTable) {
+        uint8_t tag = byte(at);
+        auto need = [&](uint64_t words) {
+            if ((stringTable - at) / 4 < words) fail("truncated record");
+        };
+
+        if (tag == List || tag == Params) {
+            need(2);
+            uint64_t count = word(at + 4);
+            uint64_t width = tag == List ? 1 : 2;
+            need(2 + count * width);
+            for (uint64_t i = 0; i < count * width; ++i) {
+                uint32_t value = word(at + 8 + 4 * static_cast<uint32_t>(i));
+                if (tag == List) {
+                    if (value == 0) fail("empty list item");
+                    expect(value, at, NODE_START);
+                } else if (value >= stringCount) {
+                    fail("string index out of range");
+                }
+            }
+            marks[at / 4] = tag == List ? LIST_START : PARAMS_START;
+            at += 4 * static_cast<uint32_t>(2 + count * width);
+            continue;
+        }
+
+        if (tag >= LayoutCount || !Layouts[tag].supported) fail("bad node type");
+        const Layout& layout = Layouts[tag];
+        need(1 + layout.count);
+        for (uint32_t i = 0; i < layout.count; ++i) {
+            uint32_t value = word(at + 4 + 4 * i);
+            Field field = layout.fields[i];
+            if (field == Field::STRING) {
+                if (value >= stringCount) fail("string index out of range");
+                continue;
+            }
+            if (field == Field::VALUE) continue;
+            if (value == 0) {
+                if (!(layout.optional & 1 << i)) fail("missing required child");
+                continue;
+            }
+            switch (field) {
+                case Field::PARAMS:
+                    expect(value, at, PARAMS_START);
+                    break;
+                case Field::STATEMENTS:
+                case Field::ARGUMENTS:
+                    // 목록 항목은 목록을 훑을 때 레코드 시작인지 확인했다. 여기서는 종류만 본다.
+                    expect(value, at, LIST_START);
+                    for (uint32_t j = 0, count = word(value + 4); j < count; ++j) {
+                        if (!accepts(field, byte(word(value + 8 + 4 * j)))) fail("bad list item kind");
+                    }
+                    break;
+                default:
+                    expect(value, at, NODE_START);
+                    if (!accepts(field, byte(value))) fail("bad child kind");
+                    break;
+            }
+        }
+        marks[at / 4] = NODE_START;
+        counted++;
+        at += 4 * (1 + layout.count);
+    }
+
+    if (at != stringTable || counted != nodes) fail("record count mismatch");
+    if (rootOffset == 0) fail("no root");
+    expect(rootOffset, stringTable, NODE_START);
+    if (root().type() != NodeType::PROGRAM) fail("root is not a program");
+}
+
+std::unique_ptr<Program> ccfn materialize() const {
+    auto program = std::make_unique<Program>();
+    Materializer builder(*this, *program, stringCount);
+    program->statements = builder.statements(root());
+    return program;
+}
@@ -0,0 +1,54 @@
+#include <AtomicFile.hh>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+#if defined(_WIN32)
+#include <process.h>
+#define ZUST_GETPID _getpid
+#else
+#include <unistd.h>
+#define ZUST_GETPID ::getpid
+#endif
+
+namespace fs = std::filesystem;
+
+namespace atomic_file {
+
+bool write(const std::string& path, std::string_view data) {
+    static std::atomic<uint64_t> counter{0};
+
+    // 같은 파일을 여러 프로세스가 동시에 써도 서로의 임시 파일을 건드리지 않게 한다.
+    // 스레드 id 해시와 시계는 프로세스끼리 겹칠 수 있으므로 pid 를 앞에 둔다.
+    std::string temp = path + ".tmp." +
+        std::to_string(static_cast<long long>(ZUST_GETPID())) + "." +
+        std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + "." +
+        std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + "." +
+        std::to_string(counter.fetch_add(1));
+
+    std::error_code ec;
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+        out.close();
+        if (!out) {
+            fs::remove(temp, ec);
+            return false;
+        }
+    }
+
+    fs::rename(temp, path, ec);
+    if (ec) {
+        fs::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
+
+}
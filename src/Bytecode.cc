@@ -0,0 +1,271 @@
+#include <Bytecode.hh>
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+const char* opcodeName(Opcode op) {
+    static const char* const names[] = {
+#define ZUST_OPCODE_NAME(name) #name,
+        ZUST_OPCODES(ZUST_OPCODE_NAME)
+#undef ZUST_OPCODE_NAME
+    };
+    size_t i = static_cast<size_t>(op);
+    return i < static_cast<size_t>(Opcode::COUNT) ? names[i] : "???";
+}
+
+namespace {
+
+class Writer {
+public:
+    std::string out;
+
+    template<typename T>
+    void put(T value) {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        out.append(bytes, sizeof(T));
+    }
+
+    void putString(const std::string& s) {
+        put<uint32_t>(static_cast<uint32_t>(s.size()));
+        out.append(s);
+    }
+};
+
+class Reader {
+    std::string_view data;
+    size_t pos = 0;
+
+public:
+    explicit Reader(std::string_view d) : data(d) {}
+
+    void need(size_t n) {
+        if (data.size() - pos < n) {
+            throw std::runtime_error("Truncated bytecode module");
+        }
+    }
+
+    template<typename T>
+    T get() {
+        need(sizeof(T));
+        T value;
+        std::memcpy(&value, data.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    std::string getString() {
+        uint32_t n = get<uint32_t>();
+        need(n);
+        std::string s(data.substr(pos, n));
+        pos += n;
+        return s;
+    }
+
+    void getBytes(void* dst, size_t n) {
+        need(n);
+        std::memcpy(dst, data.data() + pos, n);
+        pos += n;
+    }
+};
+
+const char Magic[4] = {'Z', 'B', 'C', '\0'};
+
+}
+
+std::string Module::serialize() const {
+    Writer w;
+    w.out.append(Magic, 4);
+    w.put<uint32_t>(Version);
+
+    w.put<uint32_t>(static_cast<uint32_t>(constants.size()));
+    for (const auto& k : constants) {
+        w.put<uint8_t>(k.kind);
+        switch (k.kind) {
+            case Constant::INT: w.put<int64_t>(k.i); break;
+            case Constant::FLOAT: w.put<double>(k.f); break;
+            case Constant::STRING: w.putString(k.s); break;
+        }
+    }
+
+    w.put<uint32_t>(numGlobals);
+
+    w.put<uint32_t>(static_cast<uint32_t>(functions.size()));
+    for (const auto& fn : functions) {
+        w.putString(fn.name);
+        w.put<uint16_t>(fn.numParams);
+        w.put<uint16_t>(fn.numRegisters);
+        w.put<uint32_t>(static_cast<uint32_t>(fn.code.size()));
+        w.out.append(reinterpret_cast<const char*>(fn.code.data()), fn.code.size() * sizeof(Instruction));
+    }
+
+    w.put<uint32_t>(initFunction);
+    w.put<uint32_t>(entryFunction);
+    return std::move(w.out);
+}
+
+// 디스크에서 읽은 함수를 실행해도 안전한지 확인한다.
+// 레지스터, 상수, 전역 변수, 점프 대상, 호출 대상이 모두 범위 안에 있어야 하고
+// 마지막 명령은 반드시 흐름을 끝내야 한다.
+static void verify(const Module& m, const Function& fn) {
+    auto fail = [&](const char* what) {
+        throw std::runtime_error(std::string("Bad bytecode in function ") + fn.name + ": " + what);
+    };
+    auto reg = [&](uint16_t r) {
+        if (r >= fn.numRegisters) fail("register out of range");
+    };
+
+    if (fn.numParams > fn.numRegisters) fail("more parameters than registers");
+    if (fn.code.empty()) fail("empty body");
+
+    int64_t size = static_cast<int64_t>(fn.code.size());
+    for (int64_t pc = 0; pc < size; ++pc) {
+        const Instruction& ins = fn.code[pc];
+        switch (ins.op) {
+            case Opcode::LOAD_INT:
+                reg(ins.a);
+                break;
+            case Opcode::LOAD_CONST:
+                reg(ins.a);
+                if (ins.bx() >= m.constants.size()) fail("constant out of range");
+                break;
+            case Opcode::LOAD_GLOBAL:
+            case Opcode::STORE_GLOBAL:
+                reg(ins.a);
+                if (ins.bx() >= m.numGlobals) fail("global out of range");
+                break;
+            case Opcode::MOVE: case Opcode::I2F:
+            case Opcode::NEG_I: case Opcode::NEG_F: case Opcode::NOT: case Opcode::BNOT:
+                reg(ins.a); reg(ins.b);
+                break;
+            case Opcode::JMP_FALSE:
+            case Opcode::JMP_TRUE:
+                reg(ins.a);
+                [[fallthrough]];
+            case Opcode::JMP: {
+                int64_t to = pc + 1 + ins.sbx();
+                if (to < 0 || to >= size) fail("jump out of range");
+                break;
+            }
+            case Opcode::CALL: {
+                if (ins.b >= m.functions.size()) fail("call target out of range");
+                reg(ins.a);
+                uint32_t params = m.functions[ins.b].numParams;
+                if (params > 0 && static_cast<uint32_t>(ins.c) + params > fn.numRegisters) {
+                    fail("call arguments out of range");
+                }
+                break;
+            }
+            case Opcode::RET:
+                reg(ins.a);
+                break;
+            case Opcode::RET_VOID:
+                break;
+            default:
+                if (ins.op >= Opcode::COUNT) fail("bad opcode");
+                reg(ins.a); reg(ins.b); reg(ins.c);
+                break;
+        }
+    }
+
+    Opcode last = fn.code.back().op;
+    if (last != Opcode::RET && last != Opcode::RET_VOID && last != Opcode::JMP) {
+        fail("falls off the end");
+    }
+}
+
+Module Module::deserialize(std::string_view data) {
+    Reader r(data);
+    char magic[4];
+    r.getBytes(magic, 4);
+    if (std::memcmp(magic, Magic, 4) != 0) {
+        throw std::runtime_error("Not a Zust bytecode module");
+    }
+    if (r.get<uint32_t>() != Version) {
+        throw std::runtime_error("Unsupported bytecode version");
+    }
+
+    Module m;
+    uint32_t numConstants = r.get<uint32_t>();
+    r.need(static_cast<size_t>(numConstants) * 5);   // 항목마다 최소 5바이트
+    m.constants.reserve(numConstants);
+    for (uint32_t i = 0; i < numConstants; ++i) {
+        Constant k;
+        k.kind = static_cast<Constant::Kind>(r.get<uint8_t>());
+        switch (k.kind) {
+            case Constant::INT: k.i = r.get<int64_t>(); break;
+            case Constant::FLOAT: k.f = r.get<double>(); break;
+            case Constant::STRING: k.s = r.getString(); break;
+            default: throw std::runtime_error("Bad constant kind in bytecode module");
+        }
+        m.constants.push_back(std::move(k));
+    }
+
+    m.numGlobals = r.get<uint32_t>();
+
+    uint32_t numFunctions = r.get<uint32_t>();
+    r.need(static_cast<size_t>(numFunctions) * 12);  // 항목마다 최소 12바이트
+    m.functions.resize(numFunctions);
+    for (auto& fn : m.functions) {
+        fn.name = r.getString();
+        fn.numParams = r.get<uint16_t>();
+        fn.numRegisters = r.get<uint16_t>();
+        uint32_t count = r.get<uint32_t>();
+        r.need(static_cast<size_t>(count) * sizeof(Instruction));
+        fn.code.resize(count);
+        r.getBytes(fn.code.data(), count * sizeof(Instruction));
+    }
+    for (const auto& fn : m.functions) {
+        verify(m, fn);
+    }
+
+    m.initFunction = r.get<uint32_t>();
+    m.entryFunction = r.get<uint32_t>();
+    if ((m.initFunction != NoFunction && m.initFunction >= numFunctions) ||
+        (m.entryFunction != NoFunction && m.entryFunction >= numFunctions)) {
+        throw std::runtime_error("Bad entry point in bytecode module");
+    }
+    return m;
+}
+
+std::string Module::disassemble() const {
+    std::ostringstream out;
+    for (size_t i = 0; i < constants.size(); ++i) {
+        const auto& k = constants[i];
+        out << "K" << i << " = ";
+        switch (k.kind) {
+            case Constant::INT: out << k.i; break;
+            case Constant::FLOAT: out << k.f; break;
+            case Constant::STRING: out << '"' << k.s << '"'; break;
+        }
+        out << "\n";
+    }
+    for (size_t f = 0; f < functions.size(); ++f) {
+        const auto& fn = functions[f];
+        out << "\nfn " << f << " " << fn.name << " (params " << fn.numParams
+            << ", registers " << fn.numRegisters << ")\n";
+        for (size_t pc = 0; pc < fn.code.size(); ++pc) {
+            const auto& ins = fn.code[pc];
+            out << "  " << pc << "\t" << opcodeName(ins.op) << "\t" << ins.a << " ";
+            switch (ins.op) {
+                case Opcode::LOAD_INT:
+                case Opcode::JMP:
+                case Opcode::JMP_FALSE:
+                case Opcode::JMP_TRUE:
+                    out << ins.sbx();
+                    break;
+                case Opcode::LOAD_CONST:
+                case Opcode::LOAD_GLOBAL:
+                case Opcode::STORE_GLOBAL:
+                    out << ins.bx();
+                    break;
+                default:
+                    out << ins.b << " " << ins.c;
+                    break;
+            }
+            out << "\n";
+        }
+    }
+    return out.str();
+}
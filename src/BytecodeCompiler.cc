@@ -0,0 +1,595 @@
+#include <BytecodeCompiler.hh>
+#include <ASTNode.hh>
+#include <Nodes.hh>
+#include <Program.hh>
+#include <Type.hh>
+
+#include <cstring>
+#include <stdexcept>
+
+#undef ccfn
+#define ccfn BytecodeCompiler::
+
+using FunctionDeclaration = Node<NodeType::FUNCTION_DECLARATION>;
+using VariableDeclaration = Node<NodeType::VARIABLE_DECLARATION>;
+using BlockStatement = Node<NodeType::BLOCK_STATEMENT>;
+using Identifier = Node<NodeType::IDENTIFIER>;
+
+// 분석되지 않은 노드(valueType 이 비어 있음)는 auto 로 본다
+static inline const Type* typeOf(ASTNode* node) {
+    return node && node->valueType ? node->valueType : &types::Auto;
+}
+
+// auto 는 정수로 실행한다
+static inline bool isFloat(const Type* type) { return type->isFloating(); }
+static inline bool isString(const Type* type) { return type == &types::String; }
+
+static const Type* resolveType(Name spelling) {
+    const Type* type = TypeTable::global().fromName(spelling);
+    return type ? type : &types::Auto;
+}
+
+// ===== 레지스터 / 스코프 =====
+
+uint16_t ccfn allocRegister() {
+    if (nextRegister == UINT16_MAX) {
+        throw std::runtime_error("Too many registers in function: " + fn->name);
+    }
+    uint16_t reg = nextRegister++;
+    if (nextRegister > fn->numRegisters) {
+        fn->numRegisters = nextRegister;
+    }
+    return reg;
+}
+
+const BytecodeCompiler::Local* ccfn findLocal(Name name) const {
+    for (size_t i = locals.size(); i-- > 0;) {
+        if (locals[i].name == name) return &locals[i];
+    }
+    return nullptr;
+}
+
+void ccfn pushScope() {
+    scopes.push_back(locals.size());
+}
+
+void ccfn popScope() {
+    locals.resize(scopes.back());
+    scopes.pop_back();
+    nextRegister = locals.empty() ? fn->numParams : locals.back().reg + 1;
+}
+
+// ===== 명령어 / 상수 =====
+
+size_t ccfn emit(Instruction ins) {
+    fn->code.push_back(ins);
+    return fn->code.size() - 1;
+}
+
+void ccfn emitInt(uint16_t dst, int64_t value) {
+    if (value >= INT32_MIN && value <= INT32_MAX) {
+        emit(Instruction::makeBx(Opcode::LOAD_INT, dst, static_cast<uint32_t>(static_cast<int32_t>(value))));
+    } else {
+        emit(Instruction::makeBx(Opcode::LOAD_CONST, dst, constant(value)));
+    }
+}
+
+// 점프 오프셋은 점프 명령 다음 명령 기준이다
+void ccfn patchJump(size_t at) {
+    int32_t offset = static_cast<int32_t>(fn->code.size() - at - 1);
+    Instruction& ins = fn->code[at];
+    ins = Instruction::makeBx(ins.op, ins.a, static_cast<uint32_t>(offset));
+}
+
+uint32_t ccfn constant(int64_t value) {
+    auto it = intConstants.find(value);
+    if (it != intConstants.end()) return it->second;
+    Constant k;
+    k.kind = Constant::INT;
+    k.i = value;
+    module.constants.push_back(std::move(k));
+    return intConstants[value] = static_cast<uint32_t>(module.constants.size() - 1);
+}
+
+uint32_t ccfn constant(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    auto it = floatConstants.find(bits);
+    if (it != floatConstants.end()) return it->second;
+    Constant k;
+    k.kind = Constant::FLOAT;
+    k.f = value;
+    module.constants.push_back(std::move(k));
+    return floatConstants[bits] = static_cast<uint32_t>(module.constants.size() - 1);
+}
+
+uint32_t ccfn constant(const std::string& value) {
+    auto it = stringConstants.find(value);
+    if (it != stringConstants.end()) return it->second;
+    Constant k;
+    k.kind = Constant::STRING;
+    k.s = value;
+    module.constants.push_back(std::move(k));
+    return stringConstants[value] = static_cast<uint32_t>(module.constants.size() - 1);
+}
+
+// ===== 변환 =====
+
+uint16_t ccfn asFloat(uint16_t reg, const Type* type) {
+    if (isFloat(type)) return reg;
+    uint16_t converted = allocRegister();
+    emit(Instruction::make(Opcode::I2F, converted, reg));
+    return converted;
+}
+
+void ccfn convertInto(uint16_t dst, uint16_t src, const Type* from, const Type* to) {
+    if (isFloat(to) && !isFloat(from)) {
+        emit(Instruction::make(Opcode::I2F, dst, src));
+    } else if (dst != src) {
+        emit(Instruction::make(Opcode::MOVE, dst, src));
+    }
+}
+
+// ===== 식 =====
+
+uint16_t ccfn compileExpression(ASTNode* node, int target) {
+    switch (node->type) {
+        case NodeType::INTEGER_LITERAL: {
+            uint16_t dst = destination(target);
+            emitInt(dst, static_cast<Node<NodeType::INTEGER_LITERAL>*>(node)->value);
+            return dst;
+        }
+        case NodeType::BOOL_LITERAL: {
+            uint16_t dst = destination(target);
+            emitInt(dst, static_cast<Node<NodeType::BOOL_LITERAL>*>(node)->value ? 1 : 0);
+            return dst;
+        }
+        case NodeType::FLOAT_LITERAL: {
+            uint16_t dst = destination(target);
+            double value = static_cast<Node<NodeType::FLOAT_LITERAL>*>(node)->value;
+            emit(Instruction::makeBx(Opcode::LOAD_CONST, dst, constant(value)));
+            return dst;
+        }
+        case NodeType::STRING_LITERAL: {
+            uint16_t dst = destination(target);
+            std::string value(static_cast<Node<NodeType::STRING_LITERAL>*>(node)->value);
+            emit(Instruction::makeBx(Opcode::LOAD_CONST, dst, constant(value)));
+            return dst;
+        }
+        case NodeType::IDENTIFIER: {
+            Name name = static_cast<Identifier*>(node)->name;
+            if (const Local* local = findLocal(name)) {
+                if (target < 0 || target == local->reg) return local->reg;
+                emit(Instruction::make(Opcode::MOVE, static_cast<uint16_t>(target), local->reg));
+                return static_cast<uint16_t>(target);
+            }
+            auto global = globals.find(name);
+            if (global == globals.end()) {
+                throw std::runtime_error("Undefined variable: " + std::string(name.str()));
+            }
+            uint16_t dst = destination(target);
+            emit(Instruction::makeBx(Opcode::LOAD_GLOBAL, dst, global->second.first));
+            return dst;
+        }
+        case NodeType::BINARY_EXPRESSION:
+            return compileBinary(static_cast<Node<NodeType::BINARY_EXPRESSION>*>(node), target);
+        case NodeType::UNARY_EXPRESSION: {
+            auto unary = static_cast<Node<NodeType::UNARY_EXPRESSION>*>(node);
+            const Type* operandType = typeOf(unary->operand);
+            uint16_t operand = compileExpression(unary->operand);
+            uint16_t dst = destination(target);
+            switch (unary->operator_) {
+                case TokenType::MINUS:
+                    emit(Instruction::make(isFloat(operandType) ? Opcode::NEG_F : Opcode::NEG_I, dst, operand));
+                    break;
+                case TokenType::LOGICAL_NOT:
+                    emit(Instruction::make(Opcode::NOT, dst, operand));
+                    break;
+                case TokenType::BIT_NOT:
+                    emit(Instruction::make(Opcode::BNOT, dst, operand));
+                    break;
+                default:
+                    if (dst != operand) emit(Instruction::make(Opcode::MOVE, dst, operand));
+                    break;
+            }
+            return dst;
+        }
+        case NodeType::ASSIGNMENT_EXPRESSION: {
+            auto assignment = static_cast<Node<NodeType::ASSIGNMENT_EXPRESSION>*>(node);
+            if (assignment->left->type != NodeType::IDENTIFIER) {
+                throw std::runtime_error("Invalid assignment target");
+            }
+            Name name = static_cast<Identifier*>(assignment->left)->name;
+            const Type* from = typeOf(assignment->right);
+            if (const Local* local = findLocal(name)) {
+                uint16_t reg = local->reg;
+                const Type* to = local->type;
+                if (isFloat(to) && !isFloat(from)) {
+                    uint16_t value = compileExpression(assignment->right);
+                    convertInto(reg, value, from, to);
+                } else {
+                    compileExpression(assignment->right, reg);
+                }
+                if (target >= 0 && target != reg) {
+                    emit(Instruction::make(Opcode::MOVE, static_cast<uint16_t>(target), reg));
+                    return static_cast<uint16_t>(target);
+                }
+                return reg;
+            }
+            auto global = globals.find(name);
+            if (global == globals.end()) {
+                throw std::runtime_error("Undefined variable: " + std::string(name.str()));
+            }
+            uint16_t value = compileExpression(assignment->right);
+            uint16_t dst = destination(target);
+            convertInto(dst, value, from, global->second.second);
+            emit(Instruction::makeBx(Opcode::STORE_GLOBAL, dst, global->second.first));
+            return dst;
+        }
+        case NodeType::CALL_EXPRESSION:
+            return compileCall(static_cast<Node<NodeType::CALL_EXPRESSION>*>(node), target);
+        default:
+            throw std::runtime_error("Unsupported expression in bytecode compiler");
+    }
+}
+
+uint16_t ccfn compileBinary(Node<NodeType::BINARY_EXPRESSION>* binary, int target) {
+    TokenType op = binary->operator_;
+
+    // && 와 || 는 단락 평가한다. 왼쪽 결과가 오른쪽 피연산자를 덮어쓰지 않도록
+    // 항상 새 레지스터에서 계산한다.
+    if (op == TokenType::LOGICAL_AND || op == TokenType::LOGICAL_OR) {
+        uint16_t dst = allocRegister();
+        compileExpression(binary->left, dst);
+        size_t jump = emit(Instruction::make(
+            op == TokenType::LOGICAL_AND ? Opcode::JMP_FALSE : Opcode::JMP_TRUE, dst));
+        compileExpression(binary->right, dst);
+        patchJump(jump);
+        if (target >= 0) {
+            emit(Instruction::make(Opcode::MOVE, static_cast<uint16_t>(target), dst));
+            return static_cast<uint16_t>(target);
+        }
+        return dst;
+    }
+
+    const Type* leftType = typeOf(binary->left);
+    const Type* rightType = typeOf(binary->right);
+    uint16_t left = compileExpression(binary->left);
+    uint16_t right = compileExpression(binary->right);
+
+    Opcode opcode;
+    switch (op) {
+        case TokenType::PLUS:
+        case TokenType::MINUS:
+        case TokenType::MULTIPLY:
+        case TokenType::DIVIDE:
+        case TokenType::MODULO: {
+            const Type* result = typeOf(binary);
+            if (isString(result)) {
+                opcode = Opcode::CONCAT;
+                break;
+            }
+            bool floating = isFloat(result);
+            if (floating) {
+                left = asFloat(left, leftType);
+                right = asFloat(right, rightType);
+            }
+            static constexpr Opcode ints[] = {Opcode::ADD_I, Opcode::SUB_I, Opcode::MUL_I, Opcode::DIV_I, Opcode::MOD_I};
+            static constexpr Opcode floats[] = {Opcode::ADD_F, Opcode::SUB_F, Opcode::MUL_F, Opcode::DIV_F, Opcode::MOD_F};
+            size_t index = static_cast<size_t>(op) - static_cast<size_t>(TokenType::PLUS);
+            opcode = floating ? floats[index] : ints[index];
+            break;
+        }
+        case TokenType::BIT_AND: opcode = Opcode::BAND; break;
+        case TokenType::BIT_OR: opcode = Opcode::BOR; break;
+        case TokenType::BIT_XOR: opcode = Opcode::BXOR; break;
+        case TokenType::LEFT_SHIFT: opcode = Opcode::SHL; break;
+        case TokenType::RIGHT_SHIFT: opcode = Opcode::SHR; break;
+        case TokenType::EQUAL:
+        case TokenType::NOT_EQUAL:
+            if (isString(leftType) && isString(rightType)) {
+                opcode = op == TokenType::EQUAL ? Opcode::EQ_S : Opcode::NE_S;
+                break;
+            }
+            [[fallthrough]];
+        case TokenType::LESS:
+        case TokenType::GREATER:
+        case TokenType::LESS_EQUAL:
+        case TokenType::GREATER_EQUAL: {
+            bool floating = isFloat(leftType) || isFloat(rightType);
+            if (floating) {
+                left = asFloat(left, leftType);
+                right = asFloat(right, rightType);
+            }
+            switch (op) {
+                case TokenType::EQUAL: opcode = floating ? Opcode::EQ_F : Opcode::EQ_I; break;
+                case TokenType::NOT_EQUAL: opcode = floating ? Opcode::NE_F : Opcode::NE_I; break;
+                case TokenType::LESS: opcode = floating ? Opcode::LT_F : Opcode::LT_I; break;
+                case TokenType::LESS_EQUAL: opcode = floating ? Opcode::LE_F : Opcode::LE_I; break;
+                case TokenType::GREATER: opcode = floating ? Opcode::GT_F : Opcode::GT_I; break;
+                default: opcode = floating ? Opcode::GE_F : Opcode::GE_I; break;
+            }
+            break;
+        }
+        default:
+            throw std::runtime_error("Unsupported binary operator in bytecode compiler");
+    }
+
+    uint16_t dst = destination(target);
+    emit(Instruction::make(opcode, dst, left, right));
+    return dst;
+}
+
+uint16_t ccfn compileCall(Node<NodeType::CALL_EXPRESSION>* call, int target) {
+    if (call->callee->type != NodeType::IDENTIFIER) {
+        throw std::runtime_error("Only direct calls are supported in bytecode");
+    }
+    Name name = static_cast<Identifier*>(call->callee)->name;
+    auto it = functions.find(name);
+    if (it == functions.end()) {
+        throw std::runtime_error("Undefined function: " + std::string(name.str()));
+    }
+    const FunctionInfo& info = it->second;
+
+    // 인자는 연속된 레지스터에 놓는다
+    uint16_t base = nextRegister;
+    for (size_t i = 0; i < call->arguments.size(); ++i) {
+        uint16_t slot = allocRegister();
+        ASTNode* argument = call->arguments[i];
+        const Type* paramType = i < info.paramTypes.size() ? info.paramTypes[i] : &types::Auto;
+        if (isFloat(paramType) && !isFloat(typeOf(argument))) {
+            uint16_t value = compileExpression(argument);
+            convertInto(slot, value, typeOf(argument), paramType);
+        } else {
+            compileExpression(argument, slot);
+        }
+        // 인자 계산에 쓴 임시 레지스터를 반납해서 다음 인자가 바로 뒤에 오게 한다
+        nextRegister = slot + 1;
+    }
+
+    uint16_t dst = destination(target);
+    emit(Instruction::make(Opcode::CALL, dst, static_cast<uint16_t>(info.index), base));
+    return dst;
+}
+
+// ===== 문장 =====
+
+void ccfn compileStatement(ASTNode* node) {
+    if (!node) return;
+
+    // 문장 사이에서는 임시 레지스터가 살아 있지 않다
+    nextRegister = locals.empty() ? fn->numParams : locals.back().reg + 1;
+
+    switch (node->type) {
+        case NodeType::VARIABLE_DECLARATION: {
+            auto var = static_cast<VariableDeclaration*>(node);
+            const Type* declared = resolveType(var->dataType);
+            uint16_t reg = allocRegister();
+            if (var->initializer) {
+                const Type* from = typeOf(var->initializer);
+                if (isFloat(declared) && !isFloat(from)) {
+                    convertInto(reg, compileExpression(var->initializer), from, declared);
+                } else {
+                    compileExpression(var->initializer, reg);
+                }
+            } else {
+                emitInt(reg, 0);
+            }
+            // 초기화 식이 끝난 뒤에 선언해야 같은 이름의 바깥 변수를 가리킨다
+            locals.push_back(Local{var->name, reg, declared});
+            break;
+        }
+        case NodeType::FUNCTION_DECLARATION:
+        case NodeType::NAMESPACE_DECLARATION:
+            // 함수는 collect 에서 모두 최상위로 끌어올렸다
+            break;
+        case NodeType::BLOCK_STATEMENT: {
+            pushScope();
+            for (ASTNode* stmt : static_cast<BlockStatement*>(node)->statements) {
+                compileStatement(stmt);
+            }
+            popScope();
+            break;
+        }
+        case NodeType::IF_STATEMENT: {
+            auto ifStmt = static_cast<Node<NodeType::IF_STATEMENT>*>(node);
+            uint16_t condition = compileExpression(ifStmt->condition);
+            size_t skipThen = emit(Instruction::make(Opcode::JMP_FALSE, condition));
+            compileStatement(ifStmt->thenStatement);
+            if (ifStmt->elseStatement) {
+                size_t skipElse = emit(Instruction::make(Opcode::JMP));
+                patchJump(skipThen);
+                compileStatement(ifStmt->elseStatement);
+                patchJump(skipElse);
+            } else {
+                patchJump(skipThen);
+            }
+            break;
+        }
+        case NodeType::WHILE_STATEMENT: {
+            auto whileStmt = static_cast<Node<NodeType::WHILE_STATEMENT>*>(node);
+            size_t loop = fn->code.size();
+            uint16_t condition = compileExpression(whileStmt->condition);
+            size_t exit = emit(Instruction::make(Opcode::JMP_FALSE, condition));
+            compileStatement(whileStmt->body);
+            int32_t back = static_cast<int32_t>(loop) - static_cast<int32_t>(fn->code.size()) - 1;
+            emit(Instruction::makeBx(Opcode::JMP, 0, static_cast<uint32_t>(back)));
+            patchJump(exit);
+            break;
+        }
+        case NodeType::RETURN_STATEMENT: {
+            auto returnStmt = static_cast<Node<NodeType::RETURN_STATEMENT>*>(node);
+            if (!returnStmt->expression) {
+                emit(Instruction::make(Opcode::RET_VOID));
+                break;
+            }
+            const Type* from = typeOf(returnStmt->expression);
+            uint16_t value = compileExpression(returnStmt->expression);
+            if (returnType && isFloat(returnType) && !isFloat(from)) {
+                uint16_t converted = allocRegister();
+                convertInto(converted, value, from, returnType);
+                value = converted;
+            }
+            emit(Instruction::make(Opcode::RET, value));
+            break;
+        }
+        case NodeType::EXPRESSION_STATEMENT:
+            compileExpression(static_cast<Node<NodeType::EXPRESSION_STATEMENT>*>(node)->expression);
+            break;
+        default:
+            break;
+    }
+}
+
+// ===== 함수 / 모듈 =====
+
+// 함수와 전역 변수에 번호를 매긴다. 네임스페이스와 함수 안의 함수도 모두 최상위로 끌어올린다.
+void ccfn collect(ASTNode* node, bool topLevel) {
+    if (!node) return;
+
+    switch (node->type) {
+        case NodeType::FUNCTION_DECLARATION: {
+            auto func = static_cast<FunctionDeclaration*>(node);
+            if (functions.count(func->name)) {
+                throw std::runtime_error("Duplicate function in bytecode module: " + std::string(func->name.str()));
+            }
+            FunctionInfo info;
+            info.index = static_cast<uint32_t>(functionOrder.size());
+            info.decl = func;
+            info.returnType = resolveType(func->returnType);
+            for (const auto& param : func->parameters) {
+                info.paramTypes.push_back(resolveType(param.type));
+            }
+            functions.emplace(func->name, std::move(info));
+            functionOrder.push_back(func->name);
+            collect(func->body, false);
+            break;
+        }
+        case NodeType::NAMESPACE_DECLARATION: {
+            // 네임스페이스 본문은 최상위와 같이 취급한다
+            auto body = static_cast<Node<NodeType::NAMESPACE_DECLARATION>*>(node)->body;
+            if (body && body->type == NodeType::BLOCK_STATEMENT) {
+                for (ASTNode* stmt : static_cast<BlockStatement*>(body)->statements) {
+                    collect(stmt, topLevel);
+                }
+            }
+            break;
+        }
+        case NodeType::BLOCK_STATEMENT:
+            for (ASTNode* stmt : static_cast<BlockStatement*>(node)->statements) {
+                collect(stmt, false);
+            }
+            break;
+        case NodeType::VARIABLE_DECLARATION:
+            if (topLevel) {
+                auto var = static_cast<VariableDeclaration*>(node);
+                uint32_t index = module.numGlobals++;
+                globals[var->name] = {index, resolveType(var->dataType)};
+            }
+            break;
+        case NodeType::IF_STATEMENT: {
+            auto ifStmt = static_cast<Node<NodeType::IF_STATEMENT>*>(node);
+            collect(ifStmt->thenStatement, false);
+            collect(ifStmt->elseStatement, false);
+            break;
+        }
+        case NodeType::WHILE_STATEMENT:
+            collect(static_cast<Node<NodeType::WHILE_STATEMENT>*>(node)->body, false);
+            break;
+        case NodeType::IMPORT_STATEMENT:
+            // 모듈 인터페이스에는 선언만 있고 실행할 본문이 없다
+            throw std::runtime_error("Imports are only supported by the C++ backend");
+        default:
+            break;
+    }
+}
+
+void ccfn compileFunction(const FunctionInfo& info) {
+    FunctionDeclaration* func = info.decl;
+    fn = &module.functions[info.index];
+    fn->name = std::string(func->name.str());
+    fn->numParams = static_cast<uint16_t>(func->parameters.size());
+    fn->numRegisters = fn->numParams;
+    returnType = info.returnType;
+
+    locals.clear();
+    scopes.clear();
+    for (size_t i = 0; i < func->parameters.size(); ++i) {
+        locals.push_back(Local{func->parameters[i].name, static_cast<uint16_t>(i), info.paramTypes[i]});
+    }
+    nextRegister = fn->numParams;
+
+    compileStatement(func->body);
+    if (fn->code.empty() || fn->code.back().op != Opcode::RET) {
+        emit(Instruction::make(Opcode::RET_VOID));
+    }
+}
+
+// 최상위 let 은 전역 변수로, 나머지 문장은 초기화 함수 안에서 순서대로 실행한다
+void ccfn compileTopLevel(ASTNode* node) {
+    if (!node) return;
+
+    switch (node->type) {
+        case NodeType::NAMESPACE_DECLARATION: {
+            auto body = static_cast<Node<NodeType::NAMESPACE_DECLARATION>*>(node)->body;
+            if (body && body->type == NodeType::BLOCK_STATEMENT) {
+                for (ASTNode* stmt : static_cast<BlockStatement*>(body)->statements) {
+                    compileTopLevel(stmt);
+                }
+            }
+            break;
+        }
+        case NodeType::VARIABLE_DECLARATION: {
+            auto var = static_cast<VariableDeclaration*>(node);
+            const auto& global = globals.at(var->name);
+            nextRegister = 0;
+            uint16_t reg = allocRegister();
+            if (var->initializer) {
+                uint16_t value = compileExpression(var->initializer);
+                convertInto(reg, value, typeOf(var->initializer), global.second);
+            } else {
+                emitInt(reg, 0);
+            }
+            emit(Instruction::makeBx(Opcode::STORE_GLOBAL, reg, global.first));
+            break;
+        }
+        default:
+            compileStatement(node);
+            break;
+    }
+}
+
+void ccfn compileInit(Program* program) {
+    module.initFunction = static_cast<uint32_t>(module.functions.size());
+    module.functions.emplace_back();
+    fn = &module.functions.back();
+    fn->name = "<init>";
+    returnType = nullptr;
+    locals.clear();
+    scopes.clear();
+    nextRegister = 0;
+
+    for (ASTNode* stmt : program->statements) {
+        compileTopLevel(stmt);
+    }
+    emit(Instruction::make(Opcode::RET_VOID));
+}
+
+Module ccfn compile(Program* program) {
+    for (ASTNode* stmt : program->statements) {
+        collect(stmt, true);
+    }
+
+    module.functions.resize(functionOrder.size());
+    for (Name name : functionOrder) {
+        compileFunction(functions.at(name));
+    }
+    compileInit(program);
+
+    auto entry = functions.find(names::Main);
+    if (entry != functions.end()) {
+        module.entryFunction = entry->second.index;
+    }
+    fn = nullptr;
+    return std::move(module);
+}
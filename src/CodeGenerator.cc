@@ -1,8 +1,14 @@
 #include <CodeGenerator.hh>
 #include <ASTNode.hh>
+#include <IrEmitter.hh>
+#include <ModuleInterface.hh>
 #include <Nodes.hh>
 #include <Program.hh>
+#include <Type.hh>
 
+#include <charconv>
+
+#undef ccfn
 #define ccfn CodeGenerator::
 
 using IntegerLiteral = Node<NodeType::INTEGER_LITERAL>;
@@ -11,6 +17,7 @@ using StringLiteral = Node<NodeType::STRING_LITERAL>;
 using BoolLiteral = Node<NodeType::BOOL_LITERAL>;
 using Identifier = Node<NodeType::IDENTIFIER>;
 using BinaryExpression = Node<NodeType::BINARY_EXPRESSION>;
+using UnaryExpression = Node<NodeType::UNARY_EXPRESSION>;
 using AssignmentExpression = Node<NodeType::ASSIGNMENT_EXPRESSION>;
 using WhileStatement = Node<NodeType::WHILE_STATEMENT>;
 using VariableDeclaration = Node<NodeType::VARIABLE_DECLARATION>;
@@ -21,229 +28,271 @@ using IfStatement = Node<NodeType::IF_STATEMENT>;
 using ExpressionStatement = Node<NodeType::EXPRESSION_STATEMENT>;
 using ReturnStatement = Node<NodeType::RETURN_STATEMENT>;
 using NamespaceDeclaration = Node<NodeType::NAMESPACE_DECLARATION>;
+using ImportStatement = Node<NodeType::IMPORT_STATEMENT>;
+
+static std::string_view operatorSymbol(TokenType op) {
+    switch (op) {
+        case TokenType::PLUS: return "+";
+        case TokenType::MINUS: return "-";
+        case TokenType::MULTIPLY: return "*";
+        case TokenType::DIVIDE: return "/";
+        case TokenType::MODULO: return "%";
+        case TokenType::EQUAL: return "==";
+        case TokenType::NOT_EQUAL: return "!=";
+        case TokenType::LESS: return "<";
+        case TokenType::GREATER: return ">";
+        case TokenType::LESS_EQUAL: return "<=";
+        case TokenType::GREATER_EQUAL: return ">=";
+        case TokenType::LOGICAL_AND: return "&&";
+        case TokenType::LOGICAL_OR: return "||";
+        case TokenType::BIT_AND: return "&";
+        case TokenType::BIT_OR: return "|";
+        case TokenType::BIT_XOR: return "^";
+        case TokenType::LEFT_SHIFT: return "<<";
+        case TokenType::RIGHT_SHIFT: return ">>";
+        default: return "OP";
+    }
+}
+
+// ===== 식 =====
+
+void ccfn visit(IntegerLiteral* lit) {
+    output << lit->value;
+}
+
+void ccfn visit(FloatLiteral* lit) {
+    // 접힌 상수도 값이 그대로 남도록 가장 짧은 왕복 표현으로 쓰고,
+    // C++ 에서 정수 리터럴로 읽히지 않게 소수점을 붙인다
+    char buf[32];
+    char* end = std::to_chars(buf, buf + sizeof buf, lit->value).ptr;
+    std::string_view text(buf, static_cast<size_t>(end - buf));
+    output << text;
+    if (text.find_first_of(".e") == std::string_view::npos) output << ".0";
+}
+
+void ccfn visit(StringLiteral* lit) {
+    output << "\"" << lit->value << "\"";
+}
 
+void ccfn visit(BoolLiteral* lit) {
+    if (lit->value) output << "true";
+    else output << "false";
+}
+
+void ccfn visit(Identifier* id) {
+    output << id->name.str();
+}
 
-void ccfn generateExpression(ASTNode* node) {
-    if (!node) return;
+void ccfn visit(BinaryExpression* binary) {
+    output << "(";
+    generateExpression(binary->left);
     
-    switch (node->type) {
-        case NodeType::INTEGER_LITERAL: {
-            auto lit = static_cast<IntegerLiteral*>(node);
-            output << lit->value;
-            break;
-        }
-        case NodeType::FLOAT_LITERAL: {
-            auto lit = static_cast<FloatLiteral*>(node);
-            output << lit->value;
-            break;
-        }
-        case NodeType::STRING_LITERAL: {
-            auto lit = static_cast<StringLiteral*>(node);
-            output << "\"" << lit->value << "\"";
-            break;
-        }
-        case NodeType::BOOL_LITERAL: {
-            auto lit = static_cast<BoolLiteral*>(node);
-            output << (lit->value ? "true" : "false");
-            break;
-        }
-        case NodeType::IDENTIFIER: {
-            auto id = static_cast<Identifier*>(node);
-            output << id->name;
-            break;
-        }
-        case NodeType::BINARY_EXPRESSION: {
-            auto binary = static_cast<BinaryExpression*>(node);
-            output << "(";
-            generateExpression(binary->left.get());
-            
-            switch (binary->operator_) {
-                case TokenType::PLUS: output << " + "; break;
-                case TokenType::MINUS: output << " - "; break;
-                case TokenType::MULTIPLY: output << " * "; break;
-                case TokenType::DIVIDE: output << " / "; break;
-                case TokenType::MODULO: output << " % "; break;
-                case TokenType::EQUAL: output << " == "; break;
-                case TokenType::NOT_EQUAL: output << " != "; break;
-                case TokenType::LESS: output << " < "; break;
-                case TokenType::GREATER: output << " > "; break;
-                case TokenType::LESS_EQUAL: output << " <= "; break;
-                case TokenType::GREATER_EQUAL: output << " >= "; break;
-                case TokenType::LOGICAL_AND: output << " && "; break;
-                case TokenType::LOGICAL_OR: output << " || "; break;
-                case TokenType::BIT_AND: output << " & "; break;
-                case TokenType::BIT_OR: output << " | "; break;
-                case TokenType::BIT_XOR: output << " ^ "; break;
-                case TokenType::LEFT_SHIFT: output << " << "; break;
-                case TokenType::RIGHT_SHIFT: output << " >> "; break;
-                default: output << " OP "; break;
-            }
-            
-            generateExpression(binary->right.get());
-            output << ")";
-            break;
-        }
-        case NodeType::ASSIGNMENT_EXPRESSION: {
-            auto assignment = static_cast<AssignmentExpression*>(node);
-            generateExpression(assignment->left.get());
-            output << " = ";
-            generateExpression(assignment->right.get());
-            break;
-        }
-        case NodeType::CALL_EXPRESSION: {
-            auto call = static_cast<CallExpression*>(node);
-            generateExpression(call->callee.get());
-            output << "(";
-            
-            for (size_t i = 0; i < call->arguments.size(); ++i) {
-                if (i > 0) output << ", ";
-                generateExpression(call->arguments[i].get());
-            }
-            
-            output << ")";
-            break;
-        }
-        default:
-            break;
+    output << " " << operatorSymbol(binary->operator_) << " ";
+    
+    generateExpression(binary->right);
+    output << ")";
+}
+
+void ccfn visit(UnaryExpression* unary) {
+    output << "(";
+    switch (unary->operator_) {
+        case TokenType::MINUS: output << "-"; break;
+        case TokenType::PLUS: output << "+"; break;
+        case TokenType::LOGICAL_NOT: output << "!"; break;
+        case TokenType::BIT_NOT: output << "~"; break;
+        default: output << "OP "; break;
     }
+    generateExpression(unary->operand);
+    output << ")";
 }
 
+void ccfn visit(AssignmentExpression* assignment) {
+    generateExpression(assignment->left);
+    // 파서가 풀어 둔 x = x op e 가 최적화 뒤에도 그 모양이면 x op= e 로 쓴다
+    auto binary = static_cast<BinaryExpression*>(assignment->right);
+    if (assignment->operator_ != TokenType::ASSIGN &&
+        assignment->right->type == NodeType::BINARY_EXPRESSION &&
+        binary->left == assignment->left && binary->operator_ == assignment->operator_) {
+        output << " " << operatorSymbol(binary->operator_) << "= ";
+        generateExpression(binary->right);
+        return;
+    }
+    output << " = ";
+    generateExpression(assignment->right);
+}
 
-void ccfn generateStatement(ASTNode* node) {
-    if (!node) return;
-    
-    switch (node->type) {
-        case NodeType::VARIABLE_DECLARATION: {
-            auto var = static_cast<VariableDeclaration*>(node);
-            indent();
-            
-            // C++ 타입 매핑
-            std::string cppType = mapToCppType(var->dataType);
-            output << cppType << " " << var->name;
-            
-            if (var->initializer) {
-                output << " = ";
-                generateExpression(var->initializer.get());
-            }
-            
-            output << ";\n";
-            break;
-        }
-        case NodeType::FUNCTION_DECLARATION: {
-            auto func = static_cast<FunctionDeclaration*>(node);
-            indent();
-            
-            std::string returnType = mapToCppType(func->returnType);
-            output << returnType << " " << func->name << "(";
-            
-            for (size_t i = 0; i < func->parameters.size(); ++i) {
-                if (i > 0) output << ", ";
-                output << mapToCppType(func->parameters[i].first) << " " << func->parameters[i].second;
-            }
-            
-            output << ")";
-            
-            if (func->body) {
-                output << " ";
-                generateStatement(func->body.get());
-            } else {
-                output << ";\n";
-            }
-            break;
-        }
-        case NodeType::BLOCK_STATEMENT: {
-            auto block = static_cast<BlockStatement*>(node);
-            output << "{\n";
-            indentLevel++;
-            
-            for (const auto& stmt : block->statements) {
-                generateStatement(stmt.get());
-            }
-            
-            indentLevel--;
-            indent();
-            output << "}\n";
-            break;
-        }
-        case NodeType::IF_STATEMENT: {
-            auto ifStmt = static_cast<IfStatement*>(node);
-            indent();
-            output << "if (";
-            generateExpression(ifStmt->condition.get());
-            output << ") ";
-            
-            generateStatement(ifStmt->thenStatement.get());
-            
-            if (ifStmt->elseStatement) {
-                indent();
-                output << "else ";
-                generateStatement(ifStmt->elseStatement.get());
-            }
-            break;
-        }
-        case NodeType::WHILE_STATEMENT: {
-            auto whileStmt = static_cast<WhileStatement*>(node);
-            indent();
-            output << "while (";
-            generateExpression(whileStmt->condition.get());
-            output << ") ";
-            
-            generateStatement(whileStmt->body.get());
-            break;
-        }
-        case NodeType::RETURN_STATEMENT: {
-            auto returnStmt = static_cast<ReturnStatement*>(node);
-            indent();
-            output << "return";
-            
-            if (returnStmt->expression) {
-                output << " ";
-                generateExpression(returnStmt->expression.get());
-            }
-            
-            output << ";\n";
-            break;
-        }
-        case NodeType::EXPRESSION_STATEMENT: {
-            auto exprStmt = static_cast<ExpressionStatement*>(node);
-            indent();
-            generateExpression(exprStmt->expression.get());
-            output << ";\n";
-            break;
+void ccfn visit(CallExpression* call) {
+    generateExpression(call->callee);
+    output << "(";
+    
+    for (size_t i = 0; i < call->arguments.size(); ++i) {
+        if (i > 0) output << ", ";
+        generateExpression(call->arguments[i]);
+    }
+    
+    output << ")";
+}
+
+// ===== 문장 =====
+
+void ccfn visit(VariableDeclaration* var) {
+    indent();
+    
+    // C++ 타입 매핑
+    std::string cppType = mapToCppType(var->dataType);
+    output << cppType << " " << var->name.str();
+    
+    if (var->initializer) {
+        output << " = ";
+        generateExpression(var->initializer);
+    }
+    
+    output << ";\n";
+}
+
+void ccfn visit(FunctionDeclaration* func) {
+    indent();
+    
+    std::string returnType = mapToCppType(func->returnType);
+    output << returnType << " " << func->name.str() << "(";
+    
+    for (size_t i = 0; i < func->parameters.size(); ++i) {
+        if (i > 0) output << ", ";
+        output << mapToCppType(func->parameters[i].type) << " " << func->parameters[i].name.str();
+    }
+    
+    output << ")";
+    
+    if (func->body) {
+        output << " ";
+        const ir::Function* function = lowered ? lowered->find(func) : nullptr;
+        if (function) IrEmitter(output, *this).body(*function, indentLevel);
+        else generateStatement(func->body);
+    } else {
+        output << ";\n";
+    }
+}
+
+void ccfn visit(BlockStatement* block) {
+    output << "{\n";
+    indentLevel++;
+    
+    for (const auto& stmt : block->statements) {
+        // 블록은 보통 다른 문장 뒤에 붙어서 나오므로 스스로 들여쓰지 않는다
+        if (stmt->type == NodeType::BLOCK_STATEMENT) indent();
+        generateStatement(stmt);
+    }
+    
+    indentLevel--;
+    indent();
+    output << "}\n";
+}
+
+void ccfn visit(IfStatement* ifStmt) {
+    indent();
+    output << "if (";
+    generateExpression(ifStmt->condition);
+    output << ") ";
+    
+    generateStatement(ifStmt->thenStatement);
+    
+    if (ifStmt->elseStatement) {
+        indent();
+        output << "else ";
+        generateStatement(ifStmt->elseStatement);
+    }
+}
+
+void ccfn visit(WhileStatement* whileStmt) {
+    indent();
+    output << "while (";
+    generateExpression(whileStmt->condition);
+    output << ") ";
+    
+    generateStatement(whileStmt->body);
+}
+
+void ccfn visit(ReturnStatement* returnStmt) {
+    indent();
+    output << "return";
+    
+    if (returnStmt->expression) {
+        output << " ";
+        generateExpression(returnStmt->expression);
+    }
+    
+    output << ";\n";
+}
+
+void ccfn visit(ExpressionStatement* exprStmt) {
+    indent();
+    generateExpression(exprStmt->expression);
+    output << ";\n";
+}
+
+void ccfn visit(NamespaceDeclaration* ns) {
+    indent();
+    output << "namespace " << ns->name.str() << " ";
+    generateStatement(ns->body);
+}
+
+void ccfn visit(ImportStatement* importStmt) {
+    // 모듈은 따로 컴파일되므로 선언만 내보낸다. 정의는 모듈의 .cpp 와 링크한다.
+    indent();
+    output << "// import " << importStmt->module.str() << "\n";
+    const ModuleInterface* module = importStmt->interface;
+    if (!module) return;
+    for (const ExportedSymbol& symbol : module->symbols) {
+        indent();
+        if (!symbol.isFunction) {
+            output << "extern " << mapToCppType(symbol.type) << " " << symbol.name.str() << ";\n";
+            continue;
         }
-        case NodeType::NAMESPACE_DECLARATION: {
-            auto ns = static_cast<NamespaceDeclaration*>(node);
-            indent();
-            output << "namespace " << ns->name << " ";
-            generateStatement(ns->body.get());
-            break;
+        output << mapToCppType(symbol.type) << " " << symbol.name.str() << "(";
+        const Parameter* params = module->paramsOf(symbol);
+        for (uint32_t i = 0; i < symbol.paramCount; ++i) {
+            if (i > 0) output << ", ";
+            output << mapToCppType(params[i].type) << " " << params[i].name.str();
         }
-        default:
-            break;
+        output << ");\n";
     }
 }
-std::string ccfn mapToCppType(const std::string& type) const {
-    if (type == "int") return "int";
-    if (type == "float") return "float";
-    if (type == "double") return "double";
-    if (type == "char") return "char";
-    if (type == "bool") return "bool";
-    if (type == "string") return "std::string";
-    if (type == "byte") return "unsigned char";
-    if (type == "short") return "short";
-    if (type == "long") return "long";
-    if (type == "void") return "void";
-    return type;
+
+std::string ccfn mapToCppType(Name type) const {
+    switch (type.id) {
+        case names::Int.id: return "int";
+        case names::Float.id: return "float";
+        case names::Double.id: return "double";
+        case names::Char.id: return "char";
+        case names::Bool.id: return "bool";
+        case names::String.id: return "std::string";
+        case names::Byte.id: return "unsigned char";
+        case names::Short.id: return "short";
+        case names::Long.id: return "long";
+        case names::Void.id: return "void";
+        default: break;
+    }
+    
+    const Type* resolved = TypeTable::global().fromName(type);
+    if (resolved && resolved->kind == Type::ARRAY) {
+        return "std::vector<" + mapToCppType(resolved->element->name) + ">";
+    }
+    return std::string(type.str());
 }
 
-std::string ccfn generate(Program* program) {
+void ccfn prologue() {
     output << "#include <iostream>\n";
     output << "#include <string>\n";
-    output << "#include <cmath>\n\n";
-    
-    for (const auto& stmt : program->statements) {
-        generateStatement(stmt.get());
-    }
-    
+    output << "#include <cmath>\n";
+    output << "#include <vector>\n\n";
+}
+
+void ccfn emit(Program* program) {
+    prologue();
+    runFused(program->statements, *this);
+}
+
+std::string ccfn generate(Program* program) {
+    emit(program);
     return output.str();
 }
\ No newline at end of file
@@ -0,0 +1,53 @@
+#include <CompileCache.hh>
+#include <AtomicFile.hh>
+#include <Compiler.hh>
+#include <Sha256.hh>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#undef ccfn
+#define ccfn CompileCache::
+
+namespace fs = std::filesystem;
+
+ccfn CompileCache(std::string dir) : directory(std::move(dir)) {}
+
+std::string ccfn key(std::string_view source, std::string_view artifact, const CompilerOptions& options) {
+    Sha256 hash;
+    hash.field(Compiler::Version);
+    hash.field(artifact);
+    hash.field(options.fingerprint());
+    hash.field(source);
+    return hash.hexDigest();
+}
+
+// 한 디렉터리에 파일이 너무 많아지지 않도록 앞 두 글자로 나눈다
+std::string ccfn pathFor(const std::string& key) const {
+    return (fs::path(directory) / key.substr(0, 2) / key.substr(2)).string();
+}
+
+bool ccfn lookup(const std::string& key, std::string& out) {
+    std::ifstream in(pathFor(key), std::ios::binary);
+    if (!in) {
+        missCount.fetch_add(1);
+        return false;
+    }
+    out.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    if (in.bad()) {
+        missCount.fetch_add(1);
+        return false;
+    }
+    hitCount.fetch_add(1);
+    return true;
+}
+
+void ccfn store(const std::string& key, std::string_view data) {
+    std::string target = pathFor(key);
+    std::error_code ec;
+    fs::create_directories(fs::path(target).parent_path(), ec);
+    if (ec) return;
+
+    atomic_file::write(target, data);
+}
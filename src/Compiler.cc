@@ -1,58 +1,291 @@
 #include <Compiler.hh>
 
+#include <AstImage.hh>
 #include <memory>
 #include <vector>
 #include <Program.hh>
 #include <Token.hh>
 #include <Lexer.hh>
+#include <SourceBuffer.hh>
 #include <Parser.hh>
 #include <SemanticAnalyser.hh>
 #include <CodeGenerator.hh>
-#include <fstream>
+#include <Optimizer.hh>
+#include <DeadCodeEliminator.hh>
+#include <Ir.hh>
+#include <IrBuilder.hh>
+#include <IrPasses.hh>
+#include <BytecodeCompiler.hh>
+#include <CompileCache.hh>
+#include <ModuleLoader.hh>
+#include <Profiler.hh>
+#include <OutputBuffer.hh>
+#include <Scan.hh>
+#include <cctype>
+#include <stdexcept>
 
 #undef ccfn
 #define ccfn Compiler::
 
+std::string CompilerOptions::fingerprint() const {
+    std::string result = "O" + std::to_string(optimizationLevel);
+    for (const std::string& name : exports) {
+        result += " export:" + name;
+    }
+    return result;
+}
+
 std::string ccfn compile(const std::string& sourceCode) {
-    std::unique_ptr<Program> ast = 0;
-    std::vector<Token> tokens;
-
-    try {
-        // 1. 렉싱
-        Lexer lexer(sourceCode);
-        tokens = lexer.tokenize();
-        
-    } catch (const std::exception& e) {
-        return "Compilation Error: " + std::string(e.what());
-    }
-                // 2. 파싱
-        Parser parser(tokens);
-        ast = parser.parse();
-
-        // 3. 의미 분석
-        SemanticAnalyser analyzer;
+    return compile(SourceBuffer(sourceCode));
+}
+
+// import 문이 있는 소스. 결과가 다른 파일(모듈)에도 달려 있으므로 캐시하지 않는다.
+// 렉서처럼 주석과 문자열을 건너뛰고 식별자 단위로 본다. importer 같은 이름이나
+// 주석 속의 import 때문에 캐시를 끄지 않도록.
+static bool mayImport(const SourceBuffer& source) {
+    std::string_view text = source.view();
+    const char* p = text.data();
+    const char* end = p + text.size();
+    auto identifier = [](char c) { return isalnum(static_cast<unsigned char>(c)) || c == '_'; };
+    while (p < end) {
+        char c = *p;
+        if (c == '#') {
+            p = scan::findNewline(p, end);
+        } else if (c == '"') {
+            p = scan::findQuoteOrBackslash(p + 1, end);
+            while (p < end && *p == '\\') p = scan::findQuoteOrBackslash(p + 2 < end ? p + 2 : end, end);
+            if (p < end) ++p;
+        } else if (c == '\'') {
+            ++p;
+            if (p < end && *p == '\\') p += 2;
+            while (p < end && *p != '\'' && *p != '\n') ++p;
+            if (p < end) ++p;
+        } else if (identifier(c)) {
+            const char* start = p;
+            while (p < end && identifier(*p)) ++p;
+            if (std::string_view(start, static_cast<size_t>(p - start)) == "import") return true;
+        } else {
+            ++p;
+        }
+    }
+    return false;
+}
+
+std::unique_ptr<Program> ccfn parse(SourceBuffer source) {
+    // --emit-ast 로 저장해 둔 AST 면 렉싱과 파싱 없이 노드만 되살린다
+    if (AstImage::isImage(source.view())) {
+        ZUST_PROFILE_SCOPE(scope, "load-ast");
+        AstImage image(std::move(source));
+        std::unique_ptr<Program> ast = image.materialize();
+        ZUST_PROFILE_COUNT(scope, NODES, ast->arena.nodeCount());
+        return ast;
+    }
+
+    // 1. 렉싱 / 2. 파싱
+    // 파서가 렉서에서 토큰을 TokenBuffer::Chunk 개씩 당겨 오므로 토큰 배열 전체를 만들지 않는다
+    // 렉싱은 파싱 안에서 토큰 단위로 일어나므로 두 단계를 한 구간으로 잰다
+    ZUST_PROFILE_SCOPE(scope, "parse");
+    Lexer lexer(std::move(source));
+    Parser parser(lexer);
+    std::unique_ptr<Program> ast = parser.parse();
+    ZUST_PROFILE_COUNT(scope, TOKENS, parser.tokensConsumed());
+    ZUST_PROFILE_COUNT(scope, NODES, ast->arena.nodeCount());
+
+    // 파서는 오류가 나도 끝까지 읽으므로 한 번에 모든 문법 오류를 보고한다
+    if (parser.hasErrors()) {
+        std::string message;
+        for (const Diagnostic& diagnostic : parser.diagnostics()) {
+            if (!message.empty()) message += "\n";
+            message += CompilerError(CompilerError::SYNTAX, diagnostic.message,
+                diagnostic.line, diagnostic.column).what();
+        }
+        throw std::runtime_error(message);
+    }
+    return ast;
+}
+
+std::unique_ptr<Program> ccfn load(SourceBuffer source, const std::string& origin) {
+    std::unique_ptr<Program> ast = parse(std::move(source));
+
+    // import 한 모듈을 찾아 인터페이스를 붙인다. 인터페이스는 ast 가 함께 소유한다.
+    bool imports = false;
+    for (const ASTNode* stmt : ast->statements) {
+        imports = imports || stmt->type == NodeType::IMPORT_STATEMENT;
+    }
+    if (imports) {
+        ZUST_PROFILE_SCOPE(scope, "modules");
+        ModuleLoader loader(options.modulePaths);
+        loader.resolve(ast.get(), origin);
+    }
+    return ast;
+}
+
+std::unique_ptr<Program> ccfn analyze(SourceBuffer source, const std::string& origin) {
+    std::unique_ptr<Program> ast = load(std::move(source), origin);
+
+    // 3. 의미 분석 + 4. 최적화
+    // 상수 접기는 타입 정보가 필요하므로 분석기가 식의 타입을 정하는 자리에서 함께 한다
+    {
+        ZUST_PROFILE_SCOPE(scope, "analyze");
+        Optimizer folder(&ast->arena);
+        SemanticAnalyser analyzer(options.optimizationLevel > 0 ? &folder : nullptr);
         analyzer.analyze(ast.get());
-        
-        // 4. 코드 생성
+        ZUST_PROFILE_COUNT(scope, SYMBOLS, analyzer.declaredSymbols());
+    }
+
+    if (options.optimizationLevel > 0) {
+        // 접힌 조건의 죽은 가지까지 지우려면 접기 다음이어야 한다
+        ZUST_PROFILE_SCOPE(scope, "dce");
+        std::vector<Name> exported;
+        for (const std::string& name : options.exports) {
+            exported.push_back(intern(name));
+        }
+        DeadCodeEliminator eliminator(std::move(exported));
+        eliminator.eliminate(ast.get());
+    }
+    return ast;
+}
+
+std::string ccfn analyzeAndGenerate(SourceBuffer source, const std::string& origin) {
+    std::unique_ptr<Program> ast = load(std::move(source), origin);
+
+    // 3. 의미 분석 + 5. 코드 생성
+    // 프로그램 전체를 봐야 하는 단계(죽은 코드 제거)가 없으므로 최상위 선언마다 분석한 직후에
+    // 생성한다. 선언의 노드가 캐시에 남아 있을 때 두 번째 순회가 지나간다.
+    ZUST_PROFILE_SCOPE(scope, "analyze+gen");
+    SemanticAnalyser analyzer;
+    CodeGenerator generator;
+    generator.prologue();
+    runFused(ast->statements, analyzer, generator);
+    ZUST_PROFILE_COUNT(scope, SYMBOLS, analyzer.declaredSymbols());
+    return generator.str();
+}
+
+ir::Module ccfn lowerToIr(Program* ast, bool optimize) {
+    ir::Module module;
+    {
+        ZUST_PROFILE_SCOPE(scope, "ir-lower");
+        IrBuilder builder;
+        module = builder.build(ast);
+        size_t instructions = 0;
+        for (const auto& function : module.functions()) instructions += function->size();
+        ZUST_PROFILE_COUNT(scope, NODES, instructions);
+        (void)instructions;
+    }
+    // 패스마다 따로 잰다 (ir-sccp, ir-copyprop, ir-gvn, ir-dce)
+    if (optimize) ir::PassManager::standard().run(module);
+    return module;
+}
+
+std::string ccfn dumpIr(SourceBuffer source, const std::string& origin) {
+    std::unique_ptr<Program> ast = analyze(std::move(source), origin);
+    return lowerToIr(ast.get(), options.optimizationLevel > 0).dump();
+}
+
+std::string ccfn compile(SourceBuffer source, const std::string& origin) {
+    // 0. 캐시에 같은 입력으로 만든 결과가 있으면 어떤 단계도 돌리지 않는다
+    std::string key;
+    bool cacheable = options.cache && !mayImport(source);
+    if (cacheable) {
+        ZUST_PROFILE_SCOPE(scope, "cache");
+        key = CompileCache::key(source.view(), "cpp", options);
+        std::string cached;
+        if (options.cache->lookup(key, cached)) {
+            return cached;
+        }
+    }
+
+    std::string result;
+    if (options.optimizationLevel == 0) {
+        result = analyzeAndGenerate(std::move(source), origin);
+    } else {
+        std::unique_ptr<Program> ast = analyze(std::move(source), origin);
+        ir::Module lowered;
+        if (options.optimizationLevel >= 2) lowered = lowerToIr(ast.get(), true);
+
+        // 5. 코드 생성
+        ZUST_PROFILE_SCOPE(scope, "codegen");
         CodeGenerator generator;
-        return generator.generate(ast.get());
+        if (options.optimizationLevel >= 2) generator.setLowered(&lowered);
+        result = generator.generate(ast.get());
+    }
+    if (cacheable) {
+        options.cache->store(key, result);
+    }
+    return result;
 }
 
 void ccfn compileFile(const std::string& inputFile, const std::string& outputFile) {
-    std::ifstream inFile(inputFile);
-    if (!inFile) {
-        throw std::runtime_error("Cannot open input file: " + inputFile);
-    }
-    
-    std::string sourceCode((std::istreambuf_iterator<char>(inFile)),
-                            std::istreambuf_iterator<char>());
-    
-    std::string result = compile(sourceCode);
-    
-    std::ofstream outFile(outputFile);
-    if (!outFile) {
-        throw std::runtime_error("Cannot create output file: " + outputFile);
-    }
-    
-    outFile << result;
-}
\ No newline at end of file
+    SourceBuffer source = SourceBuffer::map(inputFile);
+    if ((options.cache && !mayImport(source)) || options.optimizationLevel == 0) {
+        // 캐시에 넣으려면 결과가 문자열로 있어야 한다. -O0 은 선언마다 분석하면서 생성하므로
+        // 분석이 끝나기 전에 파일을 만들지 않도록 메모리에 모았다가 쓴다.
+        std::string result = compile(std::move(source), inputFile);
+        ZUST_PROFILE_SCOPE(scope, "write");
+        OutputBuffer file;
+        file.openFile(outputFile);
+        file << result;
+        file.flush();
+        return;
+    }
+
+    std::unique_ptr<Program> ast = analyze(std::move(source), inputFile);
+    ir::Module lowered;
+    if (options.optimizationLevel >= 2) lowered = lowerToIr(ast.get(), true);
+
+    // 5. 코드 생성: 결과를 메모리에 모으지 않고 청크가 찰 때마다 파일에 쓴다.
+    // 파일은 분석이 성공한 뒤에 만든다. 쓰기 시간도 codegen 구간에 들어간다.
+    ZUST_PROFILE_SCOPE(scope, "codegen");
+    OutputBuffer file;
+    file.openFile(outputFile);
+    CodeGenerator generator(file);
+    if (options.optimizationLevel >= 2) generator.setLowered(&lowered);
+    generator.emit(ast.get());
+    file.flush();
+}
+
+Module ccfn compileToBytecode(SourceBuffer source, const std::string& origin) {
+    std::string key;
+    if (options.cache) {
+        ZUST_PROFILE_SCOPE(scope, "cache");
+        key = CompileCache::key(source.view(), "zbc" + std::to_string(Module::Version), options);
+        std::string cached;
+        if (options.cache->lookup(key, cached)) {
+            try {
+                return Module::deserialize(cached);
+            } catch (const std::exception&) {
+                // 손상된 항목은 다시 만들어서 덮어쓴다
+            }
+        }
+    }
+
+    std::unique_ptr<Program> ast = analyze(std::move(source), origin);
+    Module module;
+    {
+        ZUST_PROFILE_SCOPE(scope, "bytecode");
+        BytecodeCompiler lowering;
+        module = lowering.compile(ast.get());
+    }
+    if (options.cache) {
+        options.cache->store(key, module.serialize());
+    }
+    return module;
+}
+
+void ccfn compileFileToBytecode(const std::string& inputFile, const std::string& outputFile) {
+    std::string result = compileToBytecode(SourceBuffer::map(inputFile), inputFile).serialize();
+
+    OutputBuffer file;
+    file.openFile(outputFile);
+    file << result;
+    file.flush();
+}
+
+void ccfn compileFileToAst(const std::string& inputFile, const std::string& outputFile) {
+    std::string result = AstImage::serialize(parse(SourceBuffer::map(inputFile)).get());
+
+    OutputBuffer file;
+    file.openFile(outputFile);
+    file << result;
+    file.flush();
+}
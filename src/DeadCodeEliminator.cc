@@ -0,0 +1,340 @@
+#include <DeadCodeEliminator.hh>
+#include <ASTNode.hh>
+#include <Nodes.hh>
+#include <Optimizer.hh>
+#include <Program.hh>
+
+#undef ccfn
+#define ccfn DeadCodeEliminator::
+
+using BlockStatement = Node<NodeType::BLOCK_STATEMENT>;
+using IfStatement = Node<NodeType::IF_STATEMENT>;
+using WhileStatement = Node<NodeType::WHILE_STATEMENT>;
+using VariableDeclaration = Node<NodeType::VARIABLE_DECLARATION>;
+using BoolLiteral = Node<NodeType::BOOL_LITERAL>;
+
+// 문장 목록을 제자리에서 줄인다. rewrite 가 nullptr 를 돌려주면 지운다.
+// stopAfter 가 참인 문장 뒤의 문장은 닿을 수 없으므로 모두 지운다. 지운 수를 돌려준다.
+template<typename Rewrite, typename Stop>
+static size_t filterStatements(NodeList<ASTNode*>& list, Rewrite&& rewrite, Stop&& stopAfter) {
+    uint32_t kept = 0;
+    uint32_t i = 0;
+    for (; i < list.count; ++i) {
+        ASTNode* stmt = rewrite(list.items[i]);
+        if (!stmt) continue;
+        list.items[kept++] = stmt;
+        if (stopAfter(stmt)) {
+            ++i;
+            break;
+        }
+    }
+    size_t dropped = list.count - kept;
+    list.count = kept;
+    return dropped;
+}
+
+// 이 문장을 지나면 항상 함수를 빠져나가는가
+static bool terminates(const ASTNode* node) {
+    switch (node->type) {
+        case NodeType::RETURN_STATEMENT:
+            return true;
+        case NodeType::BLOCK_STATEMENT: {
+            auto block = static_cast<const BlockStatement*>(node);
+            return !block->statements.empty() && terminates(block->statements[block->statements.size() - 1]);
+        }
+        case NodeType::IF_STATEMENT: {
+            auto ifStmt = static_cast<const IfStatement*>(node);
+            return ifStmt->elseStatement && terminates(ifStmt->thenStatement) && terminates(ifStmt->elseStatement);
+        }
+        default:
+            return false;
+    }
+}
+
+static inline bool isConstant(const ASTNode* node, bool value) {
+    return node && node->type == NodeType::BOOL_LITERAL && static_cast<const BoolLiteral*>(node)->value == value;
+}
+
+// 블록이 아닌 선언은 if 에서 꺼내면 바깥 스코프에 들어가 버린다
+static inline bool canHoist(const ASTNode* node) {
+    return node->type != NodeType::VARIABLE_DECLARATION && node->type != NodeType::FUNCTION_DECLARATION;
+}
+
+// ===== 닿을 수 없는 문장 =====
+
+ASTNode* ccfn branch(ASTNode* node) {
+    if (node) return node;
+    return arena->make<BlockStatement>();
+}
+
+ASTNode* ccfn trimStatement(ASTNode* node) {
+    switch (node->type) {
+        case NodeType::BLOCK_STATEMENT: {
+            auto block = static_cast<BlockStatement*>(node);
+            removed += filterStatements(block->statements,
+                [this](ASTNode* stmt) { return trimStatement(stmt); }, terminates);
+            return block;
+        }
+        case NodeType::FUNCTION_DECLARATION: {
+            auto func = static_cast<FunctionDeclaration*>(node);
+            if (func->body) func->body = trimStatement(func->body);
+            return func;
+        }
+        case NodeType::NAMESPACE_DECLARATION: {
+            auto ns = static_cast<Node<NodeType::NAMESPACE_DECLARATION>*>(node);
+            if (ns->body) ns->body = trimStatement(ns->body);
+            return ns;
+        }
+        case NodeType::IF_STATEMENT: {
+            auto ifStmt = static_cast<IfStatement*>(node);
+            ASTNode* taken = nullptr;
+            if (isConstant(ifStmt->condition, true)) {
+                taken = ifStmt->thenStatement;
+            } else if (isConstant(ifStmt->condition, false)) {
+                taken = ifStmt->elseStatement;
+                if (!taken) return nullptr;
+            }
+            if (taken && canHoist(taken)) {
+                return trimStatement(taken);
+            }
+            ifStmt->thenStatement = branch(trimStatement(ifStmt->thenStatement));
+            if (ifStmt->elseStatement) {
+                ifStmt->elseStatement = branch(trimStatement(ifStmt->elseStatement));
+            }
+            return ifStmt;
+        }
+        case NodeType::WHILE_STATEMENT: {
+            auto whileStmt = static_cast<WhileStatement*>(node);
+            if (isConstant(whileStmt->condition, false)) return nullptr;
+            whileStmt->body = branch(trimStatement(whileStmt->body));
+            return whileStmt;
+        }
+        default:
+            return node;
+    }
+}
+
+// ===== 도달 가능성 =====
+
+void ccfn collectFunctions(ASTNode* node) {
+    if (!node) return;
+
+    switch (node->type) {
+        case NodeType::FUNCTION_DECLARATION: {
+            auto func = static_cast<FunctionDeclaration*>(node);
+            functions[func->name].push_back(func);
+            collectFunctions(func->body);
+            break;
+        }
+        case NodeType::BLOCK_STATEMENT:
+            for (ASTNode* stmt : static_cast<BlockStatement*>(node)->statements) {
+                collectFunctions(stmt);
+            }
+            break;
+        case NodeType::IF_STATEMENT: {
+            auto ifStmt = static_cast<IfStatement*>(node);
+            collectFunctions(ifStmt->thenStatement);
+            collectFunctions(ifStmt->elseStatement);
+            break;
+        }
+        case NodeType::WHILE_STATEMENT:
+            collectFunctions(static_cast<WhileStatement*>(node)->body);
+            break;
+        case NodeType::NAMESPACE_DECLARATION:
+            collectFunctions(static_cast<Node<NodeType::NAMESPACE_DECLARATION>*>(node)->body);
+            break;
+        default:
+            break;
+    }
+}
+
+void ccfn reach(Name function) {
+    auto found = functions.find(function);
+    if (found == functions.end() || !liveFunctions.insert(function).second) return;
+    for (FunctionDeclaration* func : found->second) {
+        worklist.push_back(func);
+    }
+}
+
+void ccfn markExpression(ASTNode* node) {
+    if (!node) return;
+
+    switch (node->type) {
+        case NodeType::IDENTIFIER: {
+            Name name = static_cast<Node<NodeType::IDENTIFIER>*>(node)->name;
+            referenced.insert(name);
+            reach(name);
+            break;
+        }
+        case NodeType::BINARY_EXPRESSION: {
+            auto binary = static_cast<Node<NodeType::BINARY_EXPRESSION>*>(node);
+            markExpression(binary->left);
+            markExpression(binary->right);
+            break;
+        }
+        case NodeType::UNARY_EXPRESSION:
+            markExpression(static_cast<Node<NodeType::UNARY_EXPRESSION>*>(node)->operand);
+            break;
+        case NodeType::ASSIGNMENT_EXPRESSION: {
+            auto assignment = static_cast<Node<NodeType::ASSIGNMENT_EXPRESSION>*>(node);
+            markExpression(assignment->left);
+            markExpression(assignment->right);
+            break;
+        }
+        case NodeType::CALL_EXPRESSION: {
+            auto call = static_cast<Node<NodeType::CALL_EXPRESSION>*>(node);
+            markExpression(call->callee);
+            for (ASTNode* arg : call->arguments) {
+                markExpression(arg);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void ccfn markStatement(ASTNode* node) {
+    if (!node) return;
+
+    switch (node->type) {
+        case NodeType::VARIABLE_DECLARATION:
+            markExpression(static_cast<VariableDeclaration*>(node)->initializer);
+            break;
+        case NodeType::FUNCTION_DECLARATION:
+            // 본문은 함수가 닿았을 때 worklist 에서 본다
+            break;
+        case NodeType::BLOCK_STATEMENT:
+            for (ASTNode* stmt : static_cast<BlockStatement*>(node)->statements) {
+                markStatement(stmt);
+            }
+            break;
+        case NodeType::IF_STATEMENT: {
+            auto ifStmt = static_cast<IfStatement*>(node);
+            markExpression(ifStmt->condition);
+            markStatement(ifStmt->thenStatement);
+            markStatement(ifStmt->elseStatement);
+            break;
+        }
+        case NodeType::WHILE_STATEMENT: {
+            auto whileStmt = static_cast<WhileStatement*>(node);
+            markExpression(whileStmt->condition);
+            markStatement(whileStmt->body);
+            break;
+        }
+        case NodeType::RETURN_STATEMENT:
+            markExpression(static_cast<Node<NodeType::RETURN_STATEMENT>*>(node)->expression);
+            break;
+        case NodeType::EXPRESSION_STATEMENT:
+            markExpression(static_cast<Node<NodeType::EXPRESSION_STATEMENT>*>(node)->expression);
+            break;
+        case NodeType::NAMESPACE_DECLARATION:
+            markStatement(static_cast<Node<NodeType::NAMESPACE_DECLARATION>*>(node)->body);
+            break;
+        default:
+            break;
+    }
+}
+
+void ccfn markReachable(Program* program) {
+    functions.clear();
+    referenced.clear();
+    liveFunctions.clear();
+    worklist.clear();
+    for (ASTNode* stmt : program->statements) {
+        collectFunctions(stmt);
+    }
+
+    // 시작점: main 과 내보낸 이름. 둘 다 없으면 라이브러리(모듈)로 보고 모든 함수와
+    // 최상위 let 을 남긴다. 가져가는 쪽이 쓸 수 있기 때문이다.
+    reach(names::Main);
+    for (Name name : exports) {
+        reach(name);
+    }
+    if (liveFunctions.empty()) {
+        for (const auto& entry : functions) {
+            reach(entry.first);
+        }
+        for (ASTNode* stmt : program->statements) {
+            if (stmt->type == NodeType::VARIABLE_DECLARATION) {
+                referenced.insert(static_cast<VariableDeclaration*>(stmt)->name);
+            }
+        }
+    }
+
+    // 최상위 문장(전역 let 의 초기값)은 언제나 실행된다
+    for (ASTNode* stmt : program->statements) {
+        markStatement(stmt);
+    }
+    while (!worklist.empty()) {
+        FunctionDeclaration* func = worklist.back();
+        worklist.pop_back();
+        markStatement(func->body);
+    }
+}
+
+// ===== 지우기 =====
+
+ASTNode* ccfn sweepStatement(ASTNode* node) {
+    switch (node->type) {
+        case NodeType::FUNCTION_DECLARATION: {
+            auto func = static_cast<FunctionDeclaration*>(node);
+            if (!liveFunctions.count(func->name)) return nullptr;
+            if (func->body) func->body = sweepStatement(func->body);
+            return func;
+        }
+        case NodeType::VARIABLE_DECLARATION: {
+            auto var = static_cast<VariableDeclaration*>(node);
+            if (!referenced.count(var->name) && (!var->initializer || Optimizer::isPure(var->initializer))) {
+                return nullptr;
+            }
+            return var;
+        }
+        case NodeType::BLOCK_STATEMENT: {
+            auto block = static_cast<BlockStatement*>(node);
+            removed += filterStatements(block->statements,
+                [this](ASTNode* stmt) { return sweepStatement(stmt); },
+                [](const ASTNode*) { return false; });
+            return block;
+        }
+        case NodeType::IF_STATEMENT: {
+            auto ifStmt = static_cast<IfStatement*>(node);
+            ifStmt->thenStatement = branch(sweepStatement(ifStmt->thenStatement));
+            if (ifStmt->elseStatement) {
+                ifStmt->elseStatement = branch(sweepStatement(ifStmt->elseStatement));
+            }
+            return ifStmt;
+        }
+        case NodeType::WHILE_STATEMENT: {
+            auto whileStmt = static_cast<WhileStatement*>(node);
+            whileStmt->body = branch(sweepStatement(whileStmt->body));
+            return whileStmt;
+        }
+        case NodeType::NAMESPACE_DECLARATION: {
+            auto ns = static_cast<Node<NodeType::NAMESPACE_DECLARATION>*>(node);
+            if (ns->body) ns->body = sweepStatement(ns->body);
+            return ns;
+        }
+        default:
+            return node;
+    }
+}
+
+void ccfn eliminate(Program* program) {
+    arena = &program->arena;
+    auto never = [](const ASTNode*) { return false; };
+
+    // 1. return 뒤의 문장과 상수 조건의 죽은 가지
+    removed += filterStatements(program->statements,
+        [this](ASTNode* stmt) { return trimStatement(stmt); }, never);
+
+    // 2. 닿지 않는 함수와 읽히지 않는 let. 하나를 지우면 그것만 쓰던 이름이
+    // 새로 죽을 수 있으므로 더 지울 것이 없을 때까지 반복한다.
+    size_t before;
+    do {
+        before = removed;
+        markReachable(program);
+        removed += filterStatements(program->statements,
+            [this](ASTNode* stmt) { return sweepStatement(stmt); }, never);
+    } while (removed != before);
+}
@@ -0,0 +1,352 @@
+#include <Document.hh>
+#include <Nodes.hh>
+
+#include <algorithm>
+#include <stdexcept>
+
+#undef ccfn
+#define ccfn Document::
+
+using Boundary = Document::Boundary;
+using SegmentKind = Document::SegmentKind;
+
+static inline bool isTrivia(TokenType type) {
+    return type == TokenType::NEWLINE || type == TokenType::COMMENT;
+}
+
+static Token nextSignificant(Lexer& lexer) {
+    Token tok = lexer.next();
+    while (isTrivia(tok.type)) tok = lexer.next();
+    return tok;
+}
+
+// text 를 조각으로 나눠 각 조각의 끝과 종류를 ends 에 넣는다. nested 는 text 가
+// namespace 본문 안에서 시작하는지이고, 끝에서의 값으로 바뀐다. following 은 text
+// 바로 뒤 조각의 첫 토큰으로, 끝의 '}' 뒤에 else 가 이어지는지 보는 데 쓴다.
+// 마지막 조각이 경계에서 끝나면 참을 돌려준다.
+static bool findBoundaries(std::string text, bool& nested, TokenType following, std::vector<Boundary>& ends) {
+    size_t size = text.size();
+    Lexer lexer(std::move(text));
+    int depth = 0;
+    size_t pending = 0;     // 마지막 경계 뒤에 읽은 (공백이 아닌) 토큰 수
+
+    size_t before = lexer.position();
+    Token tok = lexer.next();
+    while (tok.type != TokenType::EOF_TOKEN) {
+        if (isTrivia(tok.type)) {
+            before = lexer.position();
+            tok = lexer.next();
+            continue;
+        }
+
+        // 최상위 "namespace 이름 {" 는 머리 조각으로 끊고 본문을 멤버 단위로 나눈다
+        if (tok.type == TokenType::NAMESPACE && depth == 0 && !nested && pending == 0) {
+            tok = nextSignificant(lexer);
+            if (tok.type == TokenType::IDENTIFIER) tok = nextSignificant(lexer);
+            if (tok.type == TokenType::LBRACE) {
+                nested = true;
+                ends.push_back({lexer.position(), SegmentKind::NAMESPACE_OPEN, false});
+                before = lexer.position();
+                tok = lexer.next();
+                continue;
+            }
+            pending++;
+            continue;
+        }
+
+        bool closes = false;
+        switch (tok.type) {
+            case TokenType::LBRACE:
+                depth++;
+                break;
+            case TokenType::RBRACE:
+                if (depth == 0 && nested) {
+                    // 닫히지 않은 멤버가 있으면 '}' 앞에서 먼저 끊는다
+                    if (pending > 0) ends.push_back({before, SegmentKind::STATEMENTS, true});
+                    nested = false;
+                    pending = 0;
+                    ends.push_back({lexer.position(), SegmentKind::NAMESPACE_CLOSE, true});
+                    before = lexer.position();
+                    tok = lexer.next();
+                    continue;
+                }
+                // 짝 없는 '}' 도 경계로 본다. 파서가 그 조각에서 오류를 낸다.
+                closes = depth == 0 || --depth == 0;
+                break;
+            case TokenType::SEMICOLON:
+                closes = depth == 0;
+                break;
+            default:
+                break;
+        }
+        pending++;
+        if (!closes) {
+            before = lexer.position();
+            tok = lexer.next();
+            continue;
+        }
+
+        size_t end = lexer.position();
+        before = end;
+        tok = nextSignificant(lexer);
+        if (tok.type == TokenType::ELSE) continue;
+        if (tok.type == TokenType::EOF_TOKEN && end == size && following == TokenType::ELSE) break;
+        ends.push_back({end, SegmentKind::STATEMENTS, nested});
+        pending = 0;
+    }
+    return !ends.empty() && ends.back().end == size;
+}
+
+// ===== 조각 =====
+
+Document::Segment ccfn makeSegment(std::string text, const Boundary& boundary) {
+    Segment segment;
+    segment.kind = boundary.kind;
+    segment.nested = boundary.nested;
+    for (char c : text) {
+        if (c == '\n') {
+            segment.newlines++;
+            segment.tail = 0;
+        } else {
+            segment.tail++;
+        }
+    }
+
+    segment.lexer = std::make_unique<Lexer>(std::move(text));
+    segment.tokens = TokenBuffer(*segment.lexer);
+    for (size_t i = 0; i < segment.tokens.size(); ++i) {
+        if (!isTrivia(segment.tokens.type(i))) {
+            segment.lead = segment.tokens.type(i);
+            break;
+        }
+    }
+
+    if (segment.kind == SegmentKind::STATEMENTS) {
+        Parser parser(segment.tokens);
+        segment.program = parser.parse();
+        segment.diagnostics = parser.diagnostics();
+    }
+    reparsed++;
+    return segment;
+}
+
+size_t ccfn segmentAt(size_t offset) const {
+    auto it = std::upper_bound(segments.begin(), segments.end(), offset,
+        [](size_t value, const Segment& segment) { return value < segment.offset; });
+    return static_cast<size_t>(it - segments.begin()) - 1;
+}
+
+void ccfn relocate(size_t first) {
+    for (size_t i = first; i < segments.size(); ++i) {
+        Segment& segment = segments[i];
+        if (i == 0) {
+            segment.offset = 0;
+            segment.line = 1;
+            segment.column = 1;
+            continue;
+        }
+        const Segment& prev = segments[i - 1];
+        segment.offset = prev.offset + prev.text().size();
+        segment.line = prev.line + prev.newlines;
+        segment.column = prev.newlines ? prev.tail + 1 : prev.column + prev.tail;
+    }
+}
+
+// ===== 편집 =====
+
+ccfn Document(std::string text) : length(text.size()) {
+    bool nested = false;
+    std::vector<Boundary> ends;
+    findBoundaries(text, nested, TokenType::EOF_TOKEN, ends);
+    if (ends.empty() || ends.back().end != text.size()) {
+        ends.push_back({text.size(), SegmentKind::STATEMENTS, nested});
+    }
+
+    size_t begin = 0;
+    for (const Boundary& boundary : ends) {
+        segments.push_back(makeSegment(text.substr(begin, boundary.end - begin), boundary));
+        begin = boundary.end;
+    }
+    relocate(0);
+}
+
+void ccfn edit(size_t offset, size_t removed, std::string_view inserted) {
+    if (offset > length || removed > length - offset) {
+        throw std::out_of_range("Edit range is outside the document");
+    }
+    reparsed = 0;
+    assembled.reset();
+
+    // 편집 바로 앞 조각도 넣는다. 그 조각의 끝 '}' 뒤에 else 가 붙을 수 있다.
+    size_t first = segmentAt(offset);
+    if (first > 0) first--;
+    size_t last = segmentAt(offset + removed);
+
+    // 새 경계가 옛 경계와 (namespace 안팎까지) 맞을 때까지 뒤쪽 조각을 두 배씩 넣어 가며
+    // 다시 나눈다
+    std::string text;
+    std::vector<Boundary> ends;
+    bool nested;
+    for (;;) {
+        size_t begin = segments[first].offset;
+        text.clear();
+        for (size_t i = first; i <= last; ++i) {
+            text.append(segments[i].text());
+        }
+        text.replace(offset - begin, removed, inserted);
+
+        bool atEnd = last + 1 == segments.size();
+        TokenType following = atEnd ? TokenType::EOF_TOKEN : segments[last + 1].lead;
+        nested = segments[first].nested;
+        ends.clear();
+        bool clean = findBoundaries(text, nested, following, ends);
+        if (atEnd || (clean && nested == segments[last + 1].nested)) break;
+        last = std::min(segments.size() - 1, last + (last - first + 1));
+    }
+    bool whole = first == 0 && last + 1 == segments.size();
+    if ((ends.empty() || ends.back().end != text.size()) && (!text.empty() || whole)) {
+        ends.push_back({text.size(), SegmentKind::STATEMENTS, nested});
+    }
+
+    // 텍스트와 종류가 그대로인 조각은 앞뒤에서 맞춰서 토큰과 AST 를 그대로 옮긴다
+    auto same = [&](const Segment& segment, size_t piece) {
+        size_t begin = piece == 0 ? 0 : ends[piece - 1].end;
+        return segment.kind == ends[piece].kind && segment.nested == ends[piece].nested &&
+               segment.text() == std::string_view(text).substr(begin, ends[piece].end - begin);
+    };
+    size_t pieces = ends.size();
+    size_t oldCount = last - first + 1;
+    size_t front = 0;
+    while (front < pieces && front < oldCount && same(segments[first + front], front)) {
+        front++;
+    }
+    size_t back = 0;
+    while (back < pieces - front && back < oldCount - front &&
+           same(segments[last - back], pieces - 1 - back)) {
+        back++;
+    }
+
+    std::vector<Segment> fresh;
+    fresh.reserve(pieces - front - back);
+    for (size_t i = front; i < pieces - back; ++i) {
+        size_t begin = i == 0 ? 0 : ends[i - 1].end;
+        fresh.push_back(makeSegment(text.substr(begin, ends[i].end - begin), ends[i]));
+    }
+    auto from = segments.begin() + static_cast<std::ptrdiff_t>(first + front);
+    from = segments.erase(from, from + static_cast<std::ptrdiff_t>(oldCount - front - back));
+    segments.insert(from, std::make_move_iterator(fresh.begin()), std::make_move_iterator(fresh.end()));
+
+    length = length - removed + inserted.size();
+    relocate(first);
+}
+
+void ccfn edit(int startLine, int startColumn, int endLine, int endColumn, std::string_view inserted) {
+    size_t start = offsetOf(startLine, startColumn);
+    size_t end = offsetOf(endLine, endColumn);
+    if (end < start) {
+        throw std::out_of_range("Edit range ends before it starts");
+    }
+    edit(start, end - start, inserted);
+}
+
+// ===== 조회 =====
+
+size_t ccfn offsetOf(int line, int column) const {
+    // (line, column) 이나 그 앞에서 시작하는 마지막 조각
+    auto it = std::upper_bound(segments.begin(), segments.end(), std::make_pair(line, column),
+        [](const std::pair<int, int>& position, const Segment& segment) {
+            return position < std::make_pair(segment.line, segment.column);
+        });
+    const Segment& segment = it == segments.begin() ? segments.front() : *(it - 1);
+
+    // 줄 끝을 넘는 열은 그 줄의 끝으로 맞춘다
+    std::string_view text = segment.text();
+    int l = segment.line, c = segment.column;
+    size_t i = 0;
+    while (i < text.size() && (l < line || (l == line && c < column))) {
+        if (text[i] == '\n') {
+            if (l == line) break;
+            l++;
+            c = 1;
+        } else {
+            c++;
+        }
+        i++;
+    }
+    return segment.offset + i;
+}
+
+std::string ccfn text() const {
+    std::string result;
+    result.reserve(length);
+    for (const Segment& segment : segments) {
+        result.append(segment.text());
+    }
+    return result;
+}
+
+std::vector<Diagnostic> ccfn diagnostics() const {
+    std::vector<Diagnostic> result;
+    for (const Segment& segment : segments) {
+        for (const Diagnostic& diagnostic : segment.diagnostics) {
+            Diagnostic moved = diagnostic;
+            if (moved.line == 1) moved.column += segment.column - 1;
+            moved.line += segment.line - 1;
+            result.push_back(std::move(moved));
+        }
+    }
+
+    // 머리 조각만 있고 닫히지 않은 namespace. 마지막 조각이 이미 입력 끝에서 오류를
+    // 냈으면(닫히지 않은 함수 본문 등) 문서 전체를 파싱할 때처럼 하나만 남긴다.
+    const Segment& end = segments.back();
+    if (end.kind != SegmentKind::NAMESPACE_CLOSE && (end.nested || end.kind == SegmentKind::NAMESPACE_OPEN)) {
+        int line = end.line + end.newlines;
+        int column = end.newlines ? end.tail + 1 : end.column + end.tail;
+        bool reported = !end.diagnostics.empty() && result.back().line == line && result.back().column == column;
+        if (!reported) result.push_back(Diagnostic{line, column, "expected '}' but found end of input"});
+    }
+    return result;
+}
+
+Program* ccfn program() {
+    if (assembled) return assembled.get();
+    assembled = std::make_unique<Program>();
+    AstArena& arena = assembled->arena;
+
+    std::vector<ASTNode*> scratch;
+    Node<NodeType::NAMESPACE_DECLARATION>* ns = nullptr;
+    size_t members = 0;
+    auto close = [&]() {
+        auto block = arena.make<Node<NodeType::BLOCK_STATEMENT>>();
+        block->statements = arena.list(scratch, members);
+        ns->body = block;
+        ns = nullptr;
+    };
+
+    for (const Segment& segment : segments) {
+        switch (segment.kind) {
+            case SegmentKind::NAMESPACE_OPEN:
+                ns = arena.make<Node<NodeType::NAMESPACE_DECLARATION>>();
+                for (size_t i = 0; i < segment.tokens.size(); ++i) {
+                    if (segment.tokens.type(i) == TokenType::IDENTIFIER) {
+                        ns->name = segment.tokens.name(i);
+                        break;
+                    }
+                }
+                scratch.push_back(ns);
+                members = scratch.size();
+                break;
+            case SegmentKind::NAMESPACE_CLOSE:
+                if (ns) close();
+                break;
+            case SegmentKind::STATEMENTS:
+                for (ASTNode* stmt : segment.program->statements) {
+                    scratch.push_back(stmt);
+                }
+                break;
+        }
+    }
+    if (ns) close();
+    assembled->statements = arena.list(scratch, 0);
+    return assembled.get();
+}
@@ -0,0 +1,159 @@
+#include <Driver.hh>
+#include <Compiler.hh>
+#include <Profiler.hh>
+#include <ThreadPool.hh>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+#include <unordered_set>
+
+#undef ccfn
+#define ccfn Driver::
+
+namespace fs = std::filesystem;
+
+static size_t parseThreadCount(const std::string& value) {
+    size_t used = 0;
+    unsigned long n = 0;
+    try {
+        n = std::stoul(value, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used == 0 || used != value.size() || n == 0) {
+        throw std::runtime_error("Invalid thread count: " + value);
+    }
+    return n;
+}
+
+DriverOptions ccfn parseArguments(int argc, char* argv[]) {
+    DriverOptions options;
+    for (int i = 0; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-j" || arg == "-o") {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("Missing value for " + arg);
+            }
+            if (arg == "-o") {
+                options.outputDir = argv[++i];
+            } else {
+                options.threads = parseThreadCount(argv[++i]);
+            }
+        } else if (arg.rfind("-j", 0) == 0) {
+            options.threads = parseThreadCount(arg.substr(2));   // -j8
+        } else {
+            options.inputs.push_back(arg);
+        }
+    }
+    if (options.inputs.empty()) {
+        throw std::runtime_error("No input files");
+    }
+    return options;
+}
+
+bool ccfn isBatchInput(const std::string& path) {
+    std::error_code ec;
+    return (!path.empty() && path[0] == '@') || fs::is_directory(path, ec);
+}
+
+bool ccfn isSourceFile(const std::string& path) {
+    fs::path extension = fs::path(path).extension();
+    return extension == ".zs" || extension == ".zast";
+}
+
+std::vector<CompileJob> ccfn collect(const DriverOptions& options) {
+    std::vector<CompileJob> jobs;
+    std::unordered_set<std::string> outputs;
+
+    // relative 는 출력 디렉터리 아래에 놓일 상대 경로
+    auto add = [&](const fs::path& input, fs::path relative) {
+        relative.replace_extension(".cpp");
+        fs::path output = options.outputDir.empty()
+            ? fs::path(input).replace_extension(".cpp")
+            : fs::path(options.outputDir) / relative;
+        if (!outputs.insert(output.string()).second) {
+            throw std::runtime_error("Two inputs map to the same output: " + output.string());
+        }
+        jobs.push_back(CompileJob{input.string(), output.string()});
+    };
+
+    for (const std::string& input : options.inputs) {
+        if (!input.empty() && input[0] == '@') {
+            std::ifstream manifest(input.substr(1));
+            if (!manifest) {
+                throw std::runtime_error("Cannot open manifest: " + input.substr(1));
+            }
+            std::string line;
+            while (std::getline(manifest, line)) {
+                while (!line.empty() && (line.back() == '\r' || line.back() == ' ')) line.pop_back();
+                if (line.empty() || line[0] == '#') continue;
+                add(line, fs::path(line).filename());
+            }
+        } else if (fs::is_directory(input)) {
+            std::vector<fs::path> found;
+            for (const auto& entry : fs::recursive_directory_iterator(input)) {
+                if (entry.is_regular_file() && entry.path().extension() == ".zs") {
+                    found.push_back(entry.path());
+                }
+            }
+            // 디렉터리 순회 순서는 정해져 있지 않으므로 정렬해서 출력을 재현 가능하게 한다
+            std::sort(found.begin(), found.end());
+            for (const auto& path : found) {
+                add(path, path.lexically_relative(input));
+            }
+        } else {
+            add(input, fs::path(input).filename());
+        }
+    }
+    return jobs;
+}
+
+size_t ccfn run(const std::vector<CompileJob>& jobs, size_t threads, std::ostream& err) {
+    std::vector<std::string> errors(jobs.size());
+
+    // 큰 파일부터 넣어야 마지막에 큰 파일 하나만 남아 도는 일이 줄어든다
+    std::vector<size_t> order(jobs.size());
+    std::vector<uintmax_t> sizes(jobs.size());
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        std::error_code ec;
+        order[i] = i;
+        sizes[i] = fs::file_size(jobs[i].input, ec);
+        if (ec) sizes[i] = 0;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sizes[a] > sizes[b]; });
+
+    {
+        ThreadPool pool(std::min(threads ? threads : std::thread::hardware_concurrency(),
+                                 static_cast<size_t>(std::max<size_t>(jobs.size(), 1))));
+        for (size_t i : order) {
+            pool.submit([this, &jobs, &errors, i] {
+                const CompileJob& job = jobs[i];
+                ZUST_PROFILE_SCOPE(scope, "file", job.input);
+                try {
+                    fs::path parent = fs::path(job.output).parent_path();
+                    if (!parent.empty()) {
+                        fs::create_directories(parent);
+                    }
+                    Compiler compiler(compilerOptions);
+                    compiler.compileFile(job.input, job.output);
+                } catch (const std::exception& e) {
+                    errors[i] = e.what();
+                    if (errors[i].empty()) errors[i] = "unknown error";
+                }
+            });
+        }
+        pool.wait();
+    }
+
+    size_t failed = 0;
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        if (!errors[i].empty()) {
+            err << "Error: " << jobs[i].input << ": " << errors[i] << "\n";
+            ++failed;
+        }
+    }
+    return failed;
+}
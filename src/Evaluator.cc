@@ -0,0 +1,928 @@
+#include <Evaluator.hh>
+#include <ASTNode.hh>
+#include <Nodes.hh>
+#include <Program.hh>
+#include <Type.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+#include <process.h>
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#undef ccfn
+#define ccfn Evaluator::
+
+using namespace eval;
+
+using FunctionDeclaration = Node<NodeType::FUNCTION_DECLARATION>;
+using VariableDeclaration = Node<NodeType::VARIABLE_DECLARATION>;
+using BlockStatement = Node<NodeType::BLOCK_STATEMENT>;
+using Identifier = Node<NodeType::IDENTIFIER>;
+
+namespace {
+
+// 분석기의 타입을 실행 시간 표현으로. bool 과 auto 는 정수로 다룬다.
+Kind kindOf(const Type* type) {
+    if (!type) return Kind::INT;
+    if (type->kind == Type::VOID) return Kind::VOID;
+    if (type->isFloating()) return Kind::FLOAT;
+    if (type == &types::String) return Kind::STRING;
+    return Kind::INT;
+}
+
+Kind kindOf(Name spelling) {
+    if (spelling.empty()) return Kind::INT;
+    return kindOf(TypeTable::global().fromName(spelling));
+}
+
+// ===== 연산자 =====
+// Zust int 는 C++ 백엔드와 상수 접기처럼 32비트다. 정수 산술은 32비트 2의 보수로 감싸서
+// 오버플로가 정의되지 않은 동작이 되지 않고 컴파일한 C++ 과 같은 값이 나오게 한다.
+inline int64_t wrap32(uint64_t value) { return static_cast<int32_t>(static_cast<uint32_t>(value)); }
+
+struct Add {
+    int64_t operator()(int64_t a, int64_t b) const { return wrap32(static_cast<uint64_t>(a) + static_cast<uint64_t>(b)); }
+    double operator()(double a, double b) const { return a + b; }
+};
+struct Sub {
+    int64_t operator()(int64_t a, int64_t b) const { return wrap32(static_cast<uint64_t>(a) - static_cast<uint64_t>(b)); }
+    double operator()(double a, double b) const { return a - b; }
+};
+struct Mul {
+    int64_t operator()(int64_t a, int64_t b) const { return wrap32(static_cast<uint64_t>(a) * static_cast<uint64_t>(b)); }
+    double operator()(double a, double b) const { return a * b; }
+};
+struct Div {
+    int64_t operator()(int64_t a, int64_t b) const {
+        if (b == 0) throw std::runtime_error("Division by zero");
+        return b == -1 ? Sub{}(0, a) : a / b;
+    }
+    double operator()(double a, double b) const { return a / b; }
+};
+struct Mod {
+    int64_t operator()(int64_t a, int64_t b) const {
+        if (b == 0) throw std::runtime_error("Division by zero");
+        return b == -1 ? 0 : a % b;
+    }
+    double operator()(double a, double b) const { return std::fmod(a, b); }
+};
+struct BitAnd { int64_t operator()(int64_t a, int64_t b) const { return a & b; } };
+struct BitOr { int64_t operator()(int64_t a, int64_t b) const { return a | b; } };
+struct BitXor { int64_t operator()(int64_t a, int64_t b) const { return a ^ b; } };
+struct Shl { int64_t operator()(int64_t a, int64_t b) const { return wrap32(static_cast<uint64_t>(a) << (b & 31)); } };
+struct Shr { int64_t operator()(int64_t a, int64_t b) const { return a >> (b & 31); } };
+struct Eq { template<typename T> int64_t operator()(T a, T b) const { return a == b; } };
+struct Ne { template<typename T> int64_t operator()(T a, T b) const { return a != b; } };
+struct Lt { template<typename T> int64_t operator()(T a, T b) const { return a < b; } };
+struct Le { template<typename T> int64_t operator()(T a, T b) const { return a <= b; } };
+struct Gt { template<typename T> int64_t operator()(T a, T b) const { return a > b; } };
+struct Ge { template<typename T> int64_t operator()(T a, T b) const { return a >= b; } };
+
+FloatCode toFloat(Code code) {
+    if (code.kind == Kind::FLOAT) return std::move(code.f);
+    if (code.kind == Kind::INT) {
+        return [i = std::move(code.i)](Frame& f) { return static_cast<double>(i(f)); };
+    }
+    throw std::runtime_error("Expected a numeric value");
+}
+
+IntCode toInt(Code code) {
+    if (code.kind == Kind::INT) return std::move(code.i);
+    throw std::runtime_error("Expected an integer value");
+}
+
+StringCode toString(Code code) {
+    if (code.kind == Kind::STRING) return std::move(code.s);
+    throw std::runtime_error("Expected a string value");
+}
+
+// 식을 값 없이 실행하는 클로저
+StmtCode discard(Code code) {
+    switch (code.kind) {
+        case Kind::INT: return [c = std::move(code.i)](Frame& f) { c(f); return Flow::NEXT; };
+        case Kind::FLOAT: return [c = std::move(code.f)](Frame& f) { c(f); return Flow::NEXT; };
+        case Kind::STRING: return [c = std::move(code.s)](Frame& f) { c(f); return Flow::NEXT; };
+        default: return std::move(code.v);
+    }
+}
+
+Code intCode(IntCode i) {
+    Code code;
+    code.kind = Kind::INT;
+    code.i = std::move(i);
+    return code;
+}
+
+Code floatCode(FloatCode f) {
+    Code code;
+    code.kind = Kind::FLOAT;
+    code.f = std::move(f);
+    return code;
+}
+
+Code stringCode(StringCode s) {
+    Code code;
+    code.kind = Kind::STRING;
+    code.s = std::move(s);
+    return code;
+}
+
+}
+
+// ===== 깊은 재귀용 스택 =====
+// 큰 스택을 가진 작업 스레드 하나. call() 은 body 를 그 스레드에서 돌리고 끝날 때까지 기다리며,
+// 던진 예외는 부른 쪽에서 다시 던진다. 스레드를 못 만들면 지금 스택에서 돈다.
+class Evaluator::DeepStack {
+private:
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const std::function<void()>* task = nullptr;
+    std::exception_ptr error;
+    bool finished = false;
+    bool quit = false;
+    bool started = false;
+#if defined(_WIN32)
+    HANDLE thread = nullptr;
+
+    static unsigned __stdcall entry(void* self) {
+        static_cast<DeepStack*>(self)->loop();
+        return 0;
+    }
+#else
+    pthread_t thread;
+
+    static void* entry(void* self) {
+        static_cast<DeepStack*>(self)->loop();
+        return nullptr;
+    }
+#endif
+
+    void loop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, [this] { return task || quit; });
+            if (quit) return;
+            const std::function<void()>* body = task;
+            task = nullptr;
+            lock.unlock();
+            std::exception_ptr thrown;
+            try {
+                (*body)();
+            } catch (...) {
+                thrown = std::current_exception();
+            }
+            lock.lock();
+            error = thrown;
+            finished = true;
+            done.notify_one();
+        }
+    }
+
+public:
+    explicit DeepStack(size_t bytes) {
+#if defined(_WIN32)
+        uintptr_t handle = _beginthreadex(nullptr, static_cast<unsigned>(bytes), entry, this,
+                                          STACK_SIZE_PARAM_IS_A_RESERVATION, nullptr);
+        thread = reinterpret_cast<HANDLE>(handle);
+        started = handle != 0;
+#else
+        pthread_attr_t attr;
+        if (pthread_attr_init(&attr) == 0) {
+            started = pthread_attr_setstacksize(&attr, bytes) == 0 &&
+                      pthread_create(&thread, &attr, entry, this) == 0;
+            pthread_attr_destroy(&attr);
+        }
+#endif
+    }
+
+    ~DeepStack() {
+        if (!started) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            quit = true;
+        }
+        wake.notify_one();
+#if defined(_WIN32)
+        WaitForSingleObject(thread, INFINITE);
+        CloseHandle(thread);
+#else
+        pthread_join(thread, nullptr);
+#endif
+    }
+
+    void call(const std::function<void()>& body) {
+        if (!started) {
+            body();
+            return;
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        task = &body;
+        finished = false;
+        wake.notify_one();
+        done.wait(lock, [this] { return finished; });
+        if (error) std::rethrow_exception(std::exchange(error, nullptr));
+    }
+};
+
+ccfn Evaluator(bool count) : countNodes(count) {
+    segments.push_back(Segment{std::make_unique<Slot[]>(SegmentSlots), SegmentSlots});
+}
+
+ccfn ~Evaluator() = default;
+
+// ===== 노드 수 세기 =====
+
+Code ccfn counted(Code code, uint32_t weight) {
+    if (!countNodes) return code;
+    uint64_t* n = &nodes;
+    switch (code.kind) {
+        case Kind::INT:
+            code.i = [n, weight, c = std::move(code.i)](Frame& f) { *n += weight; return c(f); };
+            break;
+        case Kind::FLOAT:
+            code.f = [n, weight, c = std::move(code.f)](Frame& f) { *n += weight; return c(f); };
+            break;
+        case Kind::STRING:
+            code.s = [n, weight, c = std::move(code.s)](Frame& f) { *n += weight; return c(f); };
+            break;
+        case Kind::VOID:
+            code.v = [n, weight, c = std::move(code.v)](Frame& f) { *n += weight; return c(f); };
+            break;
+    }
+    return code;
+}
+
+StmtCode ccfn counted(StmtCode code) {
+    if (!countNodes) return code;
+    return [n = &nodes, c = std::move(code)](Frame& f) { ++*n; return c(f); };
+}
+
+// ===== 지역 변수 =====
+
+uint32_t ccfn declareLocal(Name name, Kind kind) {
+    uint32_t index = kind == Kind::STRING ? nextString++ : nextSlot++;
+    if (nextSlot > current->numSlots) current->numSlots = nextSlot;
+    if (nextString > current->numStrings) current->numStrings = nextString;
+    locals.push_back(Local{name, kind, index});
+    return index;
+}
+
+const Evaluator::Local* ccfn findLocal(Name name) const {
+    for (size_t i = locals.size(); i-- > 0;) {
+        if (locals[i].name == name) return &locals[i];
+    }
+    return nullptr;
+}
+
+void ccfn pushScope() {
+    scopes.push_back(Scope{locals.size(), nextSlot, nextString});
+}
+
+void ccfn popScope() {
+    locals.resize(scopes.back().locals);
+    nextSlot = scopes.back().slots;
+    nextString = scopes.back().strings;
+    scopes.pop_back();
+}
+
+// ===== 식 =====
+
+IntCode ccfn asInt(ASTNode* node) { return toInt(compileExpression(node)); }
+FloatCode ccfn asFloat(ASTNode* node) { return toFloat(compileExpression(node)); }
+StringCode ccfn asString(ASTNode* node) { return toString(compileExpression(node)); }
+
+Code ccfn compileExpression(ASTNode* node) {
+    switch (node->type) {
+        case NodeType::INTEGER_LITERAL: {
+            int64_t value = static_cast<Node<NodeType::INTEGER_LITERAL>*>(node)->value;
+            return counted(intCode([value](Frame&) { return value; }));
+        }
+        case NodeType::BOOL_LITERAL: {
+            int64_t value = static_cast<Node<NodeType::BOOL_LITERAL>*>(node)->value ? 1 : 0;
+            return counted(intCode([value](Frame&) { return value; }));
+        }
+        case NodeType::FLOAT_LITERAL: {
+            double value = static_cast<Node<NodeType::FLOAT_LITERAL>*>(node)->value;
+            return counted(floatCode([value](Frame&) { return value; }));
+        }
+        case NodeType::STRING_LITERAL: {
+            std::string value(static_cast<Node<NodeType::STRING_LITERAL>*>(node)->value);
+            return counted(stringCode([value](Frame&) { return value; }));
+        }
+        case NodeType::IDENTIFIER: {
+            Name name = static_cast<Identifier*>(node)->name;
+            if (const Local* local = findLocal(name)) {
+                uint32_t index = local->index;
+                switch (local->kind) {
+                    case Kind::FLOAT: return counted(floatCode([index](Frame& f) { return f.slots[index].f; }));
+                    case Kind::STRING: return counted(stringCode([index](Frame& f) { return f.strings[index]; }));
+                    default: return counted(intCode([index](Frame& f) { return f.slots[index].i; }));
+                }
+            }
+            auto global = globalByName.find(name);
+            if (global == globalByName.end()) {
+                throw std::runtime_error("Undefined variable: " + std::string(name.str()));
+            }
+            uint32_t index = global->second.index;
+            switch (global->second.kind) {
+                case Kind::FLOAT: {
+                    const Slot* slot = &globals[index];
+                    return counted(floatCode([slot](Frame&) { return slot->f; }));
+                }
+                case Kind::STRING: {
+                    const std::string* s = &globalStrings[index];
+                    return counted(stringCode([s](Frame&) { return *s; }));
+                }
+                default: {
+                    const Slot* slot = &globals[index];
+                    return counted(intCode([slot](Frame&) { return slot->i; }));
+                }
+            }
+        }
+        case NodeType::BINARY_EXPRESSION:
+            return counted(compileBinary(static_cast<Node<NodeType::BINARY_EXPRESSION>*>(node)));
+        case NodeType::UNARY_EXPRESSION: {
+            auto unary = static_cast<Node<NodeType::UNARY_EXPRESSION>*>(node);
+            Code operand = compileExpression(unary->operand);
+            switch (unary->operator_) {
+                case TokenType::MINUS:
+                    if (operand.kind == Kind::FLOAT) {
+                        return counted(floatCode([c = std::move(operand.f)](Frame& f) { return -c(f); }));
+                    }
+                    return counted(intCode([c = toInt(std::move(operand))](Frame& f) { return Sub{}(0, c(f)); }));
+                case TokenType::LOGICAL_NOT:
+                    return counted(intCode([c = toInt(std::move(operand))](Frame& f) -> int64_t { return !c(f); }));
+                case TokenType::BIT_NOT:
+                    return counted(intCode([c = toInt(std::move(operand))](Frame& f) { return ~c(f); }));
+                default:
+                    return operand;
+            }
+        }
+        case NodeType::ASSIGNMENT_EXPRESSION:
+            return counted(compileAssignment(static_cast<Node<NodeType::ASSIGNMENT_EXPRESSION>*>(node)));
+        case NodeType::CALL_EXPRESSION:
+            return counted(compileCall(static_cast<Node<NodeType::CALL_EXPRESSION>*>(node)));
+        default:
+            throw std::runtime_error("Unsupported expression in evaluator");
+    }
+}
+
+Code ccfn compileBinary(Node<NodeType::BINARY_EXPRESSION>* binary) {
+    TokenType op = binary->operator_;
+
+    if (op == TokenType::LOGICAL_AND) {
+        return intCode([l = asInt(binary->left), r = asInt(binary->right)](Frame& f) -> int64_t {
+            return l(f) && r(f);
+        });
+    }
+    if (op == TokenType::LOGICAL_OR) {
+        return intCode([l = asInt(binary->left), r = asInt(binary->right)](Frame& f) -> int64_t {
+            return l(f) || r(f);
+        });
+    }
+
+    // 정수 지역 변수와 정수 상수의 연산 (i < n, n - 1 ...) 은 자식 클로저 없이 한 번에 처리한다
+    const Local* leftLocal = binary->left->type == NodeType::IDENTIFIER
+        ? findLocal(static_cast<Identifier*>(binary->left)->name) : nullptr;
+    if (leftLocal && leftLocal->kind == Kind::INT && binary->right->type == NodeType::INTEGER_LITERAL) {
+        uint32_t index = leftLocal->index;
+        int64_t k = static_cast<Node<NodeType::INTEGER_LITERAL>*>(binary->right)->value;
+        auto fused = [&](auto opfn) -> Code {
+            using Op = decltype(opfn);
+            return counted(intCode([index, k](Frame& f) -> int64_t { return Op{}(f.slots[index].i, k); }), 2);
+        };
+        switch (op) {
+            case TokenType::PLUS: return fused(Add{});
+            case TokenType::MINUS: return fused(Sub{});
+            case TokenType::MULTIPLY: return fused(Mul{});
+            case TokenType::DIVIDE: return fused(Div{});
+            case TokenType::MODULO: return fused(Mod{});
+            case TokenType::LESS: return fused(Lt{});
+            case TokenType::LESS_EQUAL: return fused(Le{});
+            case TokenType::GREATER: return fused(Gt{});
+            case TokenType::GREATER_EQUAL: return fused(Ge{});
+            case TokenType::EQUAL: return fused(Eq{});
+            case TokenType::NOT_EQUAL: return fused(Ne{});
+            default: break;
+        }
+    }
+
+    Code left = compileExpression(binary->left);
+    Code right = compileExpression(binary->right);
+
+    if (left.kind == Kind::STRING && right.kind == Kind::STRING) {
+        StringCode l = std::move(left.s), r = std::move(right.s);
+        switch (op) {
+            case TokenType::PLUS:
+                return stringCode([l, r](Frame& f) { std::string a = l(f); return a + r(f); });
+            case TokenType::EQUAL:
+                return intCode([l, r](Frame& f) -> int64_t { std::string a = l(f); return a == r(f); });
+            case TokenType::NOT_EQUAL:
+                return intCode([l, r](Frame& f) -> int64_t { std::string a = l(f); return a != r(f); });
+            default:
+                throw std::runtime_error("Unsupported string operator in evaluator");
+        }
+    }
+
+    // 피연산자는 항상 왼쪽부터 평가한다
+    if (left.kind == Kind::FLOAT || right.kind == Kind::FLOAT) {
+        FloatCode l = toFloat(std::move(left)), r = toFloat(std::move(right));
+        auto arith = [&](auto opfn) -> Code {
+            using Op = decltype(opfn);
+            return floatCode([l, r](Frame& f) { double a = l(f); return Op{}(a, r(f)); });
+        };
+        auto compare = [&](auto opfn) -> Code {
+            using Op = decltype(opfn);
+            return intCode([l, r](Frame& f) { double a = l(f); return Op{}(a, r(f)); });
+        };
+        switch (op) {
+            case TokenType::PLUS: return arith(Add{});
+            case TokenType::MINUS: return arith(Sub{});
+            case TokenType::MULTIPLY: return arith(Mul{});
+            case TokenType::DIVIDE: return arith(Div{});
+            case TokenType::MODULO: return arith(Mod{});
+            case TokenType::LESS: return compare(Lt{});
+            case TokenType::LESS_EQUAL: return compare(Le{});
+            case TokenType::GREATER: return compare(Gt{});
+            case TokenType::GREATER_EQUAL: return compare(Ge{});
+            case TokenType::EQUAL: return compare(Eq{});
+            case TokenType::NOT_EQUAL: return compare(Ne{});
+            default: throw std::runtime_error("Unsupported floating operator in evaluator");
+        }
+    }
+
+    IntCode l = toInt(std::move(left)), r = toInt(std::move(right));
+    auto ints = [&](auto opfn) -> Code {
+        using Op = decltype(opfn);
+        return intCode([l, r](Frame& f) -> int64_t { int64_t a = l(f); return Op{}(a, r(f)); });
+    };
+    switch (op) {
+        case TokenType::PLUS: return ints(Add{});
+        case TokenType::MINUS: return ints(Sub{});
+        case TokenType::MULTIPLY: return ints(Mul{});
+        case TokenType::DIVIDE: return ints(Div{});
+        case TokenType::MODULO: return ints(Mod{});
+        case TokenType::BIT_AND: return ints(BitAnd{});
+        case TokenType::BIT_OR: return ints(BitOr{});
+        case TokenType::BIT_XOR: return ints(BitXor{});
+        case TokenType::LEFT_SHIFT: return ints(Shl{});
+        case TokenType::RIGHT_SHIFT: return ints(Shr{});
+        case TokenType::LESS: return ints(Lt{});
+        case TokenType::LESS_EQUAL: return ints(Le{});
+        case TokenType::GREATER: return ints(Gt{});
+        case TokenType::GREATER_EQUAL: return ints(Ge{});
+        case TokenType::EQUAL: return ints(Eq{});
+        case TokenType::NOT_EQUAL: return ints(Ne{});
+        default: throw std::runtime_error("Unsupported operator in evaluator");
+    }
+}
+
+Code ccfn compileAssignment(Node<NodeType::ASSIGNMENT_EXPRESSION>* assignment) {
+    if (assignment->left->type != NodeType::IDENTIFIER) {
+        throw std::runtime_error("Invalid assignment target");
+    }
+    Name name = static_cast<Identifier*>(assignment->left)->name;
+
+    Kind kind;
+    Slot* slot = nullptr;
+    std::string* string = nullptr;
+    uint32_t index = 0;
+    if (const Local* local = findLocal(name)) {
+        kind = local->kind;
+        index = local->index;
+    } else {
+        auto global = globalByName.find(name);
+        if (global == globalByName.end()) {
+            throw std::runtime_error("Undefined variable: " + std::string(name.str()));
+        }
+        kind = global->second.kind;
+        if (kind == Kind::STRING) string = &globalStrings[global->second.index];
+        else slot = &globals[global->second.index];
+    }
+    bool isGlobal = slot || string;
+
+    switch (kind) {
+        case Kind::FLOAT: {
+            FloatCode value = asFloat(assignment->right);
+            if (isGlobal) return floatCode([slot, value](Frame& f) { return slot->f = value(f); });
+            return floatCode([index, value](Frame& f) { return f.slots[index].f = value(f); });
+        }
+        case Kind::STRING: {
+            StringCode value = asString(assignment->right);
+            if (isGlobal) return stringCode([string, value](Frame& f) { return *string = value(f); });
+            return stringCode([index, value](Frame& f) { return f.strings[index] = value(f); });
+        }
+        default: {
+            IntCode value = asInt(assignment->right);
+            if (isGlobal) return intCode([slot, value](Frame& f) { return slot->i = value(f); });
+            return intCode([index, value](Frame& f) { return f.slots[index].i = value(f); });
+        }
+    }
+}
+
+Slot* ccfn allocate(uint32_t count) {
+    if (static_cast<size_t>(limit - top) < count) {
+        // 다음 조각으로. 그 뒤의 조각은 아무 프레임도 쓰지 않으므로 작으면 바꿔도 된다.
+        ++segment;
+        size_t size = std::max<size_t>(SegmentSlots, count);
+        if (segment == segments.size()) {
+            segments.push_back(Segment{std::make_unique<Slot[]>(size), size});
+        } else if (segments[segment].size < count) {
+            segments[segment] = Segment{std::make_unique<Slot[]>(size), size};
+        }
+        top = segments[segment].slots.get();
+        limit = top + segments[segment].size;
+    }
+    Slot* base = top;
+    top += count;
+    return base;
+}
+
+void ccfn enter(const Function* fn, const std::vector<Code>& args, Frame& caller, Frame& callee) {
+    if (depth >= MaxDepth) {
+        throw std::runtime_error("Stack overflow in function: " + fn->name);
+    }
+
+    // 인자를 평가하는 동안 불리는 함수가 이 프레임을 덮어쓰지 않도록 먼저 자리를 잡는다
+    Slot* savedTop = top;
+    Slot* savedLimit = limit;
+    size_t savedSegment = segment;
+    Slot* base = allocate(fn->numSlots);
+    for (size_t i = 0; i < args.size(); ++i) {
+        uint32_t index = fn->paramIndex[i];
+        switch (fn->paramKinds[i]) {
+            case Kind::FLOAT: base[index].f = args[i].f(caller); break;
+            case Kind::STRING: callee.strings[index] = args[i].s(caller); break;
+            default: base[index].i = args[i].i(caller); break;
+        }
+    }
+
+    callee.slots = base;
+    ++depth;
+    if (depth == HandoffDepth && !deep) {
+        // 여기서부터는 큰 스택에서. 돌아오면(던져도) 다시 지금 스레드다.
+        if (!deepStack) deepStack = std::make_unique<DeepStack>(DeepStackBytes);
+        deep = true;
+        try {
+            deepStack->call([fn, &callee] { fn->body(callee); });
+        } catch (...) {
+            deep = false;
+            throw;
+        }
+        deep = false;
+    } else {
+        fn->body(callee);
+    }
+    --depth;
+    top = savedTop;
+    limit = savedLimit;
+    segment = savedSegment;
+}
+
+Code ccfn compileCall(Node<NodeType::CALL_EXPRESSION>* call) {
+    if (call->callee->type != NodeType::IDENTIFIER) {
+        throw std::runtime_error("Only direct calls are supported in the evaluator");
+    }
+    Name name = static_cast<Identifier*>(call->callee)->name;
+    auto it = functionByName.find(name);
+    if (it == functionByName.end()) {
+        throw std::runtime_error("Undefined function: " + std::string(name.str()));
+    }
+    const Function* fn = it->second;
+    if (call->arguments.size() != fn->paramKinds.size()) {
+        throw std::runtime_error("Argument count mismatch for function: " + fn->name);
+    }
+
+    std::vector<Code> args;
+    args.reserve(call->arguments.size());
+    for (size_t i = 0; i < call->arguments.size(); ++i) {
+        Code arg = compileExpression(call->arguments[i]);
+        switch (fn->paramKinds[i]) {
+            case Kind::FLOAT: args.push_back(floatCode(toFloat(std::move(arg)))); break;
+            case Kind::STRING: args.push_back(stringCode(toString(std::move(arg)))); break;
+            default: args.push_back(intCode(toInt(std::move(arg)))); break;
+        }
+    }
+
+    // 문자열 지역 변수가 없는 함수는 힙 할당 없이 호출된다
+    switch (fn->returnKind) {
+        case Kind::FLOAT:
+            return floatCode([this, fn, args](Frame& f) {
+                std::vector<std::string> strings(fn->numStrings);
+                Frame callee{nullptr, strings.data(), {}, {}};
+                enter(fn, args, f, callee);
+                return callee.result.f;
+            });
+        case Kind::STRING:
+            return stringCode([this, fn, args](Frame& f) {
+                std::vector<std::string> strings(fn->numStrings);
+                Frame callee{nullptr, strings.data(), {}, {}};
+                enter(fn, args, f, callee);
+                return std::move(callee.resultString);
+            });
+        case Kind::VOID: {
+            Code code;
+            code.v = [this, fn, args](Frame& f) {
+                std::vector<std::string> strings(fn->numStrings);
+                Frame callee{nullptr, strings.data(), {}, {}};
+                enter(fn, args, f, callee);
+                return Flow::NEXT;
+            };
+            return code;
+        }
+        default:
+            return intCode([this, fn, args](Frame& f) {
+                std::vector<std::string> strings(fn->numStrings);
+                Frame callee{nullptr, strings.data(), {}, {}};
+                enter(fn, args, f, callee);
+                return callee.result.i;
+            });
+    }
+}
+
+// ===== 문장 =====
+
+StmtCode ccfn store(Kind kind, bool global, uint32_t index, ASTNode* value) {
+    switch (kind) {
+        case Kind::FLOAT: {
+            FloatCode code = value ? asFloat(value) : FloatCode([](Frame&) { return 0.0; });
+            if (global) return [slot = &globals[index], code](Frame& f) { slot->f = code(f); return Flow::NEXT; };
+            return [index, code](Frame& f) { f.slots[index].f = code(f); return Flow::NEXT; };
+        }
+        case Kind::STRING: {
+            StringCode code = value ? asString(value) : StringCode([](Frame&) { return std::string(); });
+            if (global) return [s = &globalStrings[index], code](Frame& f) { *s = code(f); return Flow::NEXT; };
+            return [index, code](Frame& f) { f.strings[index] = code(f); return Flow::NEXT; };
+        }
+        default: {
+            IntCode code = value ? asInt(value) : IntCode([](Frame&) -> int64_t { return 0; });
+            if (global) return [slot = &globals[index], code](Frame& f) { slot->i = code(f); return Flow::NEXT; };
+            return [index, code](Frame& f) { f.slots[index].i = code(f); return Flow::NEXT; };
+        }
+    }
+}
+
+StmtCode ccfn compileStatement(ASTNode* node) {
+    if (!node) return [](Frame&) { return Flow::NEXT; };
+
+    switch (node->type) {
+        case NodeType::VARIABLE_DECLARATION: {
+            auto var = static_cast<VariableDeclaration*>(node);
+            Kind kind = kindOf(var->dataType);
+            if (kind == Kind::VOID) kind = Kind::INT;
+            // 초기화 식을 먼저 컴파일해야 같은 이름의 바깥 변수를 가리킨다
+            uint32_t index = kind == Kind::STRING ? nextString : nextSlot;
+            StmtCode code = store(kind, false, index, var->initializer);
+            declareLocal(var->name, kind);
+            return counted(std::move(code));
+        }
+        case NodeType::FUNCTION_DECLARATION:
+        case NodeType::NAMESPACE_DECLARATION:
+            // 함수는 collect 에서 모두 끌어올렸다
+            return [](Frame&) { return Flow::NEXT; };
+        case NodeType::BLOCK_STATEMENT: {
+            pushScope();
+            std::vector<StmtCode> statements;
+            for (ASTNode* stmt : static_cast<BlockStatement*>(node)->statements) {
+                if (stmt->type == NodeType::FUNCTION_DECLARATION || stmt->type == NodeType::NAMESPACE_DECLARATION) continue;
+                statements.push_back(compileStatement(stmt));
+            }
+            popScope();
+            if (statements.size() == 1) return std::move(statements[0]);
+            return [statements = std::move(statements)](Frame& f) {
+                for (const auto& stmt : statements) {
+                    if (stmt(f) == Flow::RETURN) return Flow::RETURN;
+                }
+                return Flow::NEXT;
+            };
+        }
+        case NodeType::IF_STATEMENT: {
+            auto ifStmt = static_cast<Node<NodeType::IF_STATEMENT>*>(node);
+            IntCode condition = asInt(ifStmt->condition);
+            StmtCode thenCode = compileStatement(ifStmt->thenStatement);
+            if (!ifStmt->elseStatement) {
+                return counted([condition, thenCode](Frame& f) {
+                    return condition(f) ? thenCode(f) : Flow::NEXT;
+                });
+            }
+            StmtCode elseCode = compileStatement(ifStmt->elseStatement);
+            return counted([condition, thenCode, elseCode](Frame& f) {
+                return condition(f) ? thenCode(f) : elseCode(f);
+            });
+        }
+        case NodeType::WHILE_STATEMENT: {
+            auto whileStmt = static_cast<Node<NodeType::WHILE_STATEMENT>*>(node);
+            IntCode condition = asInt(whileStmt->condition);
+            StmtCode body = compileStatement(whileStmt->body);
+            return counted([condition, body](Frame& f) {
+                while (condition(f)) {
+                    if (body(f) == Flow::RETURN) return Flow::RETURN;
+                }
+                return Flow::NEXT;
+            });
+        }
+        case NodeType::RETURN_STATEMENT: {
+            auto returnStmt = static_cast<Node<NodeType::RETURN_STATEMENT>*>(node);
+            Kind kind = current->returnKind;
+            if (!returnStmt->expression || kind == Kind::VOID) {
+                if (returnStmt->expression) {
+                    StmtCode value = discard(compileExpression(returnStmt->expression));
+                    return counted([value](Frame& f) { value(f); return Flow::RETURN; });
+                }
+                return counted([](Frame&) { return Flow::RETURN; });
+            }
+            switch (kind) {
+                case Kind::FLOAT:
+                    return counted([value = asFloat(returnStmt->expression)](Frame& f) {
+                        f.result.f = value(f);
+                        return Flow::RETURN;
+                    });
+                case Kind::STRING:
+                    return counted([value = asString(returnStmt->expression)](Frame& f) {
+                        f.resultString = value(f);
+                        return Flow::RETURN;
+                    });
+                default:
+                    return counted([value = asInt(returnStmt->expression)](Frame& f) {
+                        f.result.i = value(f);
+                        return Flow::RETURN;
+                    });
+            }
+        }
+        case NodeType::EXPRESSION_STATEMENT:
+            return discard(compileExpression(static_cast<Node<NodeType::EXPRESSION_STATEMENT>*>(node)->expression));
+        default:
+            return [](Frame&) { return Flow::NEXT; };
+    }
+}
+
+// ===== 함수 / 프로그램 =====
+
+// 함수와 전역 변수를 미리 등록해서 선언 순서와 상관없이 호출할 수 있게 한다
+void ccfn collect(ASTNode* node, bool topLevel) {
+    if (!node) return;
+
+    switch (node->type) {
+        case NodeType::FUNCTION_DECLARATION: {
+            auto func = static_cast<FunctionDeclaration*>(node);
+            if (functionByName.count(func->name)) {
+                throw std::runtime_error("Duplicate function: " + std::string(func->name.str()));
+            }
+            Function& fn = functions.emplace_back();
+            fn.name = std::string(func->name.str());
+            fn.returnKind = kindOf(func->returnType);
+            for (const auto& param : func->parameters) {
+                Kind kind = kindOf(param.type);
+                fn.paramKinds.push_back(kind == Kind::VOID ? Kind::INT : kind);
+            }
+            functionByName[func->name] = &fn;
+            declarations.push_back(func);
+            collect(func->body, false);
+            break;
+        }
+        case NodeType::NAMESPACE_DECLARATION: {
+            auto body = static_cast<Node<NodeType::NAMESPACE_DECLARATION>*>(node)->body;
+            if (body && body->type == NodeType::BLOCK_STATEMENT) {
+                for (ASTNode* stmt : static_cast<BlockStatement*>(body)->statements) {
+                    collect(stmt, topLevel);
+                }
+            }
+            break;
+        }
+        case NodeType::BLOCK_STATEMENT:
+            for (ASTNode* stmt : static_cast<BlockStatement*>(node)->statements) {
+                collect(stmt, false);
+            }
+            break;
+        case NodeType::VARIABLE_DECLARATION:
+            if (topLevel) {
+                auto var = static_cast<VariableDeclaration*>(node);
+                Kind kind = kindOf(var->dataType);
+                if (kind == Kind::VOID) kind = Kind::INT;
+                uint32_t index = static_cast<uint32_t>(kind == Kind::STRING ? globalStrings.size() : globals.size());
+                if (kind == Kind::STRING) globalStrings.emplace_back();
+                else globals.push_back(Slot{0});
+                globalByName[var->name] = Global{kind, index};
+            }
+            break;
+        case NodeType::IF_STATEMENT: {
+            auto ifStmt = static_cast<Node<NodeType::IF_STATEMENT>*>(node);
+            collect(ifStmt->thenStatement, false);
+            collect(ifStmt->elseStatement, false);
+            break;
+        }
+        case NodeType::WHILE_STATEMENT:
+            collect(static_cast<Node<NodeType::WHILE_STATEMENT>*>(node)->body, false);
+            break;
+        case NodeType::IMPORT_STATEMENT:
+            // 모듈 인터페이스에는 선언만 있고 실행할 본문이 없다
+            throw std::runtime_error("Imports are only supported by the C++ backend");
+        default:
+            break;
+    }
+}
+
+void ccfn compileFunction(FunctionDeclaration* func) {
+    current = functionByName.at(func->name);
+    locals.clear();
+    scopes.clear();
+    nextSlot = 0;
+    nextString = 0;
+    for (size_t i = 0; i < func->parameters.size(); ++i) {
+        current->paramIndex.push_back(declareLocal(func->parameters[i].name, current->paramKinds[i]));
+    }
+    current->body = compileStatement(func->body);
+}
+
+void ccfn compileTopLevel(ASTNode* node, std::vector<StmtCode>& out) {
+    switch (node->type) {
+        case NodeType::NAMESPACE_DECLARATION: {
+            auto body = static_cast<Node<NodeType::NAMESPACE_DECLARATION>*>(node)->body;
+            if (body && body->type == NodeType::BLOCK_STATEMENT) {
+                for (ASTNode* stmt : static_cast<BlockStatement*>(body)->statements) {
+                    compileTopLevel(stmt, out);
+                }
+            }
+            break;
+        }
+        case NodeType::VARIABLE_DECLARATION: {
+            auto var = static_cast<VariableDeclaration*>(node);
+            const Global& global = globalByName.at(var->name);
+            out.push_back(counted(store(global.kind, true, global.index, var->initializer)));
+            break;
+        }
+        case NodeType::FUNCTION_DECLARATION:
+            break;
+        default:
+            out.push_back(compileStatement(node));
+            break;
+    }
+}
+
+void ccfn load(Program* program) {
+    for (ASTNode* stmt : program->statements) {
+        collect(stmt, true);
+    }
+    for (FunctionDeclaration* func : declarations) {
+        compileFunction(func);
+    }
+
+    current = &init;
+    init.name = "<init>";
+    locals.clear();
+    scopes.clear();
+    nextSlot = 0;
+    nextString = 0;
+    std::vector<StmtCode> statements;
+    for (ASTNode* stmt : program->statements) {
+        compileTopLevel(stmt, statements);
+    }
+    init.body = [statements = std::move(statements)](Frame& f) {
+        for (const auto& stmt : statements) {
+            if (stmt(f) == Flow::RETURN) break;
+        }
+        return Flow::NEXT;
+    };
+    current = nullptr;
+    declarations.clear();
+}
+
+int64_t ccfn run() {
+    segment = 0;
+    top = segments[0].slots.get();
+    limit = top + segments[0].size;
+    depth = 0;
+    deep = false;
+    for (auto& slot : globals) slot.i = 0;
+    for (auto& s : globalStrings) s.clear();
+
+    std::vector<std::string> initStrings(init.numStrings);
+    Frame frame{allocate(init.numSlots), initStrings.data(), {}, {}};
+    if (init.body) init.body(frame);
+
+    auto entry = functionByName.find(names::Main);
+    if (entry == functionByName.end()) {
+        return 0;
+    }
+    const Function* fn = entry->second;
+    if (!fn->paramKinds.empty()) {
+        throw std::runtime_error("main must not take parameters");
+    }
+
+    std::vector<std::string> strings(fn->numStrings);
+    Frame callee{nullptr, strings.data(), {}, {}};
+    enter(fn, {}, frame, callee);
+    return fn->returnKind == Kind::INT ? callee.result.i : 0;
+}
@@ -0,0 +1,48 @@
+#include <Interner.hh>
+
+#include <mutex>
+#include <stdexcept>
+
+Interner::Interner() {
+    for (std::string_view s : names::wellKnown) {
+        insert(s);
+    }
+}
+
+Interner& Interner::global() {
+    static Interner instance;
+    return instance;
+}
+
+// mutex 를 쥔 상태에서 호출한다
+uint32_t Interner::insert(std::string_view s) {
+    uint32_t id = count;
+    if ((id >> BlockBits) >= MaxBlocks) {
+        throw std::runtime_error("Interner capacity exceeded");
+    }
+    auto& block = blocks[id >> BlockBits];
+    if (!block) block.reset(new std::string_view[BlockSize]);
+
+    std::string_view stored = storage.store(s);
+    block[id & (BlockSize - 1)] = stored;
+    ids.emplace(stored, id);
+    count++;
+    return id;
+}
+
+Name Interner::intern(std::string_view s) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto found = ids.find(s);
+        if (found != ids.end()) return Name(found->second);
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    auto found = ids.find(s);
+    if (found != ids.end()) return Name(found->second);
+    return Name(insert(s));
+}
+
+size_t Interner::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return count;
+}
@@ -0,0 +1,327 @@
+#include <Ir.hh>
+#include <Nodes.hh>
+#include <Type.hh>
+
+#include <algorithm>
+#include <charconv>
+
+namespace ir {
+
+std::string_view spelling(TokenType op) {
+    switch (op) {
+        case TokenType::PLUS: return "+";
+        case TokenType::MINUS: return "-";
+        case TokenType::MULTIPLY: return "*";
+        case TokenType::DIVIDE: return "/";
+        case TokenType::MODULO: return "%";
+        case TokenType::EQUAL: return "==";
+        case TokenType::NOT_EQUAL: return "!=";
+        case TokenType::LESS: return "<";
+        case TokenType::GREATER: return ">";
+        case TokenType::LESS_EQUAL: return "<=";
+        case TokenType::GREATER_EQUAL: return ">=";
+        case TokenType::LOGICAL_AND: return "&&";
+        case TokenType::LOGICAL_OR: return "||";
+        case TokenType::LOGICAL_NOT: return "!";
+        case TokenType::BIT_AND: return "&";
+        case TokenType::BIT_OR: return "|";
+        case TokenType::BIT_XOR: return "^";
+        case TokenType::BIT_NOT: return "~";
+        case TokenType::LEFT_SHIFT: return "<<";
+        case TokenType::RIGHT_SHIFT: return ">>";
+        default: return "OP";
+    }
+}
+
+#undef ccfn
+#define ccfn Function::
+
+BlockId ccfn addBlock() {
+    blocks.emplace_back();
+    return static_cast<BlockId>(blocks.size() - 1);
+}
+
+Value ccfn make(Instruction instruction) {
+    values.push_back(std::move(instruction));
+    forward.push_back(None);
+    return static_cast<Value>(values.size() - 1);
+}
+
+Value ccfn append(BlockId block, Instruction instruction) {
+    instruction.block = block;
+    Op op = instruction.op;
+    BlockId first = instruction.targets[0];
+    BlockId second = instruction.targets[1];
+    Value v = make(std::move(instruction));
+    blocks[block].code.push_back(v);
+    if (op == Op::Jump || op == Op::Branch || op == Op::Return) {
+        blocks[block].closed = true;
+        if (op != Op::Return) addEdge(block, first);
+        if (op == Op::Branch) addEdge(block, second);
+    }
+    return v;
+}
+
+void ccfn addEdge(BlockId from, BlockId to) {
+    blocks[from].succs.push_back(to);
+    blocks[to].preds.push_back(from);
+}
+
+void ccfn removeEdge(BlockId from, BlockId to) {
+    std::vector<BlockId>& succs = blocks[from].succs;
+    auto succ = std::find(succs.begin(), succs.end(), to);
+    if (succ != succs.end()) succs.erase(succ);
+
+    std::vector<BlockId>& preds = blocks[to].preds;
+    auto pred = std::find(preds.begin(), preds.end(), from);
+    if (pred == preds.end()) return;
+    size_t index = static_cast<size_t>(pred - preds.begin());
+    preds.erase(pred);
+    for (Value phi : blocks[to].phis) {
+        std::vector<Value>& operands = values[phi].operands;
+        if (index < operands.size()) operands.erase(operands.begin() + index);
+    }
+}
+
+void ccfn replace(Value from, Value to) {
+    if (from == to) return;
+    forward[from] = to;
+    values[from].dead = true;
+}
+
+void ccfn canonicalize() {
+    auto isDead = [this](Value v) { return values[v].dead; };
+    for (Block& block : blocks) {
+        if (block.dead) continue;
+        block.phis.erase(std::remove_if(block.phis.begin(), block.phis.end(), isDead), block.phis.end());
+        block.code.erase(std::remove_if(block.code.begin(), block.code.end(), isDead), block.code.end());
+        for (Value phi : block.phis) {
+            for (Value& operand : values[phi].operands) operand = resolve(operand);
+        }
+        for (Value v : block.code) {
+            for (Value& operand : values[v].operands) operand = resolve(operand);
+        }
+    }
+}
+
+bool ccfn removeUnreachable() {
+    std::vector<bool> reached(blocks.size(), false);
+    std::vector<BlockId> stack{0};
+    reached[0] = true;
+    while (!stack.empty()) {
+        BlockId b = stack.back();
+        stack.pop_back();
+        for (BlockId succ : blocks[b].succs) {
+            if (!reached[succ]) {
+                reached[succ] = true;
+                stack.push_back(succ);
+            }
+        }
+    }
+
+    bool changed = false;
+    for (BlockId b = 0; b < blocks.size(); ++b) {
+        if (reached[b] || blocks[b].dead) continue;
+        std::vector<BlockId> succs = blocks[b].succs;
+        for (BlockId succ : succs) removeEdge(b, succ);
+        Block& block = blocks[b];
+        for (Value v : block.phis) values[v].dead = true;
+        for (Value v : block.code) values[v].dead = true;
+        block.phis.clear();
+        block.code.clear();
+        block.dead = true;
+        changed = true;
+    }
+    return changed;
+}
+
+std::vector<BlockId> ccfn reversePostorder() const {
+    // 후속 블록을 하나씩 꺼내는 반복 DFS. 뒤의 후속부터 내려가야 역후위 순서에서
+    // 참 쪽 블록이 거짓 쪽보다 앞에 온다 (소스 순서).
+    std::vector<BlockId> order;
+    std::vector<bool> visited(blocks.size(), false);
+    std::vector<std::pair<BlockId, size_t>> stack{{0, 0}};
+    visited[0] = true;
+    while (!stack.empty()) {
+        auto& [b, next] = stack.back();
+        const std::vector<BlockId>& succs = blocks[b].succs;
+        if (next < succs.size()) {
+            BlockId succ = succs[succs.size() - 1 - next++];
+            if (!visited[succ]) {
+                visited[succ] = true;
+                stack.push_back({succ, 0});
+            }
+            continue;
+        }
+        order.push_back(b);
+        stack.pop_back();
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+size_t ccfn size() const {
+    size_t count = 0;
+    for (const Block& block : blocks) {
+        if (!block.dead) count += block.phis.size() + block.code.size();
+    }
+    return count;
+}
+
+// ===== 출력 (--dump-ir) =====
+
+static void appendValue(std::string& out, Value v) {
+    out += "%";
+    out += std::to_string(v);
+}
+
+static void appendConstant(std::string& out, const Instruction& ins) {
+    if (!ins.type) return;
+    switch (ins.type->kind) {
+        case Type::BOOL: out += ins.integer ? "true" : "false"; break;
+        case Type::FLOAT:
+        case Type::DOUBLE: {
+            char buf[32];
+            char* end = std::to_chars(buf, buf + sizeof buf, ins.real).ptr;
+            out.append(buf, end);
+            break;
+        }
+        case Type::STRING:
+            out += "\"";
+            out += ins.text;
+            out += "\"";
+            break;
+        default: out += std::to_string(ins.integer); break;
+    }
+}
+
+static void appendInstruction(std::string& out, const Function& fn, Value v) {
+    const Instruction& ins = fn.values[v];
+    out += "    ";
+    if (ins.type) {
+        appendValue(out, v);
+        out += " = ";
+    }
+    switch (ins.op) {
+        case Op::Const: out += "const "; appendConstant(out, ins); break;
+        case Op::Undef: out += "undef"; break;
+        case Op::Param:
+            out += "param ";
+            out += std::to_string(ins.integer);
+            out += " ";
+            out += ins.name.str();
+            break;
+        case Op::Phi:
+            out += "phi";
+            for (size_t i = 0; i < ins.operands.size(); ++i) {
+                out += i ? ", " : " ";
+                appendValue(out, ins.operands[i]);
+                out += " bb";
+                out += std::to_string(fn.blocks[ins.block].preds[i]);
+            }
+            break;
+        case Op::Copy: out += "copy "; appendValue(out, ins.operands[0]); break;
+        case Op::Cast: out += "cast "; appendValue(out, ins.operands[0]); break;
+        case Op::Binary:
+            appendValue(out, ins.operands[0]);
+            out += " ";
+            out += spelling(ins.operator_);
+            out += " ";
+            appendValue(out, ins.operands[1]);
+            break;
+        case Op::Unary:
+            out += spelling(ins.operator_);
+            appendValue(out, ins.operands[0]);
+            break;
+        case Op::Load: out += "load "; out += ins.name.str(); break;
+        case Op::Store:
+            out += "store ";
+            out += ins.name.str();
+            out += ", ";
+            appendValue(out, ins.operands[0]);
+            break;
+        case Op::Call:
+            out += "call ";
+            out += ins.name.str();
+            out += "(";
+            for (size_t i = 0; i < ins.operands.size(); ++i) {
+                if (i) out += ", ";
+                appendValue(out, ins.operands[i]);
+            }
+            out += ")";
+            break;
+        case Op::Jump: out += "jmp bb"; out += std::to_string(ins.targets[0]); break;
+        case Op::Branch:
+            out += "br ";
+            appendValue(out, ins.operands[0]);
+            out += ", bb";
+            out += std::to_string(ins.targets[0]);
+            out += ", bb";
+            out += std::to_string(ins.targets[1]);
+            break;
+        case Op::Return:
+            out += "ret";
+            if (!ins.operands.empty()) {
+                out += " ";
+                appendValue(out, ins.operands[0]);
+            }
+            break;
+    }
+    if (ins.type) {
+        out += " : ";
+        out += ins.type->name.str();
+    }
+    out += "\n";
+}
+
+std::string ccfn dump() const {
+    std::string out = "fn ";
+    out += name.str();
+    out += "(";
+    for (size_t i = 0; i < params.size(); ++i) {
+        if (i) out += ", ";
+        appendValue(out, params[i]);
+        out += " ";
+        out += values[params[i]].name.str();
+        out += ": ";
+        out += values[params[i]].type->name.str();
+    }
+    out += ")";
+    if (returnType) {
+        out += ": ";
+        out += returnType->name.str();
+    }
+    out += "\n";
+    for (Value v : undefs) {
+        if (!values[v].dead) appendInstruction(out, *this, v);
+    }
+    for (BlockId b : reversePostorder()) {
+        const Block& block = blocks[b];
+        out += "bb" + std::to_string(b) + ":";
+        if (!block.preds.empty()) {
+            out += "    ; preds";
+            for (BlockId pred : block.preds) out += " bb" + std::to_string(pred);
+        }
+        out += "\n";
+        for (Value v : block.phis) appendInstruction(out, *this, v);
+        for (Value v : block.code) appendInstruction(out, *this, v);
+    }
+    return out;
+}
+
+#undef ccfn
+#define ccfn Module::
+
+std::string ccfn dump() const {
+    std::string out;
+    for (const auto& function : list) {
+        if (!out.empty()) out += "\n";
+        out += function->dump();
+    }
+    if (skipped) {
+        out += "\n; " + std::to_string(skipped) + " function(s) left to the AST code generator\n";
+    }
+    return out;
+}
+
+}
@@ -0,0 +1,597 @@
+#include <IrBuilder.hh>
+#include <ASTNode.hh>
+#include <ModuleInterface.hh>
+#include <Nodes.hh>
+#include <Program.hh>
+#include <Type.hh>
+
+#undef ccfn
+#define ccfn IrBuilder::
+
+using ir::BlockId;
+using ir::Instruction;
+using ir::Op;
+using ir::Value;
+
+using BinaryExpression = Node<NodeType::BINARY_EXPRESSION>;
+using UnaryExpression = Node<NodeType::UNARY_EXPRESSION>;
+using Identifier = Node<NodeType::IDENTIFIER>;
+using FunctionDeclaration = Node<NodeType::FUNCTION_DECLARATION>;
+
+// IR 값이 될 수 있는 타입 (bool, 정수, 실수, string). 배열과 이름 붙은 타입은 아직 못 내린다.
+static const Type* valueType(Name spelling) {
+    const Type* type = TypeTable::global().fromName(spelling);
+    if (!type || type->kind < Type::BOOL || type->kind > Type::STRING) return nullptr;
+    return type;
+}
+
+// 반환 타입. 선언도 return 도 없으면 void 다.
+static const Type* returnTypeOf(Name spelling) {
+    if (spelling.empty() || spelling == names::Void) return &types::Void;
+    return valueType(spelling);
+}
+
+// 언제 계산해도 되는 식 (&& / || 의 오른쪽을 분기 없이 먼저 계산해도 되는가)
+static bool isSimple(const ASTNode* node) {
+    switch (node->type) {
+        case NodeType::INTEGER_LITERAL:
+        case NodeType::FLOAT_LITERAL:
+        case NodeType::STRING_LITERAL:
+        case NodeType::BOOL_LITERAL:
+        case NodeType::IDENTIFIER:
+            return true;
+        case NodeType::UNARY_EXPRESSION:
+            return isSimple(static_cast<const UnaryExpression*>(node)->operand);
+        case NodeType::BINARY_EXPRESSION: {
+            auto binary = static_cast<const BinaryExpression*>(node);
+            if (binary->operator_ == TokenType::DIVIDE || binary->operator_ == TokenType::MODULO) return false;
+            return isSimple(binary->left) && isSimple(binary->right);
+        }
+        default:
+            return false;
+    }
+}
+
+// 생성된 C++ 에서 쓰는 이름 (_t, _c, _L) 과 겹칠 수 있는 이름. 밑줄로 시작하는 이름을 쓰는
+// 함수는 내리지 않는다.
+static inline bool isReserved(Name name) {
+    std::string_view spelling = name.str();
+    return !spelling.empty() && spelling[0] == '_';
+}
+
+static inline uint64_t definitionKey(BlockId block, uint32_t variable) {
+    return (static_cast<uint64_t>(block) << 32) | variable;
+}
+
+// ===== 모듈 =====
+
+void ccfn declare(std::unordered_map<Name, const Type*>& table, Name name, const Type* type) {
+    auto [it, inserted] = table.emplace(name, type);
+    if (!inserted && it->second != type) it->second = nullptr;
+}
+
+void ccfn collect(ASTNode* node) {
+    switch (node->type) {
+        case NodeType::VARIABLE_DECLARATION: {
+            auto var = static_cast<Node<NodeType::VARIABLE_DECLARATION>*>(node);
+            declare(globals, var->name, valueType(var->dataType));
+            break;
+        }
+        case NodeType::FUNCTION_DECLARATION: {
+            auto func = static_cast<FunctionDeclaration*>(node);
+            declare(functions, func->name, returnTypeOf(func->returnType));
+            break;
+        }
+        case NodeType::NAMESPACE_DECLARATION: {
+            auto body = static_cast<Node<NodeType::NAMESPACE_DECLARATION>*>(node)->body;
+            if (body && body->type == NodeType::BLOCK_STATEMENT) {
+                for (ASTNode* stmt : static_cast<Node<NodeType::BLOCK_STATEMENT>*>(body)->statements) collect(stmt);
+            }
+            break;
+        }
+        case NodeType::IMPORT_STATEMENT: {
+            const ModuleInterface* module = static_cast<Node<NodeType::IMPORT_STATEMENT>*>(node)->interface;
+            if (!module) break;
+            for (const ExportedSymbol& symbol : module->symbols) {
+                if (symbol.isFunction) declare(functions, symbol.name, returnTypeOf(symbol.type));
+                else declare(globals, symbol.name, valueType(symbol.type));
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+ir::Module ccfn build(Program* program) {
+    globals.clear();
+    functions.clear();
+    for (ASTNode* stmt : program->statements) collect(stmt);
+
+    ir::Module module;
+    std::vector<ASTNode*> pending(program->statements.begin(), program->statements.end());
+    for (size_t i = 0; i < pending.size(); ++i) {
+        ASTNode* stmt = pending[i];
+        if (stmt->type == NodeType::NAMESPACE_DECLARATION) {
+            auto body = static_cast<Node<NodeType::NAMESPACE_DECLARATION>*>(stmt)->body;
+            if (body && body->type == NodeType::BLOCK_STATEMENT) {
+                for (ASTNode* inner : static_cast<Node<NodeType::BLOCK_STATEMENT>*>(body)->statements) {
+                    pending.push_back(inner);
+                }
+            }
+            continue;
+        }
+        if (stmt->type != NodeType::FUNCTION_DECLARATION) continue;
+        auto func = static_cast<FunctionDeclaration*>(stmt);
+        if (!func->body) continue;
+        std::unique_ptr<ir::Function> lowered = lower(func);
+        if (lowered) module.add(std::move(lowered));
+        else module.skipped++;
+    }
+    return module;
+}
+
+std::unique_ptr<ir::Function> ccfn lower(FunctionDeclaration* func) {
+    fn = std::make_unique<ir::Function>(func);
+    fn->name = func->name;
+    variables.clear();
+    scope.clear();
+    definitions.clear();
+    sealed.clear();
+    incomplete.clear();
+
+    try {
+        fn->returnType = returnTypeOf(func->returnType);
+        if (!fn->returnType) throw Unsupported{};
+        current = newBlock(true);
+
+        for (size_t i = 0; i < func->parameters.size(); ++i) {
+            const Parameter& param = func->parameters[i];
+            const Type* type = valueType(param.type);
+            if (!type || isReserved(param.name)) throw Unsupported{};
+            Instruction ins(Op::Param, type);
+            ins.integer = static_cast<int64_t>(i);
+            ins.name = param.name;
+            Value v = fn->make(std::move(ins));
+            fn->params.push_back(v);
+            uint32_t id = static_cast<uint32_t>(variables.size());
+            variables.push_back({param.name, type});
+            scope.push_back({param.name, id});
+            writeVariable(id, current, v);
+        }
+
+        lowerStatement(func->body);
+        if (!fn->blocks[current].closed) emit(Instruction(Op::Return));
+    } catch (const Unsupported&) {
+        fn.reset();
+        return nullptr;
+    }
+
+    // return 뒤에 만든 블록과 피연산자가 같아서 지운 phi 를 정리한다
+    fn->removeUnreachable();
+    fn->canonicalize();
+    return std::move(fn);
+}
+
+// ===== 블록과 변수 =====
+
+BlockId ccfn newBlock(bool seal) {
+    BlockId block = fn->addBlock();
+    sealed.push_back(seal);
+    incomplete.emplace_back();
+    return block;
+}
+
+void ccfn seal(BlockId block) {
+    // addPhiOperands 가 다른 블록의 incomplete 에 넣을 수 있으므로 꺼내 놓고 돈다
+    std::vector<std::pair<uint32_t, Value>> pending = std::move(incomplete[block]);
+    incomplete[block].clear();
+    for (const auto& [variable, phi] : pending) addPhiOperands(variable, phi);
+    sealed[block] = true;
+}
+
+void ccfn writeVariable(uint32_t variable, BlockId block, Value value) {
+    definitions[definitionKey(block, variable)] = value;
+}
+
+Value ccfn readVariable(uint32_t variable, BlockId block) {
+    auto it = definitions.find(definitionKey(block, variable));
+    if (it != definitions.end()) return fn->resolve(it->second);
+    return readRecursive(variable, block);
+}
+
+Value ccfn readRecursive(uint32_t variable, BlockId block) {
+    const Type* type = variables[variable].type;
+    Value v;
+    if (!sealed[block]) {
+        // 선행 블록이 더 생길 수 있다. 닫을 때 채운다.
+        Instruction phi(Op::Phi, type);
+        phi.block = block;
+        v = fn->make(std::move(phi));
+        fn->blocks[block].phis.push_back(v);
+        incomplete[block].push_back({variable, v});
+    } else if (fn->blocks[block].preds.size() == 1) {
+        v = readVariable(variable, fn->blocks[block].preds[0]);
+    } else if (fn->blocks[block].preds.empty()) {
+        // 입구나 닿지 않는 블록. 초기값 없이 선언된 변수다.
+        v = fn->make(Instruction(Op::Undef, type));
+        fn->undefs.push_back(v);
+    } else {
+        // 돌아오는 길에 자기 자신을 읽어도 끝나도록 phi 를 먼저 적어 둔다
+        Instruction phi(Op::Phi, type);
+        phi.block = block;
+        v = fn->make(std::move(phi));
+        fn->blocks[block].phis.push_back(v);
+        writeVariable(variable, block, v);
+        v = addPhiOperands(variable, v);
+    }
+    writeVariable(variable, block, v);
+    return v;
+}
+
+Value ccfn addPhiOperands(uint32_t variable, Value phi) {
+    std::vector<BlockId> preds = fn->blocks[fn->values[phi].block].preds;
+    for (BlockId pred : preds) {
+        Value operand = readVariable(variable, pred);
+        fn->values[phi].operands.push_back(operand);
+    }
+    return removeTrivialPhi(phi);
+}
+
+Value ccfn removeTrivialPhi(Value phi) {
+    Value same = ir::None;
+    for (Value operand : fn->values[phi].operands) {
+        operand = fn->resolve(operand);
+        if (operand == same || operand == phi) continue;
+        if (same != ir::None) return phi;
+        same = operand;
+    }
+    if (same == ir::None) {
+        same = fn->make(Instruction(Op::Undef, fn->values[phi].type));
+        fn->undefs.push_back(same);
+    }
+    // phi 를 쓰던 다른 phi 가 이제 자명해질 수 있지만 그건 복사 전파가 정리한다
+    fn->replace(phi, same);
+    return same;
+}
+
+uint32_t ccfn lookup(Name name) const {
+    for (auto it = scope.rbegin(); it != scope.rend(); ++it) {
+        if (it->first == name) return it->second;
+    }
+    return ir::None;
+}
+
+// ===== 명령 =====
+
+Value ccfn emit(Instruction instruction) {
+    return fn->append(current, std::move(instruction));
+}
+
+Value ccfn constant(const Type* type, int64_t value) {
+    Instruction ins(Op::Const, type);
+    ins.integer = value;
+    return emit(std::move(ins));
+}
+
+Value ccfn convert(Value value, const Type* type) {
+    if (value == ir::None || !type) throw Unsupported{};
+    if (typeOf(value) == type) return value;
+    Instruction ins(Op::Cast, type);
+    ins.operands.push_back(value);
+    return emit(std::move(ins));
+}
+
+void ccfn jump(BlockId target) {
+    if (fn->blocks[current].closed) return;
+    Instruction ins(Op::Jump);
+    ins.targets[0] = target;
+    emit(std::move(ins));
+}
+
+Value ccfn operand(ASTNode* node) {
+    Value v = dispatch(node);
+    if (v == ir::None) throw Unsupported{};    // void 호출을 값으로 썼다
+    return v;
+}
+
+// ===== 식 =====
+
+Value ccfn visit(Node<NodeType::INTEGER_LITERAL>* lit) {
+    return constant(&types::Int, lit->value);
+}
+
+Value ccfn visit(Node<NodeType::FLOAT_LITERAL>* lit) {
+    // C++ 에서 실수 리터럴은 double 이다
+    Instruction ins(Op::Const, &types::Double);
+    ins.real = lit->value;
+    return emit(std::move(ins));
+}
+
+Value ccfn visit(Node<NodeType::STRING_LITERAL>* lit) {
+    Instruction ins(Op::Const, &types::String);
+    ins.text = lit->value;
+    return emit(std::move(ins));
+}
+
+Value ccfn visit(Node<NodeType::BOOL_LITERAL>* lit) {
+    return constant(&types::Bool, lit->value);
+}
+
+Value ccfn visit(Identifier* id) {
+    uint32_t variable = lookup(id->name);
+    if (variable != ir::None) return readVariable(variable, current);
+
+    auto global = globals.find(id->name);
+    if (global == globals.end() || !global->second || isReserved(id->name)) throw Unsupported{};
+    Instruction ins(Op::Load, global->second);
+    ins.name = id->name;
+    return emit(std::move(ins));
+}
+
+Value ccfn visit(BinaryExpression* binary) {
+    TokenType op = binary->operator_;
+    if ((op == TokenType::LOGICAL_AND || op == TokenType::LOGICAL_OR) && !isSimple(binary->right)) {
+        return lowerShortCircuit(binary);
+    }
+
+    Value left = operand(binary->left);
+    Value right = operand(binary->right);
+    const Type* a = typeOf(left);
+    const Type* b = typeOf(right);
+
+    // 생성된 C++ 에서의 결과 타입 (산술 변환 규칙)
+    const Type* result = nullptr;
+    switch (op) {
+        case TokenType::PLUS:
+            if (a == &types::String && b == &types::String) {
+                result = &types::String;
+                break;
+            }
+            [[fallthrough]];
+        case TokenType::MINUS:
+        case TokenType::MULTIPLY:
+        case TokenType::DIVIDE:
+        case TokenType::MODULO:
+            if (a->isNumeric() && b->isNumeric()) result = types::promote(a, b);
+            break;
+        case TokenType::BIT_AND:
+        case TokenType::BIT_OR:
+        case TokenType::BIT_XOR:
+            if (a->isIntegral() && b->isIntegral()) result = types::promote(a, b);
+            break;
+        case TokenType::LEFT_SHIFT:
+        case TokenType::RIGHT_SHIFT:
+            // 시프트의 결과는 왼쪽 피연산자만 승격한 타입이다
+            if (a->isIntegral() && b->isIntegral()) result = types::promote(a, a);
+            break;
+        case TokenType::LESS:
+        case TokenType::GREATER:
+        case TokenType::LESS_EQUAL:
+        case TokenType::GREATER_EQUAL:
+            if (a->isNumeric() && b->isNumeric()) result = &types::Bool;
+            break;
+        case TokenType::EQUAL:
+        case TokenType::NOT_EQUAL:
+            if (a == b || (a->isNumeric() && b->isNumeric())) result = &types::Bool;
+            break;
+        case TokenType::LOGICAL_AND:
+        case TokenType::LOGICAL_OR:
+            if (a == &types::Bool && b == &types::Bool) result = &types::Bool;
+            break;
+        default:
+            break;
+    }
+    if (!result) throw Unsupported{};
+
+    Instruction ins(Op::Binary, result);
+    ins.operator_ = op;
+    ins.operands = {left, right};
+    return emit(std::move(ins));
+}
+
+Value ccfn lowerShortCircuit(BinaryExpression* binary) {
+    // a && b:  a 가 거짓이면 b 를 보지 않고 a 를 그대로 쓴다 (|| 는 참일 때)
+    Value left = operand(binary->left);
+    if (typeOf(left) != &types::Bool) throw Unsupported{};
+    BlockId rhs = newBlock(false);
+    BlockId merge = newBlock(false);
+    BlockId from = current;
+
+    Instruction branch(Op::Branch);
+    branch.operands.push_back(left);
+    bool isAnd = binary->operator_ == TokenType::LOGICAL_AND;
+    branch.targets[0] = isAnd ? rhs : merge;
+    branch.targets[1] = isAnd ? merge : rhs;
+    emit(std::move(branch));
+    seal(rhs);
+
+    current = rhs;
+    Value right = operand(binary->right);
+    if (typeOf(right) != &types::Bool) throw Unsupported{};
+    jump(merge);
+    seal(merge);
+    current = merge;
+
+    Instruction phi(Op::Phi, &types::Bool);
+    phi.block = merge;
+    for (BlockId pred : fn->blocks[merge].preds) {
+        phi.operands.push_back(pred == from ? left : right);
+    }
+    Value v = fn->make(std::move(phi));
+    fn->blocks[merge].phis.push_back(v);
+    return v;
+}
+
+Value ccfn visit(UnaryExpression* unary) {
+    Value value = operand(unary->operand);
+    const Type* type = typeOf(value);
+    const Type* result = nullptr;
+    switch (unary->operator_) {
+        case TokenType::LOGICAL_NOT:
+            if (type == &types::Bool) result = type;
+            break;
+        case TokenType::BIT_NOT:
+            if (type->isIntegral()) result = types::promote(type, type);
+            break;
+        case TokenType::MINUS:
+        case TokenType::PLUS:
+            if (type->isNumeric()) result = types::promote(type, type);
+            break;
+        default:
+            break;
+    }
+    if (!result) throw Unsupported{};
+
+    Instruction ins(Op::Unary, result);
+    ins.operator_ = unary->operator_;
+    ins.operands.push_back(value);
+    return emit(std::move(ins));
+}
+
+Value ccfn visit(Node<NodeType::ASSIGNMENT_EXPRESSION>* assignment) {
+    if (assignment->left->type != NodeType::IDENTIFIER) throw Unsupported{};
+    Name name = static_cast<Identifier*>(assignment->left)->name;
+    Value right = operand(assignment->right);
+
+    uint32_t variable = lookup(name);
+    if (variable != ir::None) {
+        Value v = convert(right, variables[variable].type);
+        writeVariable(variable, current, v);
+        return v;
+    }
+
+    auto global = globals.find(name);
+    if (global == globals.end() || !global->second || isReserved(name)) throw Unsupported{};
+    Value v = convert(right, global->second);
+    Instruction store(Op::Store);
+    store.name = name;
+    store.operands.push_back(v);
+    emit(std::move(store));
+    return v;
+}
+
+Value ccfn visit(Node<NodeType::CALL_EXPRESSION>* call) {
+    if (call->callee->type != NodeType::IDENTIFIER) throw Unsupported{};
+    Name name = static_cast<Identifier*>(call->callee)->name;
+    // 지역 변수가 함수 이름을 가리면 C++ 에서도 호출할 수 없다
+    if (lookup(name) != ir::None) throw Unsupported{};
+    auto function = functions.find(name);
+    if (function == functions.end() || !function->second || isReserved(name)) throw Unsupported{};
+
+    std::vector<Value> arguments;
+    arguments.reserve(call->arguments.size());
+    for (ASTNode* argument : call->arguments) arguments.push_back(operand(argument));
+
+    const Type* type = function->second == &types::Void ? nullptr : function->second;
+    Instruction ins(Op::Call, type);
+    ins.name = name;
+    ins.operands = std::move(arguments);
+    Value v = emit(std::move(ins));
+    return type ? v : ir::None;
+}
+
+// ===== 문장 =====
+
+void ccfn lowerStatement(ASTNode* node) {
+    if (!node) return;
+    // return 뒤의 문장은 선행 블록이 없는 블록에 내린다 (나중에 지운다)
+    if (fn->blocks[current].closed) current = newBlock(true);
+    dispatch(node);
+}
+
+Value ccfn visit(Node<NodeType::VARIABLE_DECLARATION>* var) {
+    const Type* type = valueType(var->dataType);
+    Value v;
+    if (var->initializer) {
+        v = operand(var->initializer);
+        if (!type) type = typeOf(v);       // auto
+        v = convert(v, type);
+    } else {
+        if (!type) throw Unsupported{};
+        v = fn->make(Instruction(Op::Undef, type));
+        fn->undefs.push_back(v);
+    }
+
+    // 초기값 안에서는 아직 바깥의 같은 이름이 보인다
+    uint32_t id = static_cast<uint32_t>(variables.size());
+    variables.push_back({var->name, type});
+    scope.push_back({var->name, id});
+    writeVariable(id, current, v);
+    return ir::None;
+}
+
+Value ccfn visit(Node<NodeType::BLOCK_STATEMENT>* block) {
+    size_t mark = scope.size();
+    for (ASTNode* stmt : block->statements) lowerStatement(stmt);
+    scope.resize(mark);
+    return ir::None;
+}
+
+Value ccfn visit(Node<NodeType::IF_STATEMENT>* ifStmt) {
+    Value condition = operand(ifStmt->condition);
+    BlockId thenBlock = newBlock(false);
+    BlockId elseBlock = ifStmt->elseStatement ? newBlock(false) : ir::None;
+    BlockId merge = newBlock(false);
+
+    Instruction branch(Op::Branch);
+    branch.operands.push_back(condition);
+    branch.targets[0] = thenBlock;
+    branch.targets[1] = elseBlock != ir::None ? elseBlock : merge;
+    emit(std::move(branch));
+    seal(thenBlock);
+    if (elseBlock != ir::None) seal(elseBlock);
+
+    current = thenBlock;
+    lowerStatement(ifStmt->thenStatement);
+    jump(merge);
+    if (elseBlock != ir::None) {
+        current = elseBlock;
+        lowerStatement(ifStmt->elseStatement);
+        jump(merge);
+    }
+    seal(merge);
+    current = merge;
+    return ir::None;
+}
+
+Value ccfn visit(Node<NodeType::WHILE_STATEMENT>* whileStmt) {
+    // 머리는 본문 끝에서 돌아오는 간선이 생길 때까지 닫지 않는다
+    BlockId header = newBlock(false);
+    jump(header);
+    current = header;
+    Value condition = operand(whileStmt->condition);
+    BlockId body = newBlock(false);
+    BlockId exit = newBlock(false);
+
+    Instruction branch(Op::Branch);
+    branch.operands.push_back(condition);
+    branch.targets[0] = body;
+    branch.targets[1] = exit;
+    emit(std::move(branch));
+    seal(body);
+
+    current = body;
+    lowerStatement(whileStmt->body);
+    jump(header);
+    seal(header);
+    seal(exit);
+    current = exit;
+    return ir::None;
+}
+
+Value ccfn visit(Node<NodeType::RETURN_STATEMENT>* returnStmt) {
+    Instruction ins(Op::Return);
+    if (returnStmt->expression) {
+        // void 함수를 부른 값을 돌려주면 호출만 하고 값 없이 돌아간다
+        Value v = dispatch(returnStmt->expression);
+        if (v != ir::None) ins.operands.push_back(v);
+    }
+    emit(std::move(ins));
+    return ir::None;
+}
+
+Value ccfn visit(Node<NodeType::EXPRESSION_STATEMENT>* exprStmt) {
+    if (exprStmt->expression) dispatch(exprStmt->expression);
+    return ir::None;
+}
@@ -0,0 +1,312 @@
+#include <IrEmitter.hh>
+#include <CodeGenerator.hh>
+#include <Type.hh>
+
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <utility>
+
+#undef ccfn
+#define ccfn IrEmitter::
+
+using ir::BlockId;
+using ir::Instruction;
+using ir::Op;
+using ir::Value;
+
+std::string ccfn typeName(const Type* type) const {
+    return generator.mapToCppType(type->name);
+}
+
+void ccfn body(const ir::Function& function, int level) {
+    fn = &function;
+    indentLevel = level + 1;
+
+    uses.assign(fn->values.size(), 0);
+    for (const ir::Block& block : fn->blocks) {
+        if (block.dead) continue;
+        for (Value v : block.phis) {
+            for (Value operand : fn->values[v].operands) uses[operand]++;
+        }
+        for (Value v : block.code) {
+            for (Value operand : fn->values[v].operands) uses[operand]++;
+        }
+    }
+
+    // 종결 명령을 한 번 미리 걸어서 goto 가 가는 블록을 안다
+    std::vector<BlockId> order = fn->reversePostorder();
+    labelled.assign(fn->blocks.size(), false);
+    for (size_t i = 0; i < order.size(); ++i) {
+        terminator(order[i], i + 1 < order.size() ? order[i + 1] : ir::None, false);
+    }
+
+    output << "{\n";
+    declarations();
+    for (size_t i = 0; i < order.size(); ++i) {
+        BlockId b = order[i];
+        if (labelled[b]) {
+            output.indent(level);
+            output << "_L" << static_cast<int64_t>(b) << ":\n";
+        }
+        const std::vector<Value>& code = fn->blocks[b].code;
+        for (size_t j = 0; j + 1 < code.size(); ++j) instruction(code[j]);
+        terminator(b, i + 1 < order.size() ? order[i + 1] : ir::None, true);
+    }
+    output.indent(level);
+    output << "}\n";
+}
+
+void ccfn declarations() {
+    // 타입마다 한 줄. 처음 나온 순서를 지킨다.
+    std::vector<std::pair<const Type*, std::vector<Value>>> groups;
+    auto declare = [&groups](const Instruction& ins, Value v) {
+        for (auto& group : groups) {
+            if (group.first == ins.type) {
+                group.second.push_back(v);
+                return;
+            }
+        }
+        groups.push_back({ins.type, {v}});
+    };
+    for (Value v : fn->undefs) {
+        if (!fn->values[v].dead && uses[v]) declare(fn->values[v], v);
+    }
+    for (BlockId b = 0; b < fn->blocks.size(); ++b) {
+        const ir::Block& block = fn->blocks[b];
+        if (block.dead) continue;
+        for (Value v : block.phis) declare(fn->values[v], v);
+        for (Value v : block.code) {
+            const Instruction& ins = fn->values[v];
+            if (!ins.type || ins.op == Op::Const) continue;
+            if (ins.op == Op::Call && !uses[v]) continue;
+            declare(ins, v);
+        }
+    }
+
+    for (const auto& [type, values] : groups) {
+        output.indent(indentLevel);
+        output << typeName(type);
+        for (size_t i = 0; i < values.size(); ++i) {
+            output << std::string_view(i ? ", _t" : " _t") << static_cast<int64_t>(values[i]) << "{}";
+        }
+        output << ";\n";
+    }
+}
+
+void ccfn value(Value v) {
+    const Instruction& ins = fn->values[v];
+    if (ins.op == Op::Param) {
+        output << ins.name.str();
+        return;
+    }
+    if (ins.op != Op::Const) {
+        output << "_t" << static_cast<int64_t>(v);
+        return;
+    }
+
+    switch (ins.type->kind) {
+        case Type::BOOL:
+            output << std::string_view(ins.integer ? "true" : "false");
+            break;
+        case Type::FLOAT:
+        case Type::DOUBLE: {
+            // CodeGenerator 의 실수 리터럴과 같게 쓴다
+            char buf[32];
+            char* end = std::to_chars(buf, buf + sizeof buf, ins.real).ptr;
+            std::string_view text(buf, static_cast<size_t>(end - buf));
+            output << text;
+            if (text.find_first_of(".e") == std::string_view::npos) output << ".0";
+            break;
+        }
+        case Type::STRING:
+            // "a" + "b" 가 포인터 덧셈이 되지 않도록 std::string 으로 만든다
+            output << "std::string(\"" << ins.text << "\")";
+            break;
+        default:
+            if (ins.integer == INT_MIN) output << "(-2147483647 - 1)";
+            else if (ins.integer < 0) output << "(" << ins.integer << ")";
+            else output << ins.integer;
+            break;
+    }
+}
+
+void ccfn instruction(Value v) {
+    const Instruction& ins = fn->values[v];
+    switch (ins.op) {
+        case Op::Const:
+        case Op::Phi:
+        case Op::Param:
+        case Op::Undef:
+            return;
+        default:
+            break;
+    }
+
+    output.indent(indentLevel);
+    if (ins.type && (ins.op != Op::Call || uses[v])) {
+        output << "_t" << static_cast<int64_t>(v) << " = ";
+    }
+    switch (ins.op) {
+        case Op::Copy:
+            value(ins.operands[0]);
+            break;
+        case Op::Cast:
+            output << "static_cast<" << typeName(ins.type) << ">(";
+            value(ins.operands[0]);
+            output << ")";
+            break;
+        case Op::Binary:
+            output << "(";
+            value(ins.operands[0]);
+            output << " " << ir::spelling(ins.operator_) << " ";
+            value(ins.operands[1]);
+            output << ")";
+            break;
+        case Op::Unary:
+            output << "(" << ir::spelling(ins.operator_);
+            value(ins.operands[0]);
+            output << ")";
+            break;
+        case Op::Load:
+            output << ins.name.str();
+            break;
+        case Op::Store:
+            output << ins.name.str() << " = ";
+            value(ins.operands[0]);
+            break;
+        case Op::Call:
+            output << ins.name.str() << "(";
+            for (size_t i = 0; i < ins.operands.size(); ++i) {
+                if (i) output << ", ";
+                value(ins.operands[i]);
+            }
+            output << ")";
+            break;
+        default:
+            break;
+    }
+    output << ";\n";
+}
+
+bool ccfn hasCopies(BlockId from, BlockId to) const {
+    const ir::Block& target = fn->blocks[to];
+    if (target.phis.empty()) return false;
+    size_t index = static_cast<size_t>(std::find(target.preds.begin(), target.preds.end(), from) - target.preds.begin());
+    for (Value phi : target.phis) {
+        if (fn->values[phi].operands[index] != phi) return true;
+    }
+    return false;
+}
+
+void ccfn copies(BlockId from, BlockId to, bool write) {
+    if (!write || !hasCopies(from, to)) return;
+    const ir::Block& target = fn->blocks[to];
+    size_t index = static_cast<size_t>(std::find(target.preds.begin(), target.preds.end(), from) - target.preds.begin());
+
+    std::vector<std::pair<Value, Value>> moves;     // (phi, 넣을 값)
+    bool overlapping = false;
+    for (Value phi : target.phis) {
+        Value source = fn->values[phi].operands[index];
+        if (source == phi) continue;
+        moves.push_back({phi, source});
+        const Instruction& ins = fn->values[source];
+        overlapping = overlapping || (ins.op == Op::Phi && ins.block == to);
+    }
+
+    if (!overlapping) {
+        for (const auto& [phi, source] : moves) {
+            output.indent(indentLevel);
+            output << "_t" << static_cast<int64_t>(phi) << " = ";
+            value(source);
+            output << ";\n";
+        }
+        return;
+    }
+
+    // 동시에 일어나는 복사: 새 값을 모두 읽은 뒤에 쓴다
+    output.indent(indentLevel);
+    output << "{\n";
+    indentLevel++;
+    for (size_t i = 0; i < moves.size(); ++i) {
+        output.indent(indentLevel);
+        output << typeName(fn->values[moves[i].first].type) << " _c" << static_cast<int64_t>(i) << " = ";
+        value(moves[i].second);
+        output << ";\n";
+    }
+    for (size_t i = 0; i < moves.size(); ++i) {
+        output.indent(indentLevel);
+        output << "_t" << static_cast<int64_t>(moves[i].first) << " = _c" << static_cast<int64_t>(i) << ";\n";
+    }
+    indentLevel--;
+    output.indent(indentLevel);
+    output << "}\n";
+}
+
+void ccfn branchTo(BlockId from, BlockId to, BlockId next, bool write) {
+    copies(from, to, write);
+    if (to == next) return;
+    labelled[to] = true;
+    if (!write) return;
+    output.indent(indentLevel);
+    output << "goto _L" << static_cast<int64_t>(to) << ";\n";
+}
+
+void ccfn terminator(BlockId block, BlockId next, bool write) {
+    const Instruction& last = fn->values[fn->blocks[block].code.back()];
+    switch (last.op) {
+        case Op::Return:
+            if (!write) return;
+            output.indent(indentLevel);
+            if (!last.operands.empty()) {
+                output << "return ";
+                value(last.operands[0]);
+                output << ";\n";
+            } else if (fn->returnType == &types::Void) {
+                output << "return;\n";
+            } else {
+                // 값 없이 끝에 닿았다 (main 이면 0)
+                output << "return {};\n";
+            }
+            return;
+        case Op::Jump:
+            branchTo(block, last.targets[0], next, write);
+            return;
+        case Op::Branch: {
+            BlockId whenTrue = last.targets[0];
+            BlockId whenFalse = last.targets[1];
+            if (!hasCopies(block, whenTrue) && !hasCopies(block, whenFalse) && whenTrue == next) {
+                labelled[whenFalse] = true;
+                if (!write) return;
+                output.indent(indentLevel);
+                output << "if (!";
+                value(last.operands[0]);
+                output << ") goto _L" << static_cast<int64_t>(whenFalse) << ";\n";
+                return;
+            }
+
+            labelled[whenTrue] = true;
+            if (write) {
+                output.indent(indentLevel);
+                output << "if (";
+                value(last.operands[0]);
+                if (hasCopies(block, whenTrue)) {
+                    output << ") {\n";
+                    indentLevel++;
+                    copies(block, whenTrue, true);
+                    output.indent(indentLevel);
+                    output << "goto _L" << static_cast<int64_t>(whenTrue) << ";\n";
+                    indentLevel--;
+                    output.indent(indentLevel);
+                    output << "}\n";
+                } else {
+                    output << ") goto _L" << static_cast<int64_t>(whenTrue) << ";\n";
+                }
+            }
+            branchTo(block, whenFalse, next, write);
+            return;
+        }
+        default:
+            return;
+    }
+}
@@ -0,0 +1,587 @@
+#include <IrPasses.hh>
+#include <Profiler.hh>
+#include <Type.hh>
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <functional>
+#include <unordered_map>
+
+namespace ir {
+
+// ===== 조건부 상수 전파 =====
+
+namespace {
+
+enum Lattice : uint8_t { Top, Constant, Bottom };
+
+// 상수로 따라가는 타입. 생성된 C++ 에서 int 와 bool 인 값만 본다.
+inline bool isTracked(const Type* type) {
+    return type == &types::Int || type == &types::Bool;
+}
+
+inline bool fitsInt(int64_t value) {
+    return value >= INT_MIN && value <= INT_MAX;
+}
+
+bool foldBinary(TokenType op, const Type* type, int64_t a, int64_t b, int64_t& result) {
+    if (type == &types::Bool && (op == TokenType::LOGICAL_AND || op == TokenType::LOGICAL_OR)) {
+        result = op == TokenType::LOGICAL_AND ? (a && b) : (a || b);
+        return true;
+    }
+    switch (op) {
+        case TokenType::PLUS: result = a + b; break;
+        case TokenType::MINUS: result = a - b; break;
+        case TokenType::MULTIPLY: result = a * b; break;
+        case TokenType::DIVIDE:
+        case TokenType::MODULO:
+            if (b == 0 || (a == INT_MIN && b == -1)) return false;
+            result = op == TokenType::DIVIDE ? a / b : a % b;
+            break;
+        case TokenType::BIT_AND: result = a & b; break;
+        case TokenType::BIT_OR: result = a | b; break;
+        case TokenType::BIT_XOR: result = a ^ b; break;
+        case TokenType::LEFT_SHIFT:
+            if (a < 0 || b < 0 || b >= 32) return false;
+            result = a << b;
+            break;
+        case TokenType::RIGHT_SHIFT:
+            if (b < 0 || b >= 32) return false;
+            result = a >> b;
+            break;
+        case TokenType::EQUAL: result = a == b; return true;
+        case TokenType::NOT_EQUAL: result = a != b; return true;
+        case TokenType::LESS: result = a < b; return true;
+        case TokenType::GREATER: result = a > b; return true;
+        case TokenType::LESS_EQUAL: result = a <= b; return true;
+        case TokenType::GREATER_EQUAL: result = a >= b; return true;
+        default: return false;
+    }
+    return type == &types::Int && fitsInt(result);
+}
+
+bool foldUnary(TokenType op, int64_t a, int64_t& result) {
+    switch (op) {
+        case TokenType::MINUS: result = -a; return fitsInt(result);
+        case TokenType::PLUS: result = a; return true;
+        case TokenType::BIT_NOT: result = ~a; return true;
+        case TokenType::LOGICAL_NOT: result = !a; return true;
+        default: return false;
+    }
+}
+
+class ConstantPropagation {
+private:
+    Function& fn;
+    std::vector<uint8_t> state;
+    std::vector<int64_t> constant;
+    std::vector<std::vector<Value>> users;
+    std::vector<bool> executable;
+    std::vector<std::vector<bool>> liveEdges;      // 블록마다 preds 와 같은 순서
+    std::vector<std::pair<BlockId, BlockId>> flowWork;
+    std::vector<Value> ssaWork;
+
+    void lower(Value v, uint8_t to, int64_t value = 0) {
+        if (to <= state[v]) return;     // Top → Constant → Bottom 으로만 내려간다
+        state[v] = to;
+        constant[v] = value;
+        ssaWork.push_back(v);
+    }
+
+    void markEdge(BlockId from, BlockId to) {
+        flowWork.push_back({from, to});
+    }
+
+    void evaluatePhi(Value v) {
+        const Instruction& ins = fn.values[v];
+        if (!isTracked(ins.type)) return lower(v, Bottom);
+        const std::vector<BlockId>& preds = fn.blocks[ins.block].preds;
+        uint8_t meet = Top;
+        int64_t value = 0;
+        for (size_t i = 0; i < ins.operands.size() && i < preds.size(); ++i) {
+            if (!liveEdges[ins.block][i]) continue;
+            Value operand = ins.operands[i];
+            if (state[operand] == Top) continue;
+            if (state[operand] == Bottom) return lower(v, Bottom);
+            if (meet == Constant && value != constant[operand]) return lower(v, Bottom);
+            meet = Constant;
+            value = constant[operand];
+        }
+        if (meet == Constant) lower(v, Constant, value);
+    }
+
+    void evaluate(Value v) {
+        const Instruction& ins = fn.values[v];
+        switch (ins.op) {
+            case Op::Phi:
+                evaluatePhi(v);
+                return;
+            case Op::Const:
+                if (isTracked(ins.type)) lower(v, Constant, ins.integer);
+                else lower(v, Bottom);
+                return;
+            case Op::Copy: {
+                Value operand = ins.operands[0];
+                if (state[operand] != Top) lower(v, state[operand], constant[operand]);
+                return;
+            }
+            case Op::Binary: {
+                if (!isTracked(ins.type)) return lower(v, Bottom);
+                Value a = ins.operands[0], b = ins.operands[1];
+                if (!isTracked(fn.values[a].type) || fn.values[a].type != fn.values[b].type) return lower(v, Bottom);
+                if (state[a] == Bottom || state[b] == Bottom) return lower(v, Bottom);
+                if (state[a] == Top || state[b] == Top) return;
+                int64_t result;
+                if (foldBinary(ins.operator_, fn.values[a].type, constant[a], constant[b], result)) {
+                    lower(v, Constant, result);
+                } else {
+                    lower(v, Bottom);
+                }
+                return;
+            }
+            case Op::Unary: {
+                Value a = ins.operands[0];
+                if (!isTracked(ins.type) || fn.values[a].type != ins.type) return lower(v, Bottom);
+                if (state[a] != Constant) {
+                    if (state[a] == Bottom) lower(v, Bottom);
+                    return;
+                }
+                int64_t result;
+                if (foldUnary(ins.operator_, constant[a], result)) lower(v, Constant, result);
+                else lower(v, Bottom);
+                return;
+            }
+            case Op::Branch: {
+                Value condition = ins.operands[0];
+                if (state[condition] == Top) return;
+                if (state[condition] == Constant) {
+                    markEdge(ins.block, ins.targets[constant[condition] ? 0 : 1]);
+                } else {
+                    markEdge(ins.block, ins.targets[0]);
+                    markEdge(ins.block, ins.targets[1]);
+                }
+                return;
+            }
+            case Op::Jump:
+                markEdge(ins.block, ins.targets[0]);
+                return;
+            case Op::Return:
+            case Op::Store:
+                return;
+            default:
+                // 매개변수, 전역 읽기, 호출, 변환은 알 수 없는 값이다
+                if (ins.type) lower(v, Bottom);
+                return;
+        }
+    }
+
+    void visitEdge(BlockId from, BlockId to) {
+        Block& block = fn.blocks[to];
+        if (from != None) {
+            const std::vector<BlockId>& preds = block.preds;
+            for (size_t i = 0; i < preds.size(); ++i) {
+                if (preds[i] != from || liveEdges[to][i]) continue;
+                liveEdges[to][i] = true;
+                break;
+            }
+        }
+        if (executable[to]) {
+            // 새로 살아난 간선은 phi 만 바꾼다
+            for (Value phi : block.phis) evaluate(phi);
+            return;
+        }
+        executable[to] = true;
+        for (Value phi : block.phis) evaluate(phi);
+        for (Value v : block.code) evaluate(v);
+    }
+
+    void solve() {
+        markEdge(None, 0);
+        while (!flowWork.empty() || !ssaWork.empty()) {
+            while (!flowWork.empty()) {
+                auto [from, to] = flowWork.back();
+                flowWork.pop_back();
+                visitEdge(from, to);
+            }
+            while (!ssaWork.empty()) {
+                Value v = ssaWork.back();
+                ssaWork.pop_back();
+                for (Value user : users[v]) {
+                    if (executable[fn.values[user].block]) evaluate(user);
+                }
+            }
+        }
+    }
+
+    // 조건이 아직 Top 인 분기가 있으면 실행되지 않는다고 본 블록을 지울 수 없다
+    bool settled() const {
+        for (BlockId b = 0; b < fn.blocks.size(); ++b) {
+            if (!executable[b] || fn.blocks[b].code.empty()) continue;
+            const Instruction& last = fn.values[fn.blocks[b].code.back()];
+            if (last.op == Op::Branch && state[last.operands[0]] == Top) return false;
+        }
+        return true;
+    }
+
+public:
+    explicit ConstantPropagation(Function& function) : fn(function) {
+        size_t n = fn.values.size();
+        state.assign(n, Top);
+        constant.assign(n, 0);
+        users.resize(n);
+        executable.assign(fn.blocks.size(), false);
+        liveEdges.resize(fn.blocks.size());
+        for (BlockId b = 0; b < fn.blocks.size(); ++b) {
+            const Block& block = fn.blocks[b];
+            liveEdges[b].assign(block.preds.size(), false);
+            for (Value v : block.phis) {
+                for (Value operand : fn.values[v].operands) users[operand].push_back(v);
+            }
+            for (Value v : block.code) {
+                for (Value operand : fn.values[v].operands) users[operand].push_back(v);
+            }
+        }
+        for (Value v : fn.params) state[v] = Bottom;
+        for (Value v : fn.undefs) state[v] = Bottom;
+    }
+
+    bool run() {
+        solve();
+        if (!settled()) return false;
+
+        bool changed = false;
+        for (BlockId b = 0; b < fn.blocks.size(); ++b) {
+            if (!executable[b]) continue;
+            Block& block = fn.blocks[b];
+
+            // 상수가 된 값은 그 자리에서 Const 로 바꾼다. 쓰는 쪽은 고칠 필요가 없다.
+            std::vector<Value> constants;
+            for (Value v : block.phis) {
+                if (state[v] == Constant) constants.push_back(v);
+            }
+            for (Value v : block.code) {
+                Instruction& ins = fn.values[v];
+                if (state[v] != Constant || ins.op == Op::Const) continue;
+                ins.op = Op::Const;
+                ins.integer = constant[v];
+                ins.operands.clear();
+                changed = true;
+            }
+            if (!constants.empty()) {
+                for (Value v : constants) {
+                    Instruction& ins = fn.values[v];
+                    ins.op = Op::Const;
+                    ins.integer = constant[v];
+                    ins.operands.clear();
+                }
+                block.phis.erase(std::remove_if(block.phis.begin(), block.phis.end(),
+                    [this](Value v) { return state[v] == Constant; }), block.phis.end());
+                block.code.insert(block.code.begin(), constants.begin(), constants.end());
+                changed = true;
+            }
+
+            // 조건이 상수인 분기는 점프가 된다
+            if (block.code.empty()) continue;
+            Instruction& last = fn.values[block.code.back()];
+            if (last.op == Op::Branch && state[last.operands[0]] == Constant) {
+                bool taken = constant[last.operands[0]] != 0;
+                BlockId target = last.targets[taken ? 0 : 1];
+                BlockId other = last.targets[taken ? 1 : 0];
+                last.op = Op::Jump;
+                last.operands.clear();
+                last.targets[0] = target;
+                last.targets[1] = None;
+                fn.removeEdge(b, other);
+                changed = true;
+            }
+        }
+        // 실행되지 않는 블록은 이제 입구에서 닿지 않는다
+        return fn.removeUnreachable() || changed;
+    }
+};
+
+}
+
+bool propagateConstants(Function& fn) {
+    fn.canonicalize();
+    bool changed = ConstantPropagation(fn).run();
+    fn.canonicalize();
+    return changed;
+}
+
+// ===== 복사 전파 =====
+
+// 자기 자신을 빼면 피연산자가 하나뿐인 phi 의 그 피연산자. 아니면 None.
+static Value trivialOperand(Function& fn, Value phi) {
+    Value same = None;
+    for (Value operand : fn.values[phi].operands) {
+        operand = fn.resolve(operand);
+        if (operand == same || operand == phi) continue;
+        if (same != None) return None;
+        same = operand;
+    }
+    return same;
+}
+
+bool propagateCopies(Function& fn) {
+    fn.canonicalize();
+    bool changed = false;
+    // phi 를 하나 지우면 그 phi 를 쓰던 phi 가 자명해질 수 있으므로 바뀌지 않을 때까지 돈다
+    for (bool again = true; again;) {
+        again = false;
+        for (Block& block : fn.blocks) {
+            if (block.dead) continue;
+            for (Value v : block.phis) {
+                if (fn.values[v].dead) continue;
+                Value same = trivialOperand(fn, v);
+                if (same == None) continue;
+                fn.replace(v, same);
+                again = true;
+            }
+            for (Value v : block.code) {
+                Instruction& ins = fn.values[v];
+                if (ins.dead) continue;
+                bool copy = ins.op == Op::Copy ||
+                    (ins.op == Op::Cast && fn.values[fn.resolve(ins.operands[0])].type == ins.type);
+                if (!copy) continue;
+                fn.replace(v, fn.resolve(ins.operands[0]));
+                again = true;
+            }
+        }
+        changed = changed || again;
+    }
+    fn.canonicalize();
+    return changed;
+}
+
+// ===== 전역 값 번호 =====
+
+namespace {
+
+struct ValueKey {
+    Op op;
+    TokenType operator_;
+    const Type* type;
+    BlockId block;                  // phi 는 같은 블록에서만 같다
+    int64_t integer;
+    uint64_t real;                  // 비트 그대로 (0.0 과 -0.0 은 다르다)
+    std::string_view text;
+    std::vector<Value> operands;
+
+    bool operator==(const ValueKey& o) const {
+        return op == o.op && operator_ == o.operator_ && type == o.type && block == o.block &&
+            integer == o.integer && real == o.real && text == o.text && operands == o.operands;
+    }
+};
+
+struct ValueKeyHash {
+    size_t operator()(const ValueKey& key) const {
+        size_t h = static_cast<size_t>(key.op) * 31 + static_cast<size_t>(key.operator_);
+        auto mix = [&h](size_t x) { h ^= x + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2); };
+        mix(std::hash<const void*>()(key.type));
+        mix(key.block);
+        mix(static_cast<size_t>(key.integer));
+        mix(static_cast<size_t>(key.real));
+        mix(std::hash<std::string_view>()(key.text));
+        for (Value operand : key.operands) mix(operand);
+        return h;
+    }
+};
+
+inline bool isCommutative(const Instruction& ins) {
+    switch (ins.operator_) {
+        case TokenType::PLUS: return ins.type != &types::String;
+        case TokenType::MULTIPLY:
+        case TokenType::EQUAL:
+        case TokenType::NOT_EQUAL:
+        case TokenType::BIT_AND:
+        case TokenType::BIT_OR:
+        case TokenType::BIT_XOR:
+        case TokenType::LOGICAL_AND:
+        case TokenType::LOGICAL_OR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// 역후위 순서 위에서 도는 Cooper-Harvey-Kennedy 지배자 계산
+std::vector<BlockId> dominators(const Function& fn, const std::vector<BlockId>& order) {
+    std::vector<uint32_t> position(fn.blocks.size(), None);
+    for (uint32_t i = 0; i < order.size(); ++i) position[order[i]] = i;
+
+    std::vector<BlockId> idom(fn.blocks.size(), None);
+    idom[order[0]] = order[0];
+    auto intersect = [&](BlockId a, BlockId b) {
+        while (a != b) {
+            while (position[a] > position[b]) a = idom[a];
+            while (position[b] > position[a]) b = idom[b];
+        }
+        return a;
+    };
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (size_t i = 1; i < order.size(); ++i) {
+            BlockId b = order[i];
+            BlockId dom = None;
+            for (BlockId pred : fn.blocks[b].preds) {
+                if (position[pred] == None || idom[pred] == None) continue;
+                dom = dom == None ? pred : intersect(pred, dom);
+            }
+            if (dom != idom[b]) {
+                idom[b] = dom;
+                changed = true;
+            }
+        }
+    }
+    return idom;
+}
+
+}
+
+bool numberValues(Function& fn) {
+    fn.canonicalize();
+    std::vector<BlockId> order = fn.reversePostorder();
+    std::vector<BlockId> idom = dominators(fn, order);
+    std::vector<std::vector<BlockId>> children(fn.blocks.size());
+    for (size_t i = 1; i < order.size(); ++i) children[idom[order[i]]].push_back(order[i]);
+
+    // 지배 트리를 내려가며 쓰는 범위 있는 표. 블록을 떠날 때 그 블록이 넣은 항목을 뺀다.
+    std::unordered_map<ValueKey, Value, ValueKeyHash> available;
+    std::vector<const ValueKey*> inserted;
+    bool changed = false;
+
+    auto number = [&](Value v, BlockId block) {
+        Instruction& ins = fn.values[v];
+        ValueKey key{ins.op, ins.operator_, ins.type, ins.op == Op::Phi ? block : None,
+            ins.integer, 0, ins.text, {}};
+        std::memcpy(&key.real, &ins.real, sizeof key.real);
+        key.operands.reserve(ins.operands.size());
+        for (Value operand : ins.operands) key.operands.push_back(fn.resolve(operand));
+        if (ins.op == Op::Binary && isCommutative(ins) && key.operands[0] > key.operands[1]) {
+            std::swap(key.operands[0], key.operands[1]);
+        }
+        auto [it, added] = available.emplace(std::move(key), v);
+        if (added) {
+            inserted.push_back(&it->first);
+        } else {
+            fn.replace(v, it->second);
+            changed = true;
+        }
+    };
+
+    std::vector<std::pair<BlockId, size_t>> stack{{order[0], 0}};
+    std::vector<size_t> marks{0};
+    auto enter = [&](BlockId b) {
+        Block& block = fn.blocks[b];
+        for (Value v : block.phis) {
+            Value same = trivialOperand(fn, v);
+            if (same != None) {
+                fn.replace(v, same);
+                changed = true;
+                continue;
+            }
+            number(v, b);
+        }
+        for (Value v : block.code) {
+            const Instruction& ins = fn.values[v];
+            if (ins.op == Op::Copy) {
+                fn.replace(v, fn.resolve(ins.operands[0]));
+                changed = true;
+            } else if (isPure(ins.op)) {
+                number(v, b);
+            }
+        }
+    };
+    enter(order[0]);
+    while (!stack.empty()) {
+        auto& [b, next] = stack.back();
+        if (next < children[b].size()) {
+            BlockId child = children[b][next++];
+            marks.push_back(inserted.size());
+            stack.push_back({child, 0});
+            enter(child);
+            continue;
+        }
+        for (size_t i = marks.back(); i < inserted.size(); ++i) {
+            ValueKey key = *inserted[i];    // 지우는 원소의 키를 그대로 넘기지 않는다
+            available.erase(key);
+        }
+        inserted.resize(marks.back());
+        marks.pop_back();
+        stack.pop_back();
+    }
+
+    fn.canonicalize();
+    return changed;
+}
+
+// ===== 죽은 코드 제거 =====
+
+bool eliminateDeadCode(Function& fn) {
+    bool changed = fn.removeUnreachable();
+    fn.canonicalize();
+
+    std::vector<bool> live(fn.values.size(), false);
+    std::vector<Value> worklist;
+    for (const Block& block : fn.blocks) {
+        if (block.dead) continue;
+        for (Value v : block.code) {
+            if (hasSideEffects(fn.values[v].op)) {
+                live[v] = true;
+                worklist.push_back(v);
+            }
+        }
+    }
+    while (!worklist.empty()) {
+        Value v = worklist.back();
+        worklist.pop_back();
+        for (Value operand : fn.values[v].operands) {
+            if (live[operand]) continue;
+            live[operand] = true;
+            worklist.push_back(operand);
+        }
+    }
+
+    for (Block& block : fn.blocks) {
+        if (block.dead) continue;
+        for (Value v : block.phis) {
+            if (!live[v]) fn.values[v].dead = changed = true;
+        }
+        for (Value v : block.code) {
+            if (!live[v]) fn.values[v].dead = changed = true;
+        }
+    }
+    for (Value v : fn.undefs) {
+        if (!live[v]) fn.values[v].dead = true;
+    }
+    fn.canonicalize();
+    return changed;
+}
+
+// ===== 패스 관리자 =====
+
+void PassManager::run(Module& module) {
+    for (Entry& pass : passes) {
+        ZUST_PROFILE_SCOPE(scope, pass.name);
+        size_t instructions = 0;
+        for (const std::unique_ptr<Function>& fn : module.functions()) {
+            if (pass.run(*fn)) pass.changed++;
+            instructions += fn->size();
+        }
+        ZUST_PROFILE_COUNT(scope, NODES, instructions);
+        (void)instructions;
+    }
+}
+
+PassManager PassManager::standard() {
+    PassManager manager;
+    manager.add("ir-sccp", propagateConstants);
+    manager.add("ir-copyprop", propagateCopies);
+    manager.add("ir-gvn", numberValues);
+    manager.add("ir-dce", eliminateDeadCode);
+    return manager;
+}
+
+}
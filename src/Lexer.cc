@@ -1,35 +1,36 @@
 #include <Lexer.hh>
+#include <Keywords.hh>
+#include <Scan.hh>
+#include <cstring>
 
 #undef ccfunc
 #define ccfunc Lexer::
 
-void ccfunc initKeywords() {
-    this->keywords = {
-        {"let", TokenType::LET}, {"fn", TokenType::FN},
-        {"if", TokenType::IF}, {"while", TokenType::WHILE},
-        {"for", TokenType::FOR}, {"foreach", TokenType::FOREACH},
-        {"switch", TokenType::SWITCH}, {"case", TokenType::CASE},
-        {"default", TokenType::DEFAULT}, {"namespace", TokenType::NAMESPACE},
-        {"import", TokenType::IMPORT}, {"return", TokenType::RETURN},
-        {"break", TokenType::BREAK}, {"continue", TokenType::CONTINUE},
-        {"int", TokenType::INT}, {"float", TokenType::FLOAT},
-        {"char", TokenType::CHAR}, {"byte", TokenType::BYTE},
-        {"long", TokenType::LONG}, {"double", TokenType::DOUBLE},
-        {"short", TokenType::SHORT}, {"bool", TokenType::BOOL},
-        {"string", TokenType::STRING}, {"void", TokenType::VOID},
-        {"true", TokenType::BOOL_LITERAL}, {"false", TokenType::BOOL_LITERAL}
-    };
-}
-
 char ccfunc peek(int offset) const {
     if (pos + offset >= source.length()) return '\0';
     return source[pos + offset];
 }
 
-void ccfunc skipWhitespace() {
-    while (pos < source.length() && isspace(peek()) && peek() != '\n') {
-        advance();
+// [pos, to) 구간을 한 번에 건너뛰고, 구간 안의 개행 수로 줄/열을 다시 계산한다
+void ccfunc skipTo(const char* to) {
+    const char* from = source.data() + pos;
+    size_t newlines = scan::countNewlines(from, to);
+    if (newlines == 0) {
+        column += static_cast<int>(to - from);
+    } else {
+        const char* last = to;
+        while (*--last != '\n') {}
+        line += static_cast<int>(newlines);
+        column = static_cast<int>(to - last);
     }
+    pos = to - source.data();
+}
+
+void ccfunc skipWhitespace() {
+    const char* from = source.data() + pos;
+    const char* to = scan::skipBlanks(from, source.data() + source.length());
+    column += static_cast<int>(to - from);
+    pos = to - source.data();
 }
 
 char ccfunc advance() {
@@ -45,7 +46,7 @@ char ccfunc advance() {
 }
 
 Token ccfunc readNumber() {
-    std::string num;
+    size_t start = pos;
     int startLine = line, startCol = column;
     bool isFloat = false;
     
@@ -54,34 +55,54 @@ Token ccfunc readNumber() {
             if (isFloat) break; // 두 번째 점은 허용하지 않음
             isFloat = true;
         }
-        num += advance();
+        advance();
     }
     
     TokenType type = isFloat ? TokenType::FLOAT_LITERAL : TokenType::INTEGER_LITERAL;
-    return Token(type, num, startLine, startCol);
+    return Token(type, slice(start), startLine, startCol);
 }
 
 
 Token ccfunc readString() {
-    std::string str;
     int startLine = line, startCol = column;
     advance(); // 시작 따옴표 건너뛰기
+    size_t start = pos;
+    const char* end = source.data() + source.length();
     
-    while (pos < source.length() && peek() != '"') {
-        if (peek() == '\\') {
-            advance(); // 백슬래시 건너뛰기
-            char escaped = advance();
-            switch (escaped) {
-                case 'n': str += '\n'; break;
-                case 't': str += '\t'; break;
-                case 'r': str += '\r'; break;
-                case '\\': str += '\\'; break;
-                case '"': str += '"'; break;
-                default: str += escaped; break;
+    // 이스케이프가 없으면 소스 버퍼를 그대로 가리킨다
+    skipTo(scan::findQuoteOrBackslash(source.data() + pos, end));
+    
+    std::string_view str = slice(start);
+    if (peek() == '\\') {
+        // 이스케이프가 있으면 아레나에 풀어서 저장한다 (풀린 길이는 원문보다 길지 않다)
+        const char* close = source.data() + pos;
+        while ((close = scan::findQuoteOrBackslash(close, end)) < end && *close == '\\') {
+            close += (close + 1 < end) ? 2 : 1;
+        }
+        char* out = literals.allocate(close - (source.data() + start));
+        size_t n = str.size();
+        std::memcpy(out, str.data(), n);
+        
+        while (pos < source.length() && peek() != '"') {
+            if (peek() == '\\') {
+                advance(); // 백슬래시 건너뛰기
+                char escaped = advance();
+                switch (escaped) {
+                    case 'n': out[n++] = '\n'; break;
+                    case 't': out[n++] = '\t'; break;
+                    case 'r': out[n++] = '\r'; break;
+                    case '\\': out[n++] = '\\'; break;
+                    case '"': out[n++] = '"'; break;
+                    default: out[n++] = escaped; break;
+                }
+            } else {
+                size_t from = pos;
+                skipTo(scan::findQuoteOrBackslash(source.data() + pos, end));
+                std::memcpy(out + n, source.data() + from, pos - from);
+                n += pos - from;
             }
-        } else {
-            str += advance();
         }
+        str = std::string_view(out, n);
     }
     
     if (peek() == '"') advance(); // 끝 따옴표 건너뛰기
@@ -92,167 +113,188 @@ Token ccfunc readChar() {
     int startLine = line, startCol = column;
     advance(); // 시작 단일 따옴표 건너뛰기
     
-    char c = advance();
+    size_t start = pos;
+    advance();
+    std::string_view c = slice(start);
     if (peek() == '\'') advance(); // 끝 단일 따옴표 건너뛰기
     
-    return Token(TokenType::CHAR_LITERAL, std::string(1, c), startLine, startCol);
+    return Token(TokenType::CHAR_LITERAL, c, startLine, startCol);
 }
 
 Token ccfunc readIdentifier() {
-    std::string id;
+    size_t start = pos;
     int startLine = line, startCol = column;
     
     while (pos < source.length() && (isalnum(peek()) || peek() == '_')) {
-        id += advance();
+        advance();
     }
     
-    TokenType type = TokenType::IDENTIFIER;
-    if (keywords.find(id) != keywords.end()) {
-        type = keywords[id];
+    std::string_view id = slice(start);
+    TokenType type = classifyKeyword(id);
+    if (type == TokenType::IDENTIFIER) {
+        return Token(type, intern(id), id, startLine, startCol);
     }
-    
     return Token(type, id, startLine, startCol);
 }
 
 Token ccfunc readComment() {
-    std::string comment;
     int startLine = line, startCol = column;
     advance(); // # 건너뛰기
+    size_t start = pos;
     
-    while (pos < source.length() && peek() != '\n') {
-        comment += advance();
-    }
+    const char* from = source.data() + pos;
+    const char* to = scan::findNewline(from, source.data() + source.length());
+    column += static_cast<int>(to - from);
+    pos = to - source.data();
     
-    return Token(TokenType::COMMENT, comment, startLine, startCol);
+    return Token(TokenType::COMMENT, slice(start), startLine, startCol);
 }
 
-std::vector<Token> ccfunc tokenize() {
-    std::vector<Token> tokens;
+Token ccfunc next() {
+    skipWhitespace();
+    start = pos;
     
-    while (pos < source.length()) {
-        skipWhitespace();
-        
-        if (pos >= source.length()) break;
-        
-        char c = peek();
-        int startLine = line, startCol = column;
-        
-        if (c == '\n') {
-            advance();
-            tokens.emplace_back(TokenType::NEWLINE, "\\n", startLine, startCol);
-        }
-        else if (c == '#') {
-            tokens.push_back(readComment());
-        }
-        else if (isdigit(c)) {
-            tokens.push_back(readNumber());
-        }
-        else if (c == '"') {
-            tokens.push_back(readString());
-        }
-        else if (c == '\'') {
-            tokens.push_back(readChar());
-        }
-        else if (isalpha(c) || c == '_') {
-            tokens.push_back(readIdentifier());
-        }
-        else {
-            // 연산자 및 구분자 처리
-            switch (c) {
-                #define tokemplace(c, toktype)  tokens.emplace_back(toktype, c, startLine, startCol);
-                #define caseone(c, toktype)     case (c)[0]: advance(); tokemplace(c, toktype); break;
+    if (pos >= source.length()) {
+        return Token(TokenType::EOF_TOKEN, "", line, column);
+    }
+    
+    char c = peek();
+    int startLine = line, startCol = column;
+    
+    if (c == '\n') {
+        advance();
+        return Token(TokenType::NEWLINE, "\\n", startLine, startCol);
+    }
+    if (c == '#') {
+        return readComment();
+    }
+    if (isdigit(c)) {
+        return readNumber();
+    }
+    if (c == '"') {
+        return readString();
+    }
+    if (c == '\'') {
+        return readChar();
+    }
+    if (isalpha(c) || c == '_') {
+        return readIdentifier();
+    }
+    
+    // 연산자 및 구분자 처리
+    switch (c) {
+        #define tokreturn(c, toktype)   return Token(toktype, c, startLine, startCol);
+        #define caseone(c, toktype)     case (c)[0]: advance(); tokreturn(c, toktype);
 
-                caseone("+", TokenType::PLUS);
-                caseone("-", TokenType::MINUS);
-                caseone("*", TokenType::MULTIPLY);
-                caseone("/", TokenType::DIVIDE);
-                caseone("%", TokenType::MODULO);
-                caseone(":", TokenType::COLUMN);
+        // 한 글자 연산자 뒤에 '=' 가 오면 복합 대입
+        #define casecompound(c, toktype, assigntype) \
+            case (c)[0]: \
+                advance(); \
+                if (peek() == '=') { advance(); tokreturn(c "=", assigntype); } \
+                tokreturn(c, toktype);
 
-                case '=':
-                    advance();
-                    if (peek() == '=') {
-                        advance();
-                        tokemplace("==", TokenType::EQUAL);
-                    } else {
-                        tokemplace("=", TokenType::ASSIGN);
-                    }
-                    break;
-                case '!':
-                    advance();
-                    if (peek() == '=') {
-                        advance();
-                        tokemplace("!=", TokenType::NOT_EQUAL);
-                    } else {
-                        tokemplace("!", TokenType::LOGICAL_NOT);
-                    }
-                    break;
-                case '<':
-                    advance();
+        casecompound("+", TokenType::PLUS, TokenType::PLUS_ASSIGN);
+        casecompound("-", TokenType::MINUS, TokenType::MINUS_ASSIGN);
+        casecompound("*", TokenType::MULTIPLY, TokenType::MULTIPLY_ASSIGN);
+        casecompound("/", TokenType::DIVIDE, TokenType::DIVIDE_ASSIGN);
+        casecompound("%", TokenType::MODULO, TokenType::MODULO_ASSIGN);
+        caseone(":", TokenType::COLUMN);
 
-                    if (peek() == '=') {
-                        advance();
-                        tokemplace("<=", TokenType::LESS_EQUAL);
-                    } else if (peek() == '<') {
-                        advance();
-                        tokemplace("<<", TokenType::LEFT_SHIFT);
-                    } else {
-                        tokemplace("<", TokenType::LESS);
-                    }
-                    break;
-                case '>':
-                    advance();
-                    if (peek() == '=') {
-                        advance();
-                        tokemplace(">=", TokenType::GREATER_EQUAL);
-                    } else if (peek() == '>') {
-                        advance();
-                        tokemplace(">>", TokenType::RIGHT_SHIFT);
-                    } else {
-                        tokemplace(">", TokenType::GREATER);
-                    }
-                    break;
-                case '&':
+        case '=':
+            advance();
+            if (peek() == '=') {
+                advance();
+                tokreturn("==", TokenType::EQUAL);
+            }
+            tokreturn("=", TokenType::ASSIGN);
+        case '!':
+            advance();
+            if (peek() == '=') {
+                advance();
+                tokreturn("!=", TokenType::NOT_EQUAL);
+            }
+            tokreturn("!", TokenType::LOGICAL_NOT);
+        case '<':
+            advance();
+            if (peek() == '=') {
+                advance();
+                tokreturn("<=", TokenType::LESS_EQUAL);
+            }
+            if (peek() == '<') {
+                advance();
+                if (peek() == '=') {
                     advance();
-                    if (peek() == '&') {
-                        advance();
-                        tokemplace("&&", TokenType::LOGICAL_AND);
-                    } else {
-                        tokemplace("&", TokenType::BIT_AND);
-                    }
-                    break;
-                case '|':
+                    tokreturn("<<=", TokenType::LEFT_SHIFT_ASSIGN);
+                }
+                tokreturn("<<", TokenType::LEFT_SHIFT);
+            }
+            tokreturn("<", TokenType::LESS);
+        case '>':
+            advance();
+            if (peek() == '=') {
+                advance();
+                tokreturn(">=", TokenType::GREATER_EQUAL);
+            }
+            if (peek() == '>') {
+                advance();
+                if (peek() == '=') {
                     advance();
-                    if (peek() == '|') {
-                        advance();
-                        tokemplace("||", TokenType::LOGICAL_OR);
-                    } else {
-                        tokemplace("|", TokenType::BIT_OR);
-                    }
-                    break;
+                    tokreturn(">>=", TokenType::RIGHT_SHIFT_ASSIGN);
+                }
+                tokreturn(">>", TokenType::RIGHT_SHIFT);
+            }
+            tokreturn(">", TokenType::GREATER);
+        case '&':
+            advance();
+            if (peek() == '&') {
+                advance();
+                tokreturn("&&", TokenType::LOGICAL_AND);
+            }
+            if (peek() == '=') {
+                advance();
+                tokreturn("&=", TokenType::AND_ASSIGN);
+            }
+            tokreturn("&", TokenType::BIT_AND);
+        case '|':
+            advance();
+            if (peek() == '|') {
+                advance();
+                tokreturn("||", TokenType::LOGICAL_OR);
+            }
+            if (peek() == '=') {
+                advance();
+                tokreturn("|=", TokenType::OR_ASSIGN);
+            }
+            tokreturn("|", TokenType::BIT_OR);
 
-                caseone("^", TokenType::BIT_XOR);
-                caseone("~", TokenType::BIT_NOT);
-                caseone(";", TokenType::SEMICOLON);
-                caseone(",", TokenType::COMMA);
-                caseone(".", TokenType::DOT);
-                caseone("(", TokenType::LPAREN);
-                caseone(")", TokenType::RPAREN);
-                caseone("{", TokenType::LBRACE);
-                caseone("}", TokenType::RBRACE);
-                caseone("[", TokenType::LBRACKET);
-                caseone("]", TokenType::RBRACKET);
-                default:
-                    advance();
-                    tokens.emplace_back(TokenType::UNKNOWN, std::string(1, c), startLine, startCol);
-                    break;
+        casecompound("^", TokenType::BIT_XOR, TokenType::XOR_ASSIGN);
+        caseone("~", TokenType::BIT_NOT);
+        caseone(";", TokenType::SEMICOLON);
+        caseone(",", TokenType::COMMA);
+        caseone(".", TokenType::DOT);
+        caseone("(", TokenType::LPAREN);
+        caseone(")", TokenType::RPAREN);
+        caseone("{", TokenType::LBRACE);
+        caseone("}", TokenType::RBRACE);
+        caseone("[", TokenType::LBRACKET);
+        caseone("]", TokenType::RBRACKET);
+        default:
+            advance();
+            return Token(TokenType::UNKNOWN, slice(pos - 1), startLine, startCol);
 
-                #undef caseone
-                #undef tokemplace
-            }
-        }
+        #undef casecompound
+        #undef caseone
+        #undef tokreturn
+    }
+}
+
+std::vector<Token> ccfunc tokenize() {
+    std::vector<Token> tokens;
+    
+    while (true) {
+        tokens.push_back(next());
+        if (tokens.back().type == TokenType::EOF_TOKEN) break;
     }
     
-    tokens.emplace_back(TokenType::EOF_TOKEN, "", line, column);
     return tokens;
-}
\ No newline at end of file
+}
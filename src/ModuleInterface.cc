@@ -0,0 +1,224 @@
+#include <ModuleInterface.hh>
+#include <ASTNode.hh>
+#include <Nodes.hh>
+#include <Program.hh>
+
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+
+#undef ccfn
+#define ccfn ModuleInterface::
+
+namespace {
+
+// 이름을 문자열 표 번호로 바꿔 가며 쓴다. 표는 본문 앞에 와야 하므로 본문을 따로
+// 모았다가 마지막에 합친다.
+class Writer {
+public:
+    std::string body;
+    std::vector<Name> strings;
+    std::unordered_map<Name, uint32_t> index;
+
+    template<typename T>
+    void put(T value) {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        body.append(bytes, sizeof(T));
+    }
+
+    void putName(Name name) {
+        auto [it, added] = index.emplace(name, static_cast<uint32_t>(strings.size()));
+        if (added) strings.push_back(name);
+        put<uint32_t>(it->second);
+    }
+};
+
+class Reader {
+    std::string_view data;
+    size_t pos = 0;
+
+public:
+    std::vector<Name> strings;
+
+    explicit Reader(std::string_view d) : data(d) {}
+
+    void need(size_t n) {
+        if (data.size() - pos < n) {
+            throw std::runtime_error("Truncated module interface");
+        }
+    }
+
+    template<typename T>
+    T get() {
+        need(sizeof(T));
+        T value;
+        std::memcpy(&value, data.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    // 매핑된 바이트를 복사하지 않고 바로 인턴한다
+    std::string_view getBytes(size_t n) {
+        need(n);
+        std::string_view bytes = data.substr(pos, n);
+        pos += n;
+        return bytes;
+    }
+
+    Name getName() {
+        uint32_t i = get<uint32_t>();
+        if (i >= strings.size()) {
+            throw std::runtime_error("Bad name in module interface");
+        }
+        return strings[i];
+    }
+};
+
+const char Magic[4] = {'Z', 'S', 'I', '\0'};
+
+}
+
+// ===== 추출 =====
+
+ModuleInterface ccfn extract(Name name, const Program* program) {
+    ModuleInterface result;
+    result.name = name;
+    for (const ASTNode* stmt : program->statements) {
+        switch (stmt->type) {
+            case NodeType::FUNCTION_DECLARATION: {
+                auto func = static_cast<const Node<NodeType::FUNCTION_DECLARATION>*>(stmt);
+                if (func->name == names::Main) break;
+                ExportedSymbol symbol;
+                symbol.name = func->name;
+                symbol.type = func->returnType;
+                symbol.isFunction = true;
+                symbol.paramBegin = static_cast<uint32_t>(result.params.size());
+                symbol.paramCount = static_cast<uint32_t>(func->parameters.size());
+                for (const Parameter& param : func->parameters) {
+                    result.params.push_back(param);
+                }
+                result.symbols.push_back(symbol);
+                break;
+            }
+            case NodeType::VARIABLE_DECLARATION: {
+                auto var = static_cast<const Node<NodeType::VARIABLE_DECLARATION>*>(stmt);
+                ExportedSymbol symbol;
+                symbol.name = var->name;
+                symbol.type = var->dataType;
+                result.symbols.push_back(symbol);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return result;
+}
+
+// ===== 직렬화 =====
+
+std::string ccfn serialize() const {
+    Writer w;
+    w.putName(name);
+    w.put<uint32_t>(static_cast<uint32_t>(imports.size()));
+    for (const ImportedModule& imported : imports) {
+        w.putName(imported.name);
+        w.put<uint64_t>(imported.stamp.size);
+        w.put<int64_t>(imported.stamp.time);
+    }
+    w.put<uint32_t>(static_cast<uint32_t>(symbols.size()));
+    for (const ExportedSymbol& symbol : symbols) {
+        w.put<uint8_t>(symbol.isFunction ? 1 : 0);
+        w.putName(symbol.name);
+        w.putName(symbol.type);
+        w.put<uint32_t>(symbol.paramCount);
+        for (uint32_t i = 0; i < symbol.paramCount; ++i) {
+            const Parameter& param = params[symbol.paramBegin + i];
+            w.putName(param.type);
+            w.putName(param.name);
+        }
+    }
+
+    Writer head;
+    head.body.append(Magic, 4);
+    head.put<uint32_t>(Version);
+    head.put<uint64_t>(source.size);
+    head.put<int64_t>(source.time);
+    head.put<uint32_t>(static_cast<uint32_t>(w.strings.size()));
+    for (Name string : w.strings) {
+        std::string_view spelling = string.str();
+        head.put<uint32_t>(static_cast<uint32_t>(spelling.size()));
+        head.body.append(spelling);
+    }
+    return head.body + w.body;
+}
+
+static void readHeader(Reader& r, SourceStamp& stamp) {
+    if (r.getBytes(4) != std::string_view(Magic, 4)) {
+        throw std::runtime_error("Not a Zust module interface");
+    }
+    if (r.get<uint32_t>() != ModuleInterface::Version) {
+        throw std::runtime_error("Unsupported module interface version");
+    }
+    stamp.size = r.get<uint64_t>();
+    stamp.time = r.get<int64_t>();
+}
+
+bool ccfn readStamp(std::string_view data, SourceStamp& stamp) {
+    Reader r(data);
+    try {
+        readHeader(r, stamp);
+    } catch (const std::runtime_error&) {
+        return false;
+    }
+    return true;
+}
+
+ModuleInterface ccfn deserialize(std::string_view data) {
+    Reader r(data);
+    ModuleInterface result;
+    readHeader(r, result.source);
+
+    uint32_t numStrings = r.get<uint32_t>();
+    r.need(static_cast<size_t>(numStrings) * 4);     // 항목마다 최소 4바이트
+    r.strings.reserve(numStrings);
+    for (uint32_t i = 0; i < numStrings; ++i) {
+        uint32_t length = r.get<uint32_t>();
+        r.strings.push_back(intern(r.getBytes(length)));
+    }
+
+    result.name = r.getName();
+
+    uint32_t numImports = r.get<uint32_t>();
+    r.need(static_cast<size_t>(numImports) * 20);    // 항목마다 20바이트
+    result.imports.reserve(numImports);
+    for (uint32_t i = 0; i < numImports; ++i) {
+        ImportedModule imported;
+        imported.name = r.getName();
+        imported.stamp.size = r.get<uint64_t>();
+        imported.stamp.time = r.get<int64_t>();
+        result.imports.push_back(imported);
+    }
+
+    uint32_t numSymbols = r.get<uint32_t>();
+    r.need(static_cast<size_t>(numSymbols) * 13);    // 항목마다 최소 13바이트
+    result.symbols.reserve(numSymbols);
+    for (uint32_t i = 0; i < numSymbols; ++i) {
+        ExportedSymbol symbol;
+        symbol.isFunction = r.get<uint8_t>() != 0;
+        symbol.name = r.getName();
+        symbol.type = r.getName();
+        symbol.paramCount = r.get<uint32_t>();
+        symbol.paramBegin = static_cast<uint32_t>(result.params.size());
+        r.need(static_cast<size_t>(symbol.paramCount) * 8);
+        for (uint32_t p = 0; p < symbol.paramCount; ++p) {
+            Parameter param;
+            param.type = r.getName();
+            param.name = r.getName();
+            result.params.push_back(param);
+        }
+        result.symbols.push_back(symbol);
+    }
+    return result;
+}
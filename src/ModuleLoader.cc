@@ -0,0 +1,250 @@
+#include <ModuleLoader.hh>
+#include <AtomicFile.hh>
+#include <ASTNode.hh>
+#include <Compiler.hh>
+#include <Nodes.hh>
+#include <Program.hh>
+#include <SemanticAnalyser.hh>
+#include <SourceBuffer.hh>
+#include <ThreadPool.hh>
+
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+
+#undef ccfn
+#define ccfn ModuleLoader::
+
+namespace fs = std::filesystem;
+
+using ImportStatement = Node<NodeType::IMPORT_STATEMENT>;
+
+static SourceStamp stampOf(const std::string& path) {
+    SourceStamp stamp;
+    stamp.size = static_cast<uint64_t>(fs::file_size(path));
+    stamp.time = static_cast<int64_t>(fs::last_write_time(path).time_since_epoch().count());
+    return stamp;
+}
+
+static std::string interfacePath(const std::string& source) {
+    return fs::path(source).replace_extension(".zsi").string();
+}
+
+static std::string directoryOf(const std::string& path) {
+    return fs::path(path).parent_path().string();
+}
+
+template<typename F>
+static void forEachImport(Program* program, F&& f) {
+    for (ASTNode* stmt : program->statements) {
+        if (stmt->type == NodeType::IMPORT_STATEMENT) {
+            f(static_cast<ImportStatement*>(stmt));
+        }
+    }
+}
+
+// 한 물결의 작업을 돌린다. 하나뿐이면 스레드를 만들지 않는다.
+template<typename T, typename F>
+static void runWave(std::unique_ptr<ThreadPool>& pool, size_t threads, const std::vector<T*>& wave, F&& f) {
+    if (wave.size() == 1) {
+        f(*wave[0]);
+        return;
+    }
+    if (!pool) pool = std::make_unique<ThreadPool>(threads);
+    for (T* item : wave) {
+        pool->submit([&f, item]() { f(*item); });
+    }
+    pool->wait();
+}
+
+ccfn ModuleLoader(std::vector<std::string> paths, size_t threads)
+    : searchPaths(std::move(paths)), threads(threads) {}
+
+ccfn ~ModuleLoader() = default;
+
+// ===== 찾기 =====
+
+std::string ccfn locate(Name module, const std::string& directory) const {
+    std::string relative(module.str());
+    for (char& c : relative) {
+        if (c == '.') c = '/';
+    }
+    relative += ".zs";
+
+    std::error_code ec;
+    fs::path candidate = fs::path(directory) / relative;
+    if (fs::is_regular_file(candidate, ec)) return candidate.string();
+    candidate = fs::path(rootDirectory) / relative;
+    if (fs::is_regular_file(candidate, ec)) return candidate.string();
+    for (const std::string& root : searchPaths) {
+        candidate = fs::path(root) / relative;
+        if (fs::is_regular_file(candidate, ec)) return candidate.string();
+    }
+    throw std::runtime_error("Cannot find module '" + std::string(module.str()) + "' (looked for " + relative + ")");
+}
+
+void ccfn discover(Unit& unit) {
+    unit.stamp = stampOf(unit.path);
+
+    // 소스가 기록과 같으면 인터페이스만 읽는다. 가져온 모듈이 바뀌었는지는 build 에서 본다.
+    std::string zsi = interfacePath(unit.path);
+    std::error_code ec;
+    if (fs::is_regular_file(zsi, ec)) {
+        SourceBuffer mapped = SourceBuffer::map(zsi);
+        SourceStamp recorded;
+        if (ModuleInterface::readStamp(mapped.view(), recorded) && recorded == unit.stamp) {
+            try {
+                auto interface = std::make_shared<ModuleInterface>(ModuleInterface::deserialize(mapped.view()));
+                for (const ImportedModule& imported : interface->imports) {
+                    unit.imports.push_back(imported.name);
+                }
+                unit.interface = std::move(interface);
+                return;
+            } catch (const std::runtime_error&) {
+                // 손상된 인터페이스는 소스에서 다시 만든다
+                unit.imports.clear();
+            }
+        }
+    }
+
+    unit.program = Compiler::parse(SourceBuffer::map(unit.path));
+    forEachImport(unit.program.get(), [&](ImportStatement* import) {
+        unit.imports.push_back(import->module);
+    });
+}
+
+// ===== 만들기 =====
+
+void ccfn link(Program* program) const {
+    forEachImport(program, [&](ImportStatement* import) {
+        const Unit& unit = *units.at(import->module);
+        import->interface = unit.interface.get();
+        program->modules.push_back(unit.interface);
+    });
+}
+
+void ccfn build(Unit& unit) {
+    // 읽어 둔 인터페이스는 가져온 모듈들이 그대로일 때만 쓴다
+    if (!unit.program) {
+        bool fresh = unit.interface->imports.size() == unit.imports.size();
+        for (const ImportedModule& imported : unit.interface->imports) {
+            const Unit& dependency = *units.at(imported.name);
+            fresh = fresh && !dependency.rebuilt && dependency.stamp == imported.stamp;
+        }
+        if (fresh) {
+            unit.done = true;
+            loaded++;
+            return;
+        }
+        unit.program = Compiler::parse(SourceBuffer::map(unit.path));
+    }
+
+    link(unit.program.get());
+    SemanticAnalyser analyzer;
+    analyzer.analyze(unit.program.get());
+
+    auto interface = std::make_shared<ModuleInterface>(ModuleInterface::extract(unit.name, unit.program.get()));
+    interface->source = unit.stamp;
+    for (Name name : unit.imports) {
+        interface->imports.push_back(ImportedModule{name, units.at(name)->stamp});
+    }
+    // 쓸 수 없는 디렉터리면 .zsi 없이 넘어간다. 다음 번에 다시 만들 뿐이다.
+    atomic_file::write(interfacePath(unit.path), interface->serialize());
+
+    unit.interface = std::move(interface);
+    unit.program.reset();
+    unit.rebuilt = true;
+    unit.done = true;
+    built++;
+}
+
+std::string ccfn describeCycle() const {
+    // 끝나지 않은 모듈은 모두 끝나지 않은 모듈을 하나 이상 가져오므로 따라가면 반드시 되돌아온다
+    std::vector<const Unit*> path;
+    const Unit* unit = nullptr;
+    for (const auto& entry : units) {
+        if (!entry.second->done) {
+            unit = entry.second.get();
+            break;
+        }
+    }
+    while (std::find(path.begin(), path.end(), unit) == path.end()) {
+        path.push_back(unit);
+        for (Name name : unit->imports) {
+            const Unit* dependency = units.at(name).get();
+            if (!dependency->done) {
+                unit = dependency;
+                break;
+            }
+        }
+    }
+
+    std::string result;
+    for (auto it = std::find(path.begin(), path.end(), unit); it != path.end(); ++it) {
+        result += std::string((*it)->name.str()) + " -> ";
+    }
+    return result + std::string(unit->name.str());
+}
+
+// ===== 그래프 =====
+
+void ccfn resolve(Program* program, const std::string& origin) {
+    std::unique_ptr<ThreadPool> pool;
+    auto guarded = [](auto step) {
+        return [step](Unit& unit) {
+            try {
+                step(unit);
+            } catch (const std::exception& e) {
+                throw std::runtime_error("In module " + std::string(unit.name.str()) + ": " + e.what());
+            }
+        };
+    };
+
+    // 1. import 를 따라가며 모듈을 찾는다. 한 물결의 모듈들은 함께 읽는다.
+    std::vector<Unit*> wave;
+    auto enqueue = [&](Name module, const std::string& directory) {
+        if (units.count(module)) return;
+        auto unit = std::make_unique<Unit>();
+        unit->name = module;
+        unit->path = locate(module, directory);
+        wave.push_back(unit.get());
+        units.emplace(module, std::move(unit));
+    };
+    rootDirectory = directoryOf(origin);
+    forEachImport(program, [&](ImportStatement* import) {
+        enqueue(import->module, rootDirectory);
+    });
+    while (!wave.empty()) {
+        std::vector<Unit*> current;
+        current.swap(wave);
+        runWave(pool, threads, current, guarded([this](Unit& unit) { discover(unit); }));
+        for (Unit* unit : current) {
+            for (Name module : unit->imports) {
+                enqueue(module, directoryOf(unit->path));
+            }
+        }
+    }
+
+    // 2. 가져오는 모듈이 모두 끝난 모듈들을 한 물결로 만든다
+    for (;;) {
+        std::vector<Unit*> ready;
+        bool remaining = false;
+        for (const auto& entry : units) {
+            Unit& unit = *entry.second;
+            if (unit.done) continue;
+            remaining = true;
+            bool satisfied = true;
+            for (Name module : unit.imports) {
+                satisfied = satisfied && units.at(module)->done;
+            }
+            if (satisfied) ready.push_back(&unit);
+        }
+        if (!remaining) break;
+        if (ready.empty()) {
+            throw std::runtime_error("Import cycle: " + describeCycle());
+        }
+        runWave(pool, threads, ready, guarded([this](Unit& unit) { build(unit); }));
+    }
+
+    link(program);
+}
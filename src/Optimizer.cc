@@ -0,0 +1,278 @@
+#include <Optimizer.hh>
+#include <ASTNode.hh>
+#include <Nodes.hh>
+#include <Type.hh>
+
+#include <climits>
+#include <cmath>
+
+#undef ccfn
+#define ccfn Optimizer::
+
+using IntegerLiteral = Node<NodeType::INTEGER_LITERAL>;
+using FloatLiteral = Node<NodeType::FLOAT_LITERAL>;
+using BoolLiteral = Node<NodeType::BOOL_LITERAL>;
+using BinaryExpression = Node<NodeType::BINARY_EXPRESSION>;
+using UnaryExpression = Node<NodeType::UNARY_EXPRESSION>;
+
+// 생성된 C++ 의 int 에 들어가는 값만 접는다 (넘치면 C++ 에서는 정의되지 않은 동작)
+static inline bool fitsInt(int64_t value) {
+    return value >= INT_MIN && value <= INT_MAX;
+}
+
+static inline bool isNumberLiteral(const ASTNode* node) {
+    return node->type == NodeType::INTEGER_LITERAL || node->type == NodeType::FLOAT_LITERAL;
+}
+
+static inline double numberOf(const ASTNode* node) {
+    if (node->type == NodeType::INTEGER_LITERAL) return static_cast<const IntegerLiteral*>(node)->value;
+    return static_cast<const FloatLiteral*>(node)->value;
+}
+
+// 정수 0 이나 +0.0 (−0.0 은 x - 0 에서 x 를 바꾸지 않는 값이 아니다)
+static inline bool isZero(const ASTNode* node) {
+    if (node->type == NodeType::INTEGER_LITERAL) return static_cast<const IntegerLiteral*>(node)->value == 0;
+    if (node->type == NodeType::FLOAT_LITERAL) {
+        double v = static_cast<const FloatLiteral*>(node)->value;
+        return v == 0.0 && !std::signbit(v);
+    }
+    return false;
+}
+
+static inline bool isOne(const ASTNode* node) {
+    return isNumberLiteral(node) && numberOf(node) == 1.0;
+}
+
+static inline bool isBool(const ASTNode* node, bool value) {
+    return node->type == NodeType::BOOL_LITERAL && static_cast<const BoolLiteral*>(node)->value == value;
+}
+
+bool ccfn isPure(const ASTNode* node) {
+    switch (node->type) {
+        case NodeType::INTEGER_LITERAL:
+        case NodeType::FLOAT_LITERAL:
+        case NodeType::STRING_LITERAL:
+        case NodeType::BOOL_LITERAL:
+        case NodeType::IDENTIFIER:
+            return true;
+        case NodeType::UNARY_EXPRESSION:
+            return isPure(static_cast<const UnaryExpression*>(node)->operand);
+        case NodeType::BINARY_EXPRESSION: {
+            auto binary = static_cast<const BinaryExpression*>(node);
+            if ((binary->operator_ == TokenType::DIVIDE || binary->operator_ == TokenType::MODULO) &&
+                binary->valueType && binary->valueType->isIntegral()) {
+                return false;
+            }
+            return isPure(binary->left) && isPure(binary->right);
+        }
+        default:
+            return false;
+    }
+}
+
+ASTNode* ccfn makeInt(int64_t value, const Type* type) {
+    ASTNode* node = arena->make<IntegerLiteral>(static_cast<int>(value));
+    node->valueType = type;
+    return node;
+}
+
+ASTNode* ccfn makeFloat(double value, const Type* type) {
+    ASTNode* node = arena->make<FloatLiteral>(value);
+    node->valueType = type;
+    return node;
+}
+
+ASTNode* ccfn makeBool(bool value) {
+    ASTNode* node = arena->make<BoolLiteral>(value);
+    node->valueType = &types::Bool;
+    return node;
+}
+
+// ===== 노드 하나 접기 =====
+// 자식은 이미 접혀 있다 (분석기가 아래에서부터 부른다)
+
+ASTNode* ccfn visit(BinaryExpression* binary) {
+    ASTNode* left = binary->left;
+    ASTNode* right = binary->right;
+    const Type* type = binary->valueType;
+    if (!type || type->isAuto()) return binary;
+
+    // 같은 타입일 때만 식을 피연산자로 바꿀 수 있다 (x * 1.0 은 x 가 int 면 double 이다)
+    auto keepsType = [type](const ASTNode* node) { return node->valueType == type; };
+
+    // ===== 상수 접기 =====
+    if (left->type == NodeType::INTEGER_LITERAL && right->type == NodeType::INTEGER_LITERAL) {
+        int64_t a = static_cast<IntegerLiteral*>(left)->value;
+        int64_t b = static_cast<IntegerLiteral*>(right)->value;
+        int64_t result;
+        switch (binary->operator_) {
+            case TokenType::PLUS: result = a + b; break;
+            case TokenType::MINUS: result = a - b; break;
+            case TokenType::MULTIPLY: result = a * b; break;
+            case TokenType::DIVIDE:
+                if (b == 0) return binary;
+                result = a / b;
+                break;
+            case TokenType::MODULO:
+                if (b == 0) return binary;
+                result = a % b;
+                break;
+            case TokenType::BIT_AND: result = a & b; break;
+            case TokenType::BIT_OR: result = a | b; break;
+            case TokenType::BIT_XOR: result = a ^ b; break;
+            case TokenType::LEFT_SHIFT:
+                if (a < 0 || b < 0 || b >= 32) return binary;
+                result = a << b;
+                break;
+            case TokenType::RIGHT_SHIFT:
+                if (b < 0 || b >= 32) return binary;
+                result = a >> b;
+                break;
+            case TokenType::EQUAL: return makeBool(a == b);
+            case TokenType::NOT_EQUAL: return makeBool(a != b);
+            case TokenType::LESS: return makeBool(a < b);
+            case TokenType::GREATER: return makeBool(a > b);
+            case TokenType::LESS_EQUAL: return makeBool(a <= b);
+            case TokenType::GREATER_EQUAL: return makeBool(a >= b);
+            default: return binary;
+        }
+        if (!fitsInt(result)) return binary;
+        return makeInt(result, type);
+    }
+
+    if (isNumberLiteral(left) && isNumberLiteral(right)) {
+        double a = numberOf(left), b = numberOf(right);
+        double result;
+        switch (binary->operator_) {
+            case TokenType::PLUS: result = a + b; break;
+            case TokenType::MINUS: result = a - b; break;
+            case TokenType::MULTIPLY: result = a * b; break;
+            case TokenType::DIVIDE: result = a / b; break;
+            case TokenType::EQUAL: return makeBool(a == b);
+            case TokenType::NOT_EQUAL: return makeBool(a != b);
+            case TokenType::LESS: return makeBool(a < b);
+            case TokenType::GREATER: return makeBool(a > b);
+            case TokenType::LESS_EQUAL: return makeBool(a <= b);
+            case TokenType::GREATER_EQUAL: return makeBool(a >= b);
+            default: return binary;
+        }
+        if (!std::isfinite(result)) return binary;
+        return makeFloat(result, type);
+    }
+
+    if (left->type == NodeType::BOOL_LITERAL && right->type == NodeType::BOOL_LITERAL) {
+        bool a = static_cast<BoolLiteral*>(left)->value;
+        bool b = static_cast<BoolLiteral*>(right)->value;
+        switch (binary->operator_) {
+            case TokenType::LOGICAL_AND: return makeBool(a && b);
+            case TokenType::LOGICAL_OR: return makeBool(a || b);
+            case TokenType::EQUAL: return makeBool(a == b);
+            case TokenType::NOT_EQUAL: return makeBool(a != b);
+            default: return binary;
+        }
+    }
+
+    // ===== 항등식 =====
+    ASTNode* replacement = nullptr;
+    switch (binary->operator_) {
+        case TokenType::LOGICAL_AND:
+            // 왼쪽이 false 면 오른쪽은 어차피 평가되지 않는다
+            if (isBool(left, true)) replacement = right;
+            else if (isBool(left, false)) replacement = left;
+            else if (isBool(right, true)) replacement = left;
+            else if (isBool(right, false) && isPure(left)) replacement = right;
+            break;
+        case TokenType::LOGICAL_OR:
+            if (isBool(left, false)) replacement = right;
+            else if (isBool(left, true)) replacement = left;
+            else if (isBool(right, false)) replacement = left;
+            else if (isBool(right, true) && isPure(left)) replacement = right;
+            break;
+        case TokenType::MULTIPLY:
+            if (isOne(right) && keepsType(left)) replacement = left;
+            else if (isOne(left) && keepsType(right)) replacement = right;
+            else if (type->isIntegral() && ((isZero(right) && isPure(left)) || (isZero(left) && isPure(right)))) {
+                replacement = makeInt(0, type);
+            }
+            break;
+        case TokenType::PLUS:
+            // 실수는 -0.0 + 0 이 +0.0 이므로 정수에서만
+            if (!type->isIntegral()) break;
+            if (isZero(right) && keepsType(left)) replacement = left;
+            else if (isZero(left) && keepsType(right)) replacement = right;
+            break;
+        case TokenType::MINUS:
+            if (isZero(right) && keepsType(left)) replacement = left;
+            break;
+        case TokenType::DIVIDE:
+            if (isOne(right) && keepsType(left)) replacement = left;
+            break;
+        case TokenType::MODULO:
+            if (type->isIntegral() && isOne(right) && isPure(left)) replacement = makeInt(0, type);
+            break;
+        case TokenType::BIT_OR:
+        case TokenType::BIT_XOR:
+            if (isZero(right) && keepsType(left)) replacement = left;
+            else if (isZero(left) && keepsType(right)) replacement = right;
+            break;
+        case TokenType::LEFT_SHIFT:
+        case TokenType::RIGHT_SHIFT:
+            if (isZero(right) && keepsType(left)) replacement = left;
+            break;
+        case TokenType::BIT_AND:
+            if ((isZero(right) && isPure(left)) || (isZero(left) && isPure(right))) {
+                replacement = makeInt(0, type);
+            }
+            break;
+        default:
+            break;
+    }
+    if (!replacement) return binary;
+    return replacement;
+}
+
+ASTNode* ccfn visit(UnaryExpression* unary) {
+    ASTNode* operand = unary->operand;
+    const Type* type = unary->valueType;
+    if (!type || type->isAuto()) return unary;
+
+    // 같은 연산자가 두 번 겹쳐 있으면 안쪽 피연산자를 꺼낸다 (타입이 그대로일 때만)
+    if (operand->type == NodeType::UNARY_EXPRESSION) {
+        auto inner = static_cast<UnaryExpression*>(operand);
+        if (inner->operator_ == unary->operator_ && inner->operator_ != TokenType::PLUS &&
+            inner->operand->valueType == type) {
+            return inner->operand;
+        }
+    }
+
+    switch (unary->operator_) {
+        case TokenType::MINUS:
+            if (operand->type == NodeType::INTEGER_LITERAL) {
+                int64_t value = -static_cast<int64_t>(static_cast<IntegerLiteral*>(operand)->value);
+                if (!fitsInt(value)) return unary;
+                return makeInt(value, type);
+            }
+            if (operand->type == NodeType::FLOAT_LITERAL) {
+                return makeFloat(-static_cast<FloatLiteral*>(operand)->value, type);
+            }
+            break;
+        case TokenType::PLUS:
+            if (operand->valueType == type) {
+                return operand;
+            }
+            break;
+        case TokenType::LOGICAL_NOT:
+            if (operand->type == NodeType::BOOL_LITERAL) {
+                return makeBool(!static_cast<BoolLiteral*>(operand)->value);
+            }
+            break;
+        case TokenType::BIT_NOT:
+            if (operand->type == NodeType::INTEGER_LITERAL) {
+                return makeInt(~static_cast<int64_t>(static_cast<IntegerLiteral*>(operand)->value), type);
+            }
+            break;
+        default:
+            break;
+    }
+    return unary;
+}
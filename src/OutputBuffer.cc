@@ -0,0 +1,147 @@
+#include <OutputBuffer.hh>
+
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#define ZUST_WRITE _write
+#define ZUST_CLOSE _close
+#define ZUST_OPEN(path) _open(path, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, 0644)
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#define ZUST_WRITE ::write
+#define ZUST_CLOSE ::close
+#define ZUST_OPEN(path) ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)
+#endif
+
+#undef ccfn
+#define ccfn OutputBuffer::
+
+ccfn OutputBuffer() {
+    grow();
+}
+
+ccfn OutputBuffer(int descriptor) : fd(descriptor) {
+    grow();
+}
+
+ccfn ~OutputBuffer() {
+    if (fd >= 0) {
+        try {
+            flush();
+        } catch (const std::exception&) {
+            // 소멸자에서는 던질 수 없다. 오류를 알고 싶으면 flush() 를 먼저 부른다.
+        }
+    }
+    if (ownsFd) ZUST_CLOSE(fd);
+}
+
+void ccfn openFile(const std::string& path) {
+    flush();
+    int opened = ZUST_OPEN(path.c_str());
+    if (opened < 0) {
+        throw std::runtime_error("Cannot create output file: " + path);
+    }
+    if (ownsFd) ZUST_CLOSE(fd);
+    fd = opened;
+    ownsFd = true;
+}
+
+void ccfn writeAll(const char* data, size_t size) {
+    while (size > 0) {
+        auto written = ZUST_WRITE(fd, data, static_cast<unsigned>(size < (1u << 30) ? size : (1u << 30)));
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Cannot write output file");
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+        flushed += static_cast<size_t>(written);
+    }
+}
+
+void ccfn flush() {
+    if (fd < 0) return;
+    char* begin = chunks.back().get();
+    size_t pending = static_cast<size_t>(cursor - begin);
+    // 실패해도 같은 내용을 두 번 쓰지 않도록 먼저 비운다
+    cursor = begin;
+    writeAll(begin, pending);
+}
+
+void ccfn grow() {
+    if (fd >= 0 && !chunks.empty()) {
+        // 디스크립터 모드: 청크 하나를 계속 다시 쓴다
+        flush();
+        return;
+    }
+    if (!chunks.empty()) {
+        used.push_back(static_cast<size_t>(cursor - chunks.back().get()));
+    }
+    chunks.emplace_back(new char[ChunkSize]);
+    cursor = chunks.back().get();
+    limit = cursor + ChunkSize;
+}
+
+void ccfn appendSlow(const char* data, size_t size) {
+    // 청크보다 큰 조각은 디스크립터로 바로 보낸다
+    if (fd >= 0 && size >= ChunkSize) {
+        flush();
+        writeAll(data, size);
+        return;
+    }
+    while (size > 0) {
+        if (cursor == limit) grow();
+        size_t n = static_cast<size_t>(limit - cursor);
+        if (n > size) n = size;
+        std::memcpy(cursor, data, n);
+        cursor += n;
+        data += n;
+        size -= n;
+    }
+}
+
+void ccfn indent(int level) {
+    static const std::string Spaces(256, ' ');
+    size_t n = static_cast<size_t>(level > 0 ? level : 0) * 4;
+    while (n > 0) {
+        size_t k = n < Spaces.size() ? n : Spaces.size();
+        append(Spaces.data(), k);
+        n -= k;
+    }
+}
+
+size_t ccfn size() const {
+    size_t total = flushed;
+    for (size_t n : used) total += n;
+    return total + static_cast<size_t>(cursor - chunks.back().get());
+}
+
+std::string ccfn str() const {
+    std::string result;
+    result.reserve(size() - flushed);
+    for (size_t i = 0; i < used.size(); ++i) {
+        result.append(chunks[i].get(), used[i]);
+    }
+    result.append(chunks.back().get(), static_cast<size_t>(cursor - chunks.back().get()));
+    return result;
+}
+
+OutputBuffer& ccfn operator<<(int64_t value) {
+    char buf[24];
+    char* end = std::to_chars(buf, buf + sizeof buf, value).ptr;
+    append(buf, static_cast<size_t>(end - buf));
+    return *this;
+}
+
+OutputBuffer& ccfn operator<<(double value) {
+    char buf[32];
+    int n = std::snprintf(buf, sizeof buf, "%g", value);
+    append(buf, static_cast<size_t>(n));
+    return *this;
+}
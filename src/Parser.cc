@@ -1,10 +1,74 @@
 #include <Parser.hh>
+#include <algorithm>
 
+#undef ccfn
 #define ccfn Parser::
 
+// 진단 메시지에 쓰는 토큰 종류의 철자
+static const char* spelling(TokenType type) {
+    switch (type) {
+        case TokenType::EOF_TOKEN: return "end of input";
+        case TokenType::NEWLINE: return "end of line";
+        case TokenType::LET: return "'let'";
+        case TokenType::FN: return "'fn'";
+        case TokenType::IF: return "'if'";
+        case TokenType::ELSE: return "'else'";
+        case TokenType::WHILE: return "'while'";
+        case TokenType::NAMESPACE: return "'namespace'";
+        case TokenType::IMPORT: return "'import'";
+        case TokenType::RETURN: return "'return'";
+        case TokenType::ASSIGN: return "'='";
+        case TokenType::COLUMN: return "':'";
+        case TokenType::SEMICOLON: return "';'";
+        case TokenType::COMMA: return "','";
+        case TokenType::LPAREN: return "'('";
+        case TokenType::RPAREN: return "')'";
+        case TokenType::LBRACE: return "'{'";
+        case TokenType::RBRACE: return "'}'";
+        case TokenType::LBRACKET: return "'['";
+        case TokenType::RBRACKET: return "']'";
+        case TokenType::IDENTIFIER: return "identifier";
+        case TokenType::INTEGER_LITERAL: return "integer literal";
+        case TokenType::FLOAT_LITERAL: return "float literal";
+        case TokenType::STRING_LITERAL: return "string literal";
+        case TokenType::CHAR_LITERAL: return "character literal";
+        default: return "token";
+    }
+}
+
+// 실제로 만난 토큰은 가능하면 원문 그대로 보여 준다
+static std::string describe(TokenRef tok) {
+    switch (tok.type) {
+        case TokenType::EOF_TOKEN:
+        case TokenType::NEWLINE:
+        case TokenType::STRING_LITERAL:
+        case TokenType::CHAR_LITERAL:
+            return spelling(tok.type);
+        default:
+            return "'" + std::string(tok.value()) + "'";
+    }
+}
+
+// at 이 limit 에 닿았을 때. 렉서에서 더 당겨 오거나, 다 읽었으면 EOF 에 멈춘다.
+void ccfn refill() {
+    if (lexer && !stream.finished()) {
+        // 아직 안 본 토큰만 남기고 앞으로 옮긴다
+        stream.refill(*lexer, at);
+        at = 0;
+    }
+    size_t size = tokens->size();
+    if (tokens->finished()) {
+        at = std::min(at, size - 1);
+        limit = size - 1;
+    } else {
+        limit = size - (Lookahead - 1);
+    }
+    types = tokens->typeData();
+}
+
 bool ccfn match(TokenType type, bool skip) {
     if (current().type == type) {
-        pos += skip;
+        if (skip) advance();
         return true;
     }
     return false;
@@ -12,47 +76,143 @@ bool ccfn match(TokenType type, bool skip) {
 
 void ccfn expect(TokenType type) {
     if (!match(type)) {
-        throw std::runtime_error(
-            "Expected token type " 
-            + std::to_string((int)type) +
-            " but " 
-            + std::to_string((int)(current().type)) 
-            + " at line " 
-            + std::to_string(current().line)
-        );
+        error(current(), std::string("expected ") + spelling(type) + " but found " + describe(current()));
     }
 }
 
-void ccfn skipNewlines() {
-    while (match(TokenType::NEWLINE) || match(TokenType::COMMENT)) {}
+// ===== 오류 복구 =====
+
+void ccfn error(TokenRef token, const std::string& message) {
+    if (head != lastErrorAt && errors.size() < MaxDiagnostics) {
+        SourceLocation where = token.buffer->location(token.index);
+        errors.push_back(Diagnostic{where.line, where.column, message});
+    }
+    lastErrorAt = head;
+    throw SyntaxError{};
 }
 
-std::unique_ptr<Program> ccfn parse() {
-    auto program = std::make_unique<Program>();
-    TokenType tktype;
-    skipNewlines();
-    
-    while ((tktype = current().type) != TokenType::EOF_TOKEN) {
-        switch(tktype) {
-            case TokenType::NAMESPACE:
-                program->statements.push_back(parseNamespaceDeclaration());
+void ccfn synchronize() {
+    int depth = 0;
+    while (current().type != TokenType::EOF_TOKEN) {
+        switch (current().type) {
+            case TokenType::SEMICOLON:
+                advance();
+                if (depth == 0) return;
                 break;
-            case TokenType::IMPORT:
-                program->statements.push_back(parseImportStatement());
+            case TokenType::LBRACE:
+                depth++;
+                advance();
                 break;
-            case TokenType::FN:
-                program->statements.push_back(parseFunctionDeclaration());
+            case TokenType::RBRACE:
+                // 바깥 블록의 '}' 는 그 블록이 닫도록 남겨 둔다
+                if (depth == 0) return;
+                advance();
+                if (--depth == 0) return;
                 break;
+            case TokenType::FN:
             case TokenType::LET:
-                program->statements.push_back(parseVariableDeclaration());
+            case TokenType::NAMESPACE:
+            case TokenType::IMPORT:
+            case TokenType::IF:
+            case TokenType::WHILE:
+            case TokenType::RETURN:
+                if (depth == 0) return;
+                advance();
                 break;
             default:
-                program->statements.push_back(parseStatement());
+                advance();
                 break;
         }
+    }
+}
+
+ASTNode* ccfn recover(ASTNode* (Parser::*parseOne)()) {
+    size_t start = head;
+    size_t scratchMark = scratch.size();
+    size_t paramMark = paramScratch.size();
+    size_t prefixMark = prefixScratch.size();
+    try {
+        return (this->*parseOne)();
+    } catch (const SyntaxError&) {
+        // 던진 곳까지 쌓인 자식 목록은 버린다
+        scratch.resize(scratchMark);
+        paramScratch.resize(paramMark);
+        prefixScratch.resize(prefixMark);
+
+        const Diagnostic& last = errors.back();
+        auto node = MkNode(NodeType::ERROR_STATEMENT)(last.line, last.column);
+        if (errors.size() >= MaxDiagnostics) {
+            // 더 남길 수 없으면 나머지는 읽지 않는다
+            while (current().type != TokenType::EOF_TOKEN) advance();
+            return node;
+        }
+        synchronize();
+        // 문장 첫 토큰에서 난 오류라 아무것도 건너뛰지 못했다면 한 토큰은 먹어야 끝난다
+        if (head == start && current().type != TokenType::EOF_TOKEN) advance();
+        return node;
+    }
+}
+
+Name ccfn typeName(TokenRef tok) const {
+    switch (tok.type) {
+        case TokenType::INT: return names::Int;
+        case TokenType::FLOAT: return names::Float;
+        case TokenType::CHAR: return names::Char;
+        case TokenType::BYTE: return names::Byte;
+        case TokenType::LONG: return names::Long;
+        case TokenType::DOUBLE: return names::Double;
+        case TokenType::SHORT: return names::Short;
+        case TokenType::BOOL: return names::Bool;
+        case TokenType::STRING: return names::String;
+        case TokenType::VOID: return names::Void;
+        case TokenType::IDENTIFIER: return tok.name();
+        default: return intern(tok.value());
+    }
+}
+
+Name ccfn parseTypeName() {
+    Name type = typeName(current());
+    advance();
+    
+    // 배열 타입: int[]
+    while (current().type == TokenType::LBRACKET && peek().type == TokenType::RBRACKET) {
+        advance();
+        advance();
+        type = intern(std::string(type.str()) + "[]");
+    }
+    return type;
+}
+
+void ccfn skipNewlines() {
+    while (match(TokenType::NEWLINE) || match(TokenType::COMMENT)) {}
+}
+
+ASTNode* ccfn parseTopLevelStatement() {
+    switch (current().type) {
+        case TokenType::NAMESPACE:
+            return parseNamespaceDeclaration();
+        case TokenType::IMPORT:
+            return parseImportStatement();
+        case TokenType::FN:
+            return parseFunctionDeclaration();
+        case TokenType::LET:
+            return parseVariableDeclaration();
+        default:
+            return parseStatement();
+    }
+}
+
+std::unique_ptr<Program> ccfn parse() {
+    auto program = std::make_unique<Program>();
+    arena = &program->arena;
+    size_t mark = scratch.size();
+    skipNewlines();
+    
+    while (current().type != TokenType::EOF_TOKEN) {
+        scratch.push_back(recover(&Parser::parseTopLevelStatement));
         skipNewlines();
     }
     
+    program->statements = arena->list(scratch, mark);
     return program;
 }
-
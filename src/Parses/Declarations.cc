@@ -6,56 +6,59 @@
 #undef ccfn
 #define ccfn Parser::
 
-std::unique_ptr<ASTNode> ccfn parseNamespaceDeclaration() {
+ASTNode* ccfn parseNamespaceDeclaration() {
     
-    auto ns = MkUniqueNode(NodeType::NAMESPACE_DECLARATION)();
+    auto ns = MkNode(NodeType::NAMESPACE_DECLARATION)();
     
     expect(TokenType::NAMESPACE);
     if (current().type == TokenType::IDENTIFIER) {
-        ns->name = current().value;
-        pos++;
+        ns->name = current().name();
+        advance();
     }
     
     skipNewlines();
     expect(TokenType::LBRACE);
     skipNewlines();
 
-    auto block = MkUniqueNode(NodeType::BLOCK_STATEMENT)();
+    auto block = MkNode(NodeType::BLOCK_STATEMENT)();
+    size_t mark = scratch.size();
     while (current().type != TokenType::RBRACE && current().type != TokenType::EOF_TOKEN) {
-        block->statements.push_back(parseStatement());
+        scratch.push_back(recover(&Parser::parseStatement));
         skipNewlines();
     }
+    block->statements = arena->list(scratch, mark);
 
     // deadline
     
     expect(TokenType::RBRACE);
-    ns->body = std::move(block);
+    ns->body = block;
     
-    return std::move(ns);
+    return ns;
 }
 
-std::unique_ptr<ASTNode> ccfn parseFunctionDeclaration() {
-    auto func = MkUniqueNode(NodeType::FUNCTION_DECLARATION)();
+ASTNode* ccfn parseFunctionDeclaration() {
+    auto func = MkNode(NodeType::FUNCTION_DECLARATION)();
     
     expect(TokenType::FN);
     
     if (current().type == TokenType::IDENTIFIER) {
-        func->name = current().value;
-        pos++;
+        func->name = current().name();
+        advance();
     }
     
     expect(TokenType::LPAREN);
     
     // 매개변수 파싱
+    size_t mark = paramScratch.size();
     while (current().type != TokenType::RPAREN && current().type != TokenType::EOF_TOKEN) {
-        if (isDataType(current().type)) {
-            std::string paramType = current().value;
-            pos++;
+        if (isDataType(current().type) ||
+            (current().type == TokenType::IDENTIFIER && peek().type == TokenType::IDENTIFIER)) {
+            Name paramType = parseTypeName();
             
             if (current().type == TokenType::IDENTIFIER) {
-                std::string paramName = current().value;
-                pos++;
-                func->parameters.emplace_back(paramType, paramName);
+                Name paramName = current().name();
+                advance();
+                paramScratch.push_back(Parameter{paramType, paramName});
             }
             
             if (!match(TokenType::COMMA)) break;
@@ -63,28 +66,28 @@ std::unique_ptr<ASTNode> ccfn parseFunctionDeclaration() {
             break;
         }
     }
+    func->parameters = arena->list(paramScratch, mark);
     
     expect(TokenType::RPAREN);
     
     // 반환 타입 (선택적)
     if (current().type == TokenType::SEMICOLON) {
-        pos++;
-        func->returnType = "auto";
-        return std::move(func);
+        advance();
+        func->returnType = names::Auto;
+        return func;
     } 
     
     if(current().type == TokenType::COLUMN)
     {
-        pos++;
-        if(!isDataType(current().type)) {
-            throw std::runtime_error("[parseFunctionNode] expected dattype");
+        advance();
+        if(!isDataType(current().type) && current().type != TokenType::IDENTIFIER) {
+            error(current(), "expected return type after ':'");
         }
 
-        func->returnType = (current().value);
-        pos++;
+        func->returnType = parseTypeName();
     } else {
         /**  Here type is not specified */
-        func->returnType = "auto";
+        func->returnType = names::Auto;
     }
     
     skipNewlines();
@@ -93,24 +96,23 @@ std::unique_ptr<ASTNode> ccfn parseFunctionDeclaration() {
         func->body = parseBlockStatement();
     }
     
-    return std::move(func);
+    return func;
 }
 
-std::unique_ptr<ASTNode> ccfn parseVariableDeclaration() {
-    auto var = MkUniqueNode(NodeType::VARIABLE_DECLARATION)();
+ASTNode* ccfn parseVariableDeclaration() {
+    auto var = MkNode(NodeType::VARIABLE_DECLARATION)();
     
     expect(TokenType::LET);
     
     if (current().type == TokenType::IDENTIFIER) {
-        var->name = current().value;
-        pos++;
+        var->name = current().name();
+        advance();
     }
 
     if (match(TokenType::COLUMN)) {
         // 타입 지정
-        if (isDataType(current().type)) {
-            var->dataType = current().value;
-            pos++;
+        if (isDataType(current().type) || current().type == TokenType::IDENTIFIER) {
+            var->dataType = parseTypeName();
         }
     }
     
@@ -120,6 +122,6 @@ std::unique_ptr<ASTNode> ccfn parseVariableDeclaration() {
     
     expect(TokenType::SEMICOLON);
     
-    return std::move(var);
+    return var;
 }
 
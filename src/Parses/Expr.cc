@@ -2,240 +2,166 @@
 #include <new>
 #include <cstdlib>
 #include <memory>
-
-// 표현식 파싱 메서드들
-std::unique_ptr<ASTNode> Parser::parseExpression() {
-    return parseAssignmentExpression();
+#include <array>
+#include <charconv>
+#include <cstdint>
+
+// 토큰 텍스트를 문자열로 복사하지 않고 바로 숫자로 변환한다
+template<typename T>
+static bool parseNumber(std::string_view text, T& value) {
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc();
 }
 
-std::unique_ptr<ASTNode> Parser::parseAssignmentExpression() {
-    auto expr = parseLogicalOrExpression();
-    
-    if (match(TokenType::ASSIGN)) {
-        auto assignment = MkUniqueNode(NodeType::ASSIGNMENT_EXPRESSION)();
-        assignment->left = std::move(expr);
-        assignment->right = parseAssignmentExpression();
-        return std::move(assignment);
-    }
-    
-    return expr;
+// ===== 이항 연산자 표 =====
+// 토큰 종류로 바로 찾는다. 우선순위 0 은 이항 연산자가 아니라는 뜻이다.
+// 대입 계열은 오른쪽 결합이고, binary 는 복합 대입이 풀려서 될 연산자다.
+namespace {
+struct OperatorInfo {
+    uint8_t precedence = 0;
+    bool rightAssociative = false;
+    TokenType binary = TokenType::NIL;
+};
+
+constexpr int AssignPrecedence = 1;
+
+constexpr std::array<OperatorInfo, static_cast<size_t>(TokenType::IDENTIFIER) + 1> makeOperatorTable() {
+    std::array<OperatorInfo, static_cast<size_t>(TokenType::IDENTIFIER) + 1> table{};
+    auto set = [&table](TokenType type, uint8_t precedence, bool right = false, TokenType binary = TokenType::NIL) {
+        table[static_cast<size_t>(type)] = OperatorInfo{precedence, right, binary};
+    };
+
+    set(TokenType::ASSIGN, AssignPrecedence, true);
+    set(TokenType::PLUS_ASSIGN, AssignPrecedence, true, TokenType::PLUS);
+    set(TokenType::MINUS_ASSIGN, AssignPrecedence, true, TokenType::MINUS);
+    set(TokenType::MULTIPLY_ASSIGN, AssignPrecedence, true, TokenType::MULTIPLY);
+    set(TokenType::DIVIDE_ASSIGN, AssignPrecedence, true, TokenType::DIVIDE);
+    set(TokenType::MODULO_ASSIGN, AssignPrecedence, true, TokenType::MODULO);
+    set(TokenType::AND_ASSIGN, AssignPrecedence, true, TokenType::BIT_AND);
+    set(TokenType::OR_ASSIGN, AssignPrecedence, true, TokenType::BIT_OR);
+    set(TokenType::XOR_ASSIGN, AssignPrecedence, true, TokenType::BIT_XOR);
+    set(TokenType::LEFT_SHIFT_ASSIGN, AssignPrecedence, true, TokenType::LEFT_SHIFT);
+    set(TokenType::RIGHT_SHIFT_ASSIGN, AssignPrecedence, true, TokenType::RIGHT_SHIFT);
+
+    set(TokenType::LOGICAL_OR, 2);
+    set(TokenType::LOGICAL_AND, 3);
+    set(TokenType::BIT_OR, 4);
+    set(TokenType::BIT_XOR, 5);
+    set(TokenType::BIT_AND, 6);
+    set(TokenType::EQUAL, 7);
+    set(TokenType::NOT_EQUAL, 7);
+    set(TokenType::LESS, 8);
+    set(TokenType::GREATER, 8);
+    set(TokenType::LESS_EQUAL, 8);
+    set(TokenType::GREATER_EQUAL, 8);
+    set(TokenType::LEFT_SHIFT, 9);
+    set(TokenType::RIGHT_SHIFT, 9);
+    set(TokenType::PLUS, 10);
+    set(TokenType::MINUS, 10);
+    set(TokenType::MULTIPLY, 11);
+    set(TokenType::DIVIDE, 11);
+    set(TokenType::MODULO, 11);
+    return table;
 }
 
-std::unique_ptr<ASTNode> Parser::parseLogicalOrExpression() {
-    auto left = parseLogicalAndExpression();
-    
-    while (current().type == TokenType::LOGICAL_OR) {
-        TokenType op = current().type;
-        pos++;
-        auto right = parseLogicalAndExpression();
-        
-        auto binary = MkUniqueNode(NodeType::BINARY_EXPRESSION)();
-        binary->left = std::move(left);
-        binary->operator_ = op;
-        binary->right = std::move(right);
-        left = std::move(binary);
-    }
-    
-    return left;
-}
+constexpr auto OperatorTable = makeOperatorTable();
 
-std::unique_ptr<ASTNode> Parser::parseLogicalAndExpression() {
-    auto left = parseBitwiseOrExpression();
-    
-    while (current().type == TokenType::LOGICAL_AND) {
-        TokenType op = current().type;
-        pos++;
-        auto right = parseBitwiseOrExpression();
-        
-        auto binary = MkUniqueNode(NodeType::BINARY_EXPRESSION)();
-        binary->left = std::move(left);
-        binary->operator_ = op;
-        binary->right = std::move(right);
-        left = std::move(binary);
-    }
-    
-    return left;
+inline const OperatorInfo& operatorInfo(TokenType type) {
+    return OperatorTable[static_cast<size_t>(type)];
 }
 
-std::unique_ptr<ASTNode> Parser::parseBitwiseOrExpression() {
-    auto left = parseBitwiseXorExpression();
-    
-    while (current().type == TokenType::BIT_OR) {
-        TokenType op = current().type;
-        pos++;
-        auto right = parseBitwiseXorExpression();
-        
-        auto binary = MkUniqueNode(NodeType::BINARY_EXPRESSION)();
-        binary->left = std::move(left);
-        binary->operator_ = op;
-        binary->right = std::move(right);
-        left = std::move(binary);
-    }
-    
-    return left;
+inline bool isPrefixOperator(TokenType type) {
+    return type == TokenType::LOGICAL_NOT || type == TokenType::BIT_NOT ||
+           type == TokenType::MINUS || type == TokenType::PLUS;
 }
-
-std::unique_ptr<ASTNode> Parser::parseBitwiseXorExpression() {
-    auto left = parseBitwiseAndExpression();
-    
-    while (current().type == TokenType::BIT_XOR) {
-        TokenType op = current().type;
-        pos++;
-        auto right = parseBitwiseAndExpression();
-        
-        auto binary = MkUniqueNode(NodeType::BINARY_EXPRESSION)();
-        binary->left = std::move(left);
-        binary->operator_ = op;
-        binary->right = std::move(right);
-        left = std::move(binary);
-    }
-    
-    return left;
 }
 
-std::unique_ptr<ASTNode> Parser::parseBitwiseAndExpression() {
-    auto left = parseEqualityExpression();
-    
-    while (current().type == TokenType::BIT_AND) {
-        TokenType op = current().type;
-        pos++;
-        auto right = parseEqualityExpression();
-        
-        auto binary = MkUniqueNode(NodeType::BINARY_EXPRESSION)();
-        binary->left = std::move(left);
-        binary->operator_ = op;
-        binary->right = std::move(right);
-        left = std::move(binary);
-    }
-    
-    return left;
+// 표현식 파싱 메서드들
+ASTNode* Parser::parseExpression() {
+    return parseBinaryExpression(AssignPrecedence);
 }
 
-std::unique_ptr<ASTNode> Parser::parseEqualityExpression() {
-    auto left = parseRelationalExpression();
-    
-    while (current().type == TokenType::EQUAL || current().type == TokenType::NOT_EQUAL) {
-        TokenType op = current().type;
-        pos++;
-        auto right = parseRelationalExpression();
-
-        
-        auto binary = MkUniqueNode(NodeType::BINARY_EXPRESSION)();
-        binary->left = std::move(left);
-        binary->operator_ = op;
-        binary->right = std::move(right);
-        left = std::move(binary);
-    }
-    
-    return left;
-}
+// 우선순위 오르기: 왼쪽 피연산자를 하나 읽고, 우선순위가 충분한 연산자가 나오는 동안
+// 오른쪽을 한 단계 높은 우선순위로 (오른쪽 결합이면 같은 우선순위로) 읽어 붙인다.
+// 재귀 깊이는 우선순위 단계 수가 아니라 식의 실제 중첩만큼만 생긴다.
+ASTNode* Parser::parseBinaryExpression(int minPrecedence) {
+    auto left = parseUnaryExpression();
 
-std::unique_ptr<ASTNode> Parser::parseRelationalExpression() {
-    auto left = parseShiftExpression();
-    
-    while (current().type == TokenType::LESS || current().type == TokenType::GREATER ||
-           current().type == TokenType::LESS_EQUAL || current().type == TokenType::GREATER_EQUAL) {
+    while (true) {
         TokenType op = current().type;
-        pos++;
-        auto right = parseShiftExpression();
-        
-        auto binary = MkUniqueNode(NodeType::BINARY_EXPRESSION)();
-        binary->left = std::move(left);
-        binary->operator_ = op;
-        binary->right = std::move(right);
-        left = std::move(binary);
-    }
-    
-    return left;
-}
+        const OperatorInfo& info = operatorInfo(op);
+        if (info.precedence == 0 || info.precedence < minPrecedence) break;
+        advance();
+        auto right = parseBinaryExpression(info.rightAssociative ? info.precedence : info.precedence + 1);
+
+        if (info.precedence == AssignPrecedence) {
+            auto assignment = MkNode(NodeType::ASSIGNMENT_EXPRESSION)();
+            assignment->left = left;
+            if (op == TokenType::ASSIGN) {
+                assignment->right = right;
+            } else {
+                // x op= e 는 x = x op e 로 푼다. 왼쪽 노드는 두 자리에서 같이 쓴다.
+                auto binary = MkNode(NodeType::BINARY_EXPRESSION)();
+                binary->left = left;
+                binary->operator_ = info.binary;
+                binary->right = right;
+                assignment->right = binary;
+                assignment->operator_ = info.binary;
+            }
+            left = assignment;
+            continue;
+        }
 
-std::unique_ptr<ASTNode> Parser::parseShiftExpression() {
-    auto left = parseAdditiveExpression();
-    
-    while (current().type == TokenType::LEFT_SHIFT || current().type == TokenType::RIGHT_SHIFT) {
-        TokenType op = current().type;
-        pos++;
-        auto right = parseAdditiveExpression();
-        
-        auto binary = MkUniqueNode(NodeType::BINARY_EXPRESSION)();
-        binary->left = std::move(left);
+        auto binary = MkNode(NodeType::BINARY_EXPRESSION)();
+        binary->left = left;
         binary->operator_ = op;
-        binary->right = std::move(right);
-        left = std::move(binary);
+        binary->right = right;
+        left = binary;
     }
-    
-    return left;
-}
 
-std::unique_ptr<ASTNode> Parser::parseAdditiveExpression() {
-    auto left = parseMultiplicativeExpression();
-    
-    while (current().type == TokenType::PLUS || current().type == TokenType::MINUS) {
-        TokenType op = current().type;
-        pos++;
-        auto right = parseMultiplicativeExpression();
-        
-        auto binary = MkUniqueNode(NodeType::BINARY_EXPRESSION)();
-        binary->left = std::move(left);
-        binary->operator_ = op;
-        binary->right = std::move(right);
-        left = std::move(binary);
-    }
-    
     return left;
 }
 
-std::unique_ptr<ASTNode> Parser::parseMultiplicativeExpression() {
-    auto left = parseUnaryExpression();
-    
-    while (current().type == TokenType::MULTIPLY || current().type == TokenType::DIVIDE || 
-           current().type == TokenType::MODULO) {
-        TokenType op = current().type;
-        pos++;
-        auto right = parseUnaryExpression();
-        
-        auto binary = MkUniqueNode(NodeType::BINARY_EXPRESSION)();
-        binary->left = std::move(left);
-        binary->operator_ = op;
-        binary->right = std::move(right);
-        left = std::move(binary);
+// 앞에 붙은 단항 연산자를 모두 모은 뒤 안쪽부터 감싼다
+ASTNode* Parser::parseUnaryExpression() {
+    size_t mark = prefixScratch.size();
+    while (isPrefixOperator(current().type)) {
+        prefixScratch.push_back(current().type);
+        advance();
     }
-    
-    return left;
-}
 
-std::unique_ptr<ASTNode> Parser::parseUnaryExpression() {
-    if (current().type == TokenType::LOGICAL_NOT || current().type == TokenType::BIT_NOT ||
-        current().type == TokenType::MINUS || current().type == TokenType::PLUS) {
-        
-        auto unary = MkUniqueNode(NodeType::UNARY_EXPRESSION)();
-        unary->operator_ = current().type;
-        pos++;
-        unary->operand = parseUnaryExpression();
-        return std::move(unary);
+    auto expr = parsePostfixExpression();
+    while (prefixScratch.size() > mark) {
+        auto unary = MkNode(NodeType::UNARY_EXPRESSION)();
+        unary->operator_ = prefixScratch.back();
+        unary->operand = expr;
+        prefixScratch.pop_back();
+        expr = unary;
     }
-    
-    return parsePostfixExpression();
+
+    return expr;
 }
 
-std::unique_ptr<ASTNode> Parser::parsePostfixExpression() {
+ASTNode* Parser::parsePostfixExpression() {
     auto expr = parsePrimaryExpression();
     
     while (true) {
         if (current().type == TokenType::LPAREN) {
             // 함수 호출
-            auto call = MkUniqueNode(NodeType::CALL_EXPRESSION)();
-            call->callee = std::move(expr);
+            auto call = MkNode(NodeType::CALL_EXPRESSION)();
+            call->callee = expr;
             
-            pos++; // '(' 건너뛰기
+            advance(); // '(' 건너뛰기
             
+            size_t mark = scratch.size();
             while (current().type != TokenType::RPAREN && current().type != TokenType::EOF_TOKEN) {
-                call->arguments.push_back(parseExpression());
+                scratch.push_back(parseExpression());
                 if (!match(TokenType::COMMA)) break;
             }
+            call->arguments = arena->list(scratch, mark);
             
             expect(TokenType::RPAREN);
-            expr = std::move(call);
+            expr = call;
         } else {
             break;
         }
@@ -244,46 +170,51 @@ std::unique_ptr<ASTNode> Parser::parsePostfixExpression() {
     return expr;
 }
 
-std::unique_ptr<ASTNode> Parser::parsePrimaryExpression() {
+ASTNode* Parser::parsePrimaryExpression() {
     switch (current().type) {
         case TokenType::INTEGER_LITERAL: {
-            int value = std::stoi(current().value);
-            pos++;
-            return MkUniqueNode(NodeType::INTEGER_LITERAL)(value);
+            int value = 0;
+            if (!parseNumber(current().value(), value)) {
+                error(current(), "invalid numeric literal '" + std::string(current().value()) + "'");
+            }
+            advance();
+            return MkNode(NodeType::INTEGER_LITERAL)(value);
         }
         case TokenType::FLOAT_LITERAL: {
-            double value = std::stod(current().value);
-            pos++;
-            return MkUniqueNode(NodeType::FLOAT_LITERAL)(value);
-        }
-        case TokenType::STRING_LITERAL: {
-            std::string value = current().value;
-            pos++;
-            return MkUniqueNode(NodeType::STRING_LITERAL)(value);
+            double value = 0;
+            if (!parseNumber(current().value(), value)) {
+                error(current(), "invalid numeric literal '" + std::string(current().value()) + "'");
+            }
+            advance();
+            return MkNode(NodeType::FLOAT_LITERAL)(value);
         }
+        case TokenType::STRING_LITERAL:
         case TokenType::CHAR_LITERAL: {
-            std::string value = current().value;
-            pos++;
-            return MkUniqueNode(NodeType::STRING_LITERAL)(value);
+            auto str = MkNode(NodeType::STRING_LITERAL)(arena->intern(current().value()));
+            advance();
+            return str;
         }
         case TokenType::BOOL_LITERAL: {
-            bool value = (current().value == "true");
-            pos++;
-            return MkUniqueNode(NodeType::BOOL_LITERAL)(value);
+            bool value = (current().value() == "true");
+            advance();
+            return MkNode(NodeType::BOOL_LITERAL)(value);
         }
         case TokenType::IDENTIFIER: {
-            std::string name = current().value;
-            pos++;
-            return MkUniqueNode(NodeType::IDENTIFIER)(name);
+            auto id = MkNode(NodeType::IDENTIFIER)(current().name());
+            advance();
+            return id;
         }
         case TokenType::LPAREN: {
-            pos++; // '(' 건너뛰기
+            advance(); // '(' 건너뛰기
             auto expr = parseExpression();
             expect(TokenType::RPAREN);
             return expr;
         }
+        case TokenType::UNKNOWN:
+            error(current(), "unexpected character '" + std::string(current().value()) + "'");
+        case TokenType::EOF_TOKEN:
+            error(current(), "expected expression but found end of input");
         default:
-            throw std::runtime_error("Unexpected token in primary expression at line " + 
-                std::to_string(current().line));
+            error(current(), "expected expression but found '" + std::string(current().value()) + "'");
     }
 }
\ No newline at end of file
@@ -6,8 +6,8 @@
 #undef ccfn
 #define ccfn Parser::
 
-std::unique_ptr<ASTNode> ccfn parseWhileStatement() {
-    auto whileStmt = MkUniqueNode(NodeType::WHILE_STATEMENT)();
+ASTNode* ccfn parseWhileStatement() {
+    auto whileStmt = MkNode(NodeType::WHILE_STATEMENT)();
     
     expect(TokenType::WHILE);
     expect(TokenType::LPAREN);
@@ -17,11 +17,11 @@ std::unique_ptr<ASTNode> ccfn parseWhileStatement() {
     skipNewlines();
     whileStmt->body = parseStatement();
     
-    return std::move(whileStmt);
+    return whileStmt;
 }
 
-std::unique_ptr<ASTNode> ccfn parseReturnStatement() {
-    auto returnStmt = MkUniqueNode(NodeType::RETURN_STATEMENT)();
+ASTNode* ccfn parseReturnStatement() {
+    auto returnStmt = MkNode(NodeType::RETURN_STATEMENT)();
     
     expect(TokenType::RETURN);
     
@@ -31,17 +31,17 @@ std::unique_ptr<ASTNode> ccfn parseReturnStatement() {
     
     expect(TokenType::SEMICOLON);
     
-    return std::move(returnStmt);
+    return returnStmt;
 }
 
-std::unique_ptr<ASTNode> ccfn parseExpressionStatement() {
-    auto exprStmt = MkUniqueNode(NodeType::EXPRESSION_STATEMENT)();
+ASTNode* ccfn parseExpressionStatement() {
+    auto exprStmt = MkNode(NodeType::EXPRESSION_STATEMENT)();
     exprStmt->expression = parseExpression();
     expect(TokenType::SEMICOLON);
-    return std::move(exprStmt);
+    return exprStmt;
 }
 
-std::unique_ptr<ASTNode> ccfn parseStatement() {
+ASTNode* ccfn parseStatement() {
     skipNewlines();
     
     switch (current().type) {
@@ -62,24 +62,26 @@ std::unique_ptr<ASTNode> ccfn parseStatement() {
     }
 }
 
-std::unique_ptr<ASTNode> ccfn parseBlockStatement() {
-    auto block = MkUniqueNode(NodeType::BLOCK_STATEMENT)();
+ASTNode* ccfn parseBlockStatement() {
+    auto block = MkNode(NodeType::BLOCK_STATEMENT)();
     
     expect(TokenType::LBRACE);
     skipNewlines();
     
+    size_t mark = scratch.size();
     while (current().type != TokenType::RBRACE && current().type != TokenType::EOF_TOKEN) {
-        block->statements.push_back(parseStatement());
+        scratch.push_back(recover(&Parser::parseStatement));
         skipNewlines();
     }
+    block->statements = arena->list(scratch, mark);
     
     expect(TokenType::RBRACE);
     
-    return std::move(block);
+    return block;
 }
 
-std::unique_ptr<ASTNode> ccfn parseIfStatement() {
-    auto ifStmt = MkUniqueNode(NodeType::IF_STATEMENT)();
+ASTNode* ccfn parseIfStatement() {
+    auto ifStmt = MkNode(NodeType::IF_STATEMENT)();
     
     expect(TokenType::IF);
     expect(TokenType::LPAREN);
@@ -89,18 +91,38 @@ std::unique_ptr<ASTNode> ccfn parseIfStatement() {
     skipNewlines();
     ifStmt->thenStatement = parseStatement();
     
-    return std::move(ifStmt);
+    skipNewlines();
+    if (match(TokenType::ELSE)) {
+        skipNewlines();
+        ifStmt->elseStatement = parseStatement();
+    }
+    
+    return ifStmt;
 }
 
-std::unique_ptr<ASTNode> ccfn parseImportStatement() {
+ASTNode* ccfn parseImportStatement() {
+    auto importStmt = MkNode(NodeType::IMPORT_STATEMENT)();
     expect(TokenType::IMPORT);
-    // 간단한 import 구현
+
+    // import std.io;  또는  import "std.io";
     if (current().type == TokenType::STRING_LITERAL) {
-        auto importStmt = MkUniqueNode(NodeType::STRING_LITERAL)(current().value);
-        pos++;
-        return std::move(importStmt);
+        importStmt->module = intern(current().value());
+        advance();
+    } else {
+        if (current().type != TokenType::IDENTIFIER) expect(TokenType::IDENTIFIER);
+        std::string path(current().name().str());
+        advance();
+        while (match(TokenType::DOT)) {
+            if (current().type != TokenType::IDENTIFIER) expect(TokenType::IDENTIFIER);
+            path += '.';
+            path += current().name().str();
+            advance();
+        }
+        importStmt->module = intern(path);
     }
-    return nullptr;
+
+    expect(TokenType::SEMICOLON);
+    return importStmt;
 }
 
 
@@ -0,0 +1,199 @@
+#include <Profiler.hh>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <map>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#define ZUST_HAS_RUSAGE 1
+#endif
+
+#undef ccfn
+#define ccfn Profiler::
+
+namespace {
+std::atomic<Profiler*> installed{nullptr};
+std::atomic<uint32_t> nextThread{0};
+
+void appendJsonString(std::string& out, std::string_view s) {
+    out += '"';
+    for (char c : s) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof buf, "\\u%04x", c);
+                    out += buf;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+const char* const counterNames[] = {"tokens", "nodes", "symbols"};
+}
+
+ccfn Profiler() : origin(nowNs()) {}
+
+Profiler* ccfn active() {
+    return installed.load(std::memory_order_acquire);
+}
+
+void ccfn install(Profiler* profiler) {
+    installed.store(profiler, std::memory_order_release);
+}
+
+uint64_t ccfn nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+uint64_t ccfn threadCpuNs() {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+    }
+#endif
+    return static_cast<uint64_t>(std::clock()) * (1000000000ull / CLOCKS_PER_SEC);
+}
+
+// 프로세스 전체의 최대 RSS. 여러 스레드가 동시에 돌면 증가량은 나눠 가진다.
+int64_t ccfn peakRssKb() {
+#ifdef ZUST_HAS_RUSAGE
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+        return usage.ru_maxrss / 1024;
+#else
+        return usage.ru_maxrss;
+#endif
+    }
+#endif
+    return 0;
+}
+
+uint32_t ccfn threadIndex() {
+    thread_local uint32_t index = nextThread.fetch_add(1);
+    return index;
+}
+
+void ccfn record(Event event) {
+    std::lock_guard<std::mutex> lock(mutex);
+    events.push_back(std::move(event));
+}
+
+std::string ccfn table() const {
+    struct Row {
+        size_t calls = 0;
+        uint64_t wallNs = 0, cpuNs = 0;
+        int64_t rssKb = 0;
+        int64_t counters[COUNTER_COUNT] = {-1, -1, -1};
+        uint64_t firstStart = UINT64_MAX;
+    };
+
+    std::map<std::string, Row> rows;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const Event& e : events) {
+            Row& row = rows[e.name];
+            row.calls++;
+            row.wallNs += e.wallNs;
+            row.cpuNs += e.cpuNs;
+            row.rssKb += e.rssDeltaKb;
+            row.firstStart = std::min(row.firstStart, e.startNs);
+            for (int c = 0; c < COUNTER_COUNT; ++c) {
+                if (e.counters[c] < 0) continue;
+                row.counters[c] = std::max<int64_t>(row.counters[c], 0) + e.counters[c];
+            }
+        }
+    }
+
+    // 처음 시작한 순서대로 보여 준다
+    std::vector<std::pair<std::string, Row>> ordered(rows.begin(), rows.end());
+    std::sort(ordered.begin(), ordered.end(), [](const auto& a, const auto& b) {
+        return a.second.firstStart < b.second.firstStart;
+    });
+
+    std::string out;
+    char line[256];
+    std::snprintf(line, sizeof line, "%-12s %6s %11s %11s %10s %10s %10s %10s\n",
+        "phase", "calls", "wall ms", "cpu ms", "rss +KB", "tokens", "nodes", "symbols");
+    out += line;
+    for (const auto& [name, row] : ordered) {
+        std::snprintf(line, sizeof line, "%-12s %6zu %11.3f %11.3f %10lld",
+            name.c_str(), row.calls, row.wallNs / 1e6, row.cpuNs / 1e6, static_cast<long long>(row.rssKb));
+        out += line;
+        for (int c = 0; c < COUNTER_COUNT; ++c) {
+            if (row.counters[c] < 0) {
+                std::snprintf(line, sizeof line, " %10s", "-");
+            } else {
+                std::snprintf(line, sizeof line, " %10lld", static_cast<long long>(row.counters[c]));
+            }
+            out += line;
+        }
+        out += "\n";
+    }
+    return out;
+}
+
+std::string ccfn chromeTrace() const {
+    std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    std::lock_guard<std::mutex> lock(mutex);
+    char buf[160];
+    for (size_t i = 0; i < events.size(); ++i) {
+        const Event& e = events[i];
+        if (i) out += ',';
+        out += "\n{\"name\":";
+        appendJsonString(out, e.name);
+        std::snprintf(buf, sizeof buf, ",\"cat\":\"zust\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{",
+            e.thread, e.startNs / 1e3, e.wallNs / 1e3);
+        out += buf;
+        std::snprintf(buf, sizeof buf, "\"cpu_ms\":%.3f,\"rss_kb\":%lld", e.cpuNs / 1e6, static_cast<long long>(e.rssDeltaKb));
+        out += buf;
+        for (int c = 0; c < COUNTER_COUNT; ++c) {
+            if (e.counters[c] < 0) continue;
+            std::snprintf(buf, sizeof buf, ",\"%s\":%lld", counterNames[c], static_cast<long long>(e.counters[c]));
+            out += buf;
+        }
+        if (!e.detail.empty()) {
+            out += ",\"detail\":";
+            appendJsonString(out, e.detail);
+        }
+        out += "}}";
+    }
+    out += "\n]}\n";
+    return out;
+}
+
+// ===== ProfileScope =====
+
+ProfileScope::ProfileScope(const char* name, std::string_view detail) : profiler(Profiler::active()) {
+    if (!profiler) return;
+    event.name = name;
+    event.detail = std::string(detail);
+    event.thread = Profiler::threadIndex();
+    rssStart = Profiler::peakRssKb();
+    cpuStart = Profiler::threadCpuNs();
+    event.startNs = Profiler::nowNs();
+}
+
+ProfileScope::~ProfileScope() {
+    if (!profiler) return;
+    uint64_t end = Profiler::nowNs();
+    event.wallNs = end - event.startNs;
+    event.cpuNs = Profiler::threadCpuNs() - cpuStart;
+    event.rssDeltaKb = Profiler::peakRssKb() - rssStart;
+    event.startNs = profiler->sinceOrigin(event.startNs);
+    profiler->record(std::move(event));
+}
@@ -0,0 +1,201 @@
+#include <Scan.hh>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define ZUST_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+namespace scan {
+namespace {
+
+inline bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// ===== 스칼라 구현 =====
+const char* skipBlanksScalar(const char* p, const char* end) {
+    while (p < end && isBlank(*p)) ++p;
+    return p;
+}
+
+const char* findNewlineScalar(const char* p, const char* end) {
+    while (p < end && *p != '\n') ++p;
+    return p;
+}
+
+const char* findQuoteOrBackslashScalar(const char* p, const char* end) {
+    while (p < end && *p != '"' && *p != '\\') ++p;
+    return p;
+}
+
+size_t countNewlinesScalar(const char* p, const char* end) {
+    size_t n = 0;
+    for (; p < end; ++p) n += (*p == '\n');
+    return n;
+}
+
+#ifdef ZUST_SCAN_X86
+
+// ===== SSE2 구현 (x86-64 기본) =====
+inline unsigned blankMask16(__m128i v) {
+    __m128i m = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+        _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\r')),
+            _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\v')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\f')))));
+    return static_cast<unsigned>(_mm_movemask_epi8(m));
+}
+
+const char* skipBlanksSSE2(const char* p, const char* end) {
+    while (end - p >= 16) {
+        unsigned mask = ~blankMask16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) & 0xffffu;
+        if (mask) return p + __builtin_ctz(mask);
+        p += 16;
+    }
+    return skipBlanksScalar(p, end);
+}
+
+const char* findNewlineSSE2(const char* p, const char* end) {
+    const __m128i nl = _mm_set1_epi8('\n');
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, nl)));
+        if (mask) return p + __builtin_ctz(mask);
+        p += 16;
+    }
+    return findNewlineScalar(p, end);
+}
+
+const char* findQuoteOrBackslashSSE2(const char* p, const char* end) {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i m = _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(m));
+        if (mask) return p + __builtin_ctz(mask);
+        p += 16;
+    }
+    return findQuoteOrBackslashScalar(p, end);
+}
+
+size_t countNewlinesSSE2(const char* p, const char* end) {
+    const __m128i nl = _mm_set1_epi8('\n');
+    size_t n = 0;
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        n += __builtin_popcount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, nl))));
+        p += 16;
+    }
+    return n + countNewlinesScalar(p, end);
+}
+
+// ===== AVX2 구현 (실행 시점 선택) =====
+#define ZUST_AVX2 __attribute__((target("avx2")))
+
+ZUST_AVX2 const char* skipBlanksAVX2(const char* p, const char* end) {
+    const __m256i sp = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i cr = _mm256_set1_epi8('\r');
+    const __m256i vt = _mm256_set1_epi8('\v');
+    const __m256i ff = _mm256_set1_epi8('\f');
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i m = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, sp), _mm256_cmpeq_epi8(v, tab)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, cr),
+                _mm256_or_si256(_mm256_cmpeq_epi8(v, vt), _mm256_cmpeq_epi8(v, ff))));
+        unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(m));
+        if (mask) return p + __builtin_ctz(mask);
+        p += 32;
+    }
+    return skipBlanksSSE2(p, end);
+}
+
+ZUST_AVX2 const char* findNewlineAVX2(const char* p, const char* end) {
+    const __m256i nl = _mm256_set1_epi8('\n');
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, nl)));
+        if (mask) return p + __builtin_ctz(mask);
+        p += 32;
+    }
+    return findNewlineSSE2(p, end);
+}
+
+ZUST_AVX2 const char* findQuoteOrBackslashAVX2(const char* p, const char* end) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i m = _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(m));
+        if (mask) return p + __builtin_ctz(mask);
+        p += 32;
+    }
+    return findQuoteOrBackslashSSE2(p, end);
+}
+
+ZUST_AVX2 size_t countNewlinesAVX2(const char* p, const char* end) {
+    const __m256i nl = _mm256_set1_epi8('\n');
+    size_t n = 0;
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        n += __builtin_popcount(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, nl))));
+        p += 32;
+    }
+    return n + countNewlinesSSE2(p, end);
+}
+
+#undef ZUST_AVX2
+#endif
+
+// ===== 디스패치 =====
+struct Impl {
+    const char* name;
+    const char* (*skipBlanks)(const char*, const char*);
+    const char* (*findNewline)(const char*, const char*);
+    const char* (*findQuoteOrBackslash)(const char*, const char*);
+    size_t (*countNewlines)(const char*, const char*);
+};
+
+Impl select() {
+#ifdef ZUST_SCAN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return {"avx2", skipBlanksAVX2, findNewlineAVX2, findQuoteOrBackslashAVX2, countNewlinesAVX2};
+    }
+    // x86-64 는 SSE2 를 항상 지원한다
+    return {"sse2", skipBlanksSSE2, findNewlineSSE2, findQuoteOrBackslashSSE2, countNewlinesSSE2};
+#else
+    return {"scalar", skipBlanksScalar, findNewlineScalar, findQuoteOrBackslashScalar, countNewlinesScalar};
+#endif
+}
+
+inline const Impl& impl() {
+    static const Impl selected = select();
+    return selected;
+}
+
+} // namespace
+
+const char* skipBlanks(const char* p, const char* end) {
+    return impl().skipBlanks(p, end);
+}
+
+const char* findNewline(const char* p, const char* end) {
+    return impl().findNewline(p, end);
+}
+
+const char* findQuoteOrBackslash(const char* p, const char* end) {
+    return impl().findQuoteOrBackslash(p, end);
+}
+
+size_t countNewlines(const char* p, const char* end) {
+    return impl().countNewlines(p, end);
+}
+
+const char* implementation() {
+    return impl().name;
+}
+
+}
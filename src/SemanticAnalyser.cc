@@ -1,188 +1,316 @@
 #include <SemanticAnalyser.hh>
 #include <ASTNode.hh>
+#include <ModuleInterface.hh>
 #include <Nodes.hh>
+#include <Optimizer.hh>
 #include <Program.hh>
 
 #undef ccfn
 #define ccfn SemanticAnalyser::
 
-std::string ccfn analyzeExpression(ASTNode* node) {
-    if (!node) return "void";
-    
-    switch (node->type) {
-        case NodeType::INTEGER_LITERAL:
-            return "int";
-        case NodeType::FLOAT_LITERAL:
-            return "float";
-        case NodeType::STRING_LITERAL:
-            return "string";
-        case NodeType::BOOL_LITERAL:
-            return "bool";
-        case NodeType::IDENTIFIER: {
-            auto id = static_cast<Node<NodeType::IDENTIFIER>*>(node);
-            Symbol* symbol = symbolTable.lookup(id->name);
-            if (!symbol) {
-                throw std::runtime_error("Undefined variable: " + id->name);
-            }
-            return symbol->type;
-        }
-        case NodeType::BINARY_EXPRESSION: {
-            auto binary = static_cast<Node<NodeType::BINARY_EXPRESSION>*>(node);
-            std::string leftType = analyzeExpression(binary->left.get());
-            std::string rightType = analyzeExpression(binary->right.get());
-            
-            // 타입 호환성 검사
-            if (leftType != rightType) {
-                throw std::runtime_error("Type mismatch in binary expression");
-            }
-            
-            return leftType;
-        }
-        case NodeType::ASSIGNMENT_EXPRESSION: {
-            auto assignment = static_cast<Node<NodeType::ASSIGNMENT_EXPRESSION>*>(node);
-            std::string leftType = analyzeExpression(assignment->left.get());
-            std::string rightType = analyzeExpression(assignment->right.get());
-            
-            if (leftType != rightType) {
-                throw std::runtime_error("Type mismatch in assignment");
-            }
-            
-            return leftType;
-        }
-        case NodeType::CALL_EXPRESSION: {
-            auto call = static_cast<Node<NodeType::CALL_EXPRESSION>*>(node);
-            if (call->callee->type == NodeType::IDENTIFIER) {
-                auto id = static_cast<Node<NodeType::IDENTIFIER>*>(call->callee.get());
-                Symbol* symbol = symbolTable.lookup(id->name);
-                if (!symbol || !symbol->isFunction) {
-                    throw std::runtime_error("Undefined function: " + id->name);
-                }
-                
-                // 매개변수 타입 검사
-                if (call->arguments.size() != symbol->paramTypes.size()) {
-                    throw std::runtime_error("Argument count mismatch for function: " + id->name);
-                }
-                
-                for (size_t i = 0; i < call->arguments.size(); ++i) {
-                    std::string argType = analyzeExpression(call->arguments[i].get());
-                    if (argType != symbol->paramTypes[i]) {
-                        throw std::runtime_error("Argument type mismatch for function: " + id->name);
-                    }
-                }
-                
-                return symbol->type;
-            }
+// 이항 연산자의 결과 타입. 허용되지 않는 조합이면 nullptr.
+static const Type* binaryResultType(TokenType op, const Type* left, const Type* right) {
+    if (left->isAuto() || right->isAuto()) {
+        return &types::Auto;
+    }
+    
+    switch (op) {
+        case TokenType::PLUS:
+            if (left == &types::String && right == &types::String) return &types::String;
+            [[fallthrough]];
+        case TokenType::MINUS:
+        case TokenType::MULTIPLY:
+        case TokenType::DIVIDE:
+        case TokenType::MODULO:
+            if (left->isNumeric() && right->isNumeric()) return types::promote(left, right);
+            return nullptr;
+        case TokenType::BIT_AND:
+        case TokenType::BIT_OR:
+        case TokenType::BIT_XOR:
+        case TokenType::LEFT_SHIFT:
+        case TokenType::RIGHT_SHIFT:
+            if (left->isIntegral() && right->isIntegral()) return types::promote(left, right);
+            return nullptr;
+        case TokenType::LESS:
+        case TokenType::GREATER:
+        case TokenType::LESS_EQUAL:
+        case TokenType::GREATER_EQUAL:
+            if (left->isNumeric() && right->isNumeric()) return &types::Bool;
+            return nullptr;
+        case TokenType::EQUAL:
+        case TokenType::NOT_EQUAL:
+            if (left == right || (left->isNumeric() && right->isNumeric())) return &types::Bool;
+            return nullptr;
+        case TokenType::LOGICAL_AND:
+        case TokenType::LOGICAL_OR:
+            if (left == &types::Bool && right == &types::Bool) return &types::Bool;
+            return nullptr;
+        default:
+            return left == right ? left : nullptr;
+    }
+}
+
+static inline bool isCondition(const Type* type) {
+    return type == &types::Bool || type->isAuto();
+}
+
+const Type* ccfn resolveType(Name spelling) {
+    const Type* type = TypeTable::global().fromName(spelling);
+    return type ? type : &types::Auto;
+}
+
+const Type* ccfn typeOf(ASTNode* node) {
+    if (!node) return &types::Void;
+    const Type* type = dispatch(node);
+    node->valueType = type;
+    return type;
+}
+
+const Type* ccfn analyzeExpression(ASTNode*& node) {
+    const Type* type = typeOf(node);
+    // 자식은 이미 접혔으므로 이 노드만 접으면 된다
+    if (folder && node) node = folder->fold(node);
+    return type;
+}
+
+// ===== 식 =====
+
+const Type* ccfn visit(Node<NodeType::INTEGER_LITERAL>*) {
+    return &types::Int;
+}
+
+const Type* ccfn visit(Node<NodeType::FLOAT_LITERAL>*) {
+    return &types::Float;
+}
+
+const Type* ccfn visit(Node<NodeType::STRING_LITERAL>*) {
+    return &types::String;
+}
+
+const Type* ccfn visit(Node<NodeType::BOOL_LITERAL>*) {
+    return &types::Bool;
+}
+
+const Type* ccfn visit(Node<NodeType::IDENTIFIER>* id) {
+    Symbol* symbol = symbolTable.lookup(id->name);
+    if (!symbol) {
+        throw std::runtime_error("Undefined variable: " + std::string(id->name.str()));
+    }
+    return symbol->type;
+}
+
+const Type* ccfn visit(Node<NodeType::BINARY_EXPRESSION>* binary) {
+    const Type* leftType = analyzeExpression(binary->left);
+    const Type* rightType = analyzeExpression(binary->right);
+    
+    // 타입 호환성 검사 (숫자 타입은 넓은 쪽으로 승격)
+    const Type* result = binaryResultType(binary->operator_, leftType, rightType);
+    if (!result) {
+        throw std::runtime_error("Type mismatch in binary expression: " +
+            std::string(leftType->name.str()) + " and " + std::string(rightType->name.str()));
+    }
+    
+    return result;
+}
+
+const Type* ccfn visit(Node<NodeType::UNARY_EXPRESSION>* unary) {
+    const Type* operandType = analyzeExpression(unary->operand);
+    if (operandType->isAuto()) {
+        return operandType;
+    }
+
+    switch (unary->operator_) {
+        case TokenType::LOGICAL_NOT:
+            if (operandType == &types::Bool) return &types::Bool;
+            break;
+        case TokenType::BIT_NOT:
+            if (operandType->isIntegral()) return types::promote(operandType, operandType);
             break;
-        }
         default:
+            if (operandType->isNumeric()) return types::promote(operandType, operandType);
             break;
     }
+    throw std::runtime_error("Type mismatch in unary expression: " + std::string(operandType->name.str()));
+}
+
+const Type* ccfn visit(Node<NodeType::ASSIGNMENT_EXPRESSION>* assignment) {
+    // 대입 대상은 접지 않는다
+    const Type* leftType = typeOf(assignment->left);
+    const Type* rightType = analyzeExpression(assignment->right);
+    
+    if (!types::isAssignable(leftType, rightType)) {
+        throw std::runtime_error("Type mismatch in assignment");
+    }
     
-    return "void";
+    return leftType;
 }
 
-void ccfn analyzeStatement(ASTNode* node) {
-    if (!node) return;
+const Type* ccfn visit(Node<NodeType::CALL_EXPRESSION>* call) {
+    if (call->callee->type != NodeType::IDENTIFIER) {
+        return &types::Void;
+    }
+    auto id = static_cast<Node<NodeType::IDENTIFIER>*>(call->callee);
+    Symbol* symbol = symbolTable.lookup(id->name);
+    if (!symbol || !symbol->isFunction) {
+        throw std::runtime_error("Undefined function: " + std::string(id->name.str()));
+    }
     
-    switch (node->type) {
-        case NodeType::VARIABLE_DECLARATION: {
-            auto var = static_cast<Node<NodeType::VARIABLE_DECLARATION>*>(node);
-            
-            if (var->initializer) {
-                std::string initType = analyzeExpression(var->initializer.get());
-                if (!var->dataType.empty() && var->dataType != initType) {
-                    throw std::runtime_error("Type mismatch in variable declaration: " + var->name);
-                }
-                if (var->dataType.empty()) {
-                    var->dataType = initType; // 타입 추론
-                }
-            }
-            
-            symbolTable.declare(Symbol(var->name, var->dataType));
-            break;
-        }
-        case NodeType::FUNCTION_DECLARATION: {
-            auto func = static_cast<Node<NodeType::FUNCTION_DECLARATION>*>(node);
-            
-            Symbol funcSymbol(func->name, func->returnType, true);
-            for (const auto& param : func->parameters) {
-                funcSymbol.paramTypes.push_back(param.first);
-            }
-            
-            symbolTable.declare(funcSymbol);
-            
-            // 함수 본문 분석
-            symbolTable.pushScope();
-            
-            // 매개변수를 스코프에 추가
-            for (const auto& param : func->parameters) {
-                symbolTable.declare(Symbol(param.second, param.first));
-            }
-            
-            if (func->body) {
-                analyzeStatement(func->body.get());
-            }
-            
-            symbolTable.popScope();
-            break;
+    // 매개변수 타입 검사
+    TypeSpan paramTypes = symbolTable.paramTypes(*symbol);
+    const Type* returnType = symbol->type;
+    if (call->arguments.size() != paramTypes.size()) {
+        throw std::runtime_error("Argument count mismatch for function: " + std::string(id->name.str()));
+    }
+    
+    for (size_t i = 0; i < call->arguments.size(); ++i) {
+        const Type* argType = analyzeExpression(call->arguments[i]);
+        if (!types::isAssignable(paramTypes[i], argType)) {
+            throw std::runtime_error("Argument type mismatch for function: " + std::string(id->name.str()));
         }
-        case NodeType::BLOCK_STATEMENT: {
-            auto block = static_cast<Node<NodeType::BLOCK_STATEMENT>*>(node);
-            symbolTable.pushScope();
-            
-            for (const auto& stmt : block->statements) {
-                analyzeStatement(stmt.get());
-            }
-            
-            symbolTable.popScope();
-            break;
+    }
+    
+    return returnType;
+}
+
+// ===== 문장 =====
+
+const Type* ccfn visit(Node<NodeType::VARIABLE_DECLARATION>* var) {
+    const Type* declared = resolveType(var->dataType);
+    
+    if (var->initializer) {
+        const Type* initType = analyzeExpression(var->initializer);
+        if (!types::isAssignable(declared, initType)) {
+            throw std::runtime_error("Type mismatch in variable declaration: " + std::string(var->name.str()));
         }
-        case NodeType::IF_STATEMENT: {
-            auto ifStmt = static_cast<Node<NodeType::IF_STATEMENT>*>(node);
-            
-            std::string condType = analyzeExpression(ifStmt->condition.get());
-            if (condType != "bool") {
-                throw std::runtime_error("If condition must be boolean");
-            }
-            
-            analyzeStatement(ifStmt->thenStatement.get());
-            if (ifStmt->elseStatement) {
-                analyzeStatement(ifStmt->elseStatement.get());
-            }
-            break;
+        if (var->dataType.empty()) {
+            declared = initType; // 타입 추론
+            var->dataType = initType->name;
         }
-        case NodeType::WHILE_STATEMENT: {
-            auto whileStmt = static_cast<Node<NodeType::WHILE_STATEMENT>*>(node);
-            
-            std::string condType = analyzeExpression(whileStmt->condition.get());
-            if (condType != "bool") {
-                throw std::runtime_error("While condition must be boolean");
-            }
-            
-            analyzeStatement(whileStmt->body.get());
-            break;
+    }
+    
+    symbolTable.declare(var->name, declared);
+    return &types::Void;
+}
+
+const Type* ccfn visit(Node<NodeType::FUNCTION_DECLARATION>* func) {
+    const Type* returnType = resolveType(func->returnType);
+    paramScratch.clear();
+    for (const auto& param : func->parameters) {
+        paramScratch.push_back(resolveType(param.type));
+    }
+    
+    symbolTable.declareFunction(func->name, returnType,
+        TypeSpan{paramScratch.data(), static_cast<uint32_t>(paramScratch.size())});
+    
+    // 함수 본문 분석
+    auto* enclosing = currentFunction;
+    const Type* enclosingReturn = currentReturnType;
+    currentFunction = func;
+    currentReturnType = returnType;
+    symbolTable.pushScope();
+    
+    // 매개변수를 스코프에 추가
+    for (size_t i = 0; i < func->parameters.size(); ++i) {
+        symbolTable.declare(func->parameters[i].name, paramScratch[i]);
+    }
+    
+    analyzeStatement(func->body);
+    
+    symbolTable.popScope();
+    if (currentReturnType->isAuto() && func->body) {
+        // 본문에 값을 돌려주는 return 이 없었다. auto 로 두면 C++ 에서 선언만 보고
+        // 부를 수 없으므로(모듈 인터페이스의 원형) void 로 정한다.
+        currentReturnType = &types::Void;
+        func->returnType = names::Void;
+    }
+    if (returnType->isAuto() && !currentReturnType->isAuto()) {
+        symbolTable.lookup(func->name)->type = currentReturnType;
+    }
+    currentFunction = enclosing;
+    currentReturnType = enclosingReturn;
+    return &types::Void;
+}
+
+const Type* ccfn visit(Node<NodeType::BLOCK_STATEMENT>* block) {
+    symbolTable.pushScope();
+    
+    for (const auto& stmt : block->statements) {
+        analyzeStatement(stmt);
+    }
+    
+    symbolTable.popScope();
+    return &types::Void;
+}
+
+const Type* ccfn visit(Node<NodeType::IF_STATEMENT>* ifStmt) {
+    if (!isCondition(analyzeExpression(ifStmt->condition))) {
+        throw std::runtime_error("If condition must be boolean");
+    }
+    
+    analyzeStatement(ifStmt->thenStatement);
+    analyzeStatement(ifStmt->elseStatement);
+    return &types::Void;
+}
+
+const Type* ccfn visit(Node<NodeType::WHILE_STATEMENT>* whileStmt) {
+    if (!isCondition(analyzeExpression(whileStmt->condition))) {
+        throw std::runtime_error("While condition must be boolean");
+    }
+    
+    analyzeStatement(whileStmt->body);
+    return &types::Void;
+}
+
+const Type* ccfn visit(Node<NodeType::RETURN_STATEMENT>* returnStmt) {
+    const Type* valueType = returnStmt->expression
+        ? analyzeExpression(returnStmt->expression) : &types::Void;
+    
+    if (currentFunction) {
+        if (currentReturnType->isAuto()) {
+            // 반환 타입이 없으면 첫 return 으로 추론한다
+            currentReturnType = valueType;
+            currentFunction->returnType = valueType->name;
+        } else if (!types::isAssignable(currentReturnType, valueType)) {
+            throw std::runtime_error("Return type mismatch in function: " +
+                std::string(currentFunction->name.str()));
         }
-        case NodeType::RETURN_STATEMENT: {
-            auto returnStmt = static_cast<Node<NodeType::RETURN_STATEMENT>*>(node);
-            if (returnStmt->expression) {
-                analyzeExpression(returnStmt->expression.get());
-            }
-            break;
+    }
+    return &types::Void;
+}
+
+const Type* ccfn visit(Node<NodeType::EXPRESSION_STATEMENT>* exprStmt) {
+    analyzeExpression(exprStmt->expression);
+    return &types::Void;
+}
+
+const Type* ccfn visit(Node<NodeType::NAMESPACE_DECLARATION>* ns) {
+    analyzeStatement(ns->body);
+    return &types::Void;
+}
+
+const Type* ccfn visit(Node<NodeType::IMPORT_STATEMENT>* importStmt) {
+    // 모듈이 내보낸 선언을 현재 스코프에 들인다. 본문은 다시 보지 않는다.
+    const ModuleInterface* module = importStmt->interface;
+    if (!module) {
+        throw std::runtime_error("Unresolved import: " + std::string(importStmt->module.str()));
+    }
+    for (const ExportedSymbol& symbol : module->symbols) {
+        if (!symbol.isFunction) {
+            symbolTable.declare(symbol.name, resolveType(symbol.type));
+            continue;
         }
-        case NodeType::EXPRESSION_STATEMENT: {
-            auto exprStmt = static_cast<Node<NodeType::EXPRESSION_STATEMENT>*>(node);
-            analyzeExpression(exprStmt->expression.get());
-            break;
+        paramScratch.clear();
+        const Parameter* params = module->paramsOf(symbol);
+        for (uint32_t i = 0; i < symbol.paramCount; ++i) {
+            paramScratch.push_back(resolveType(params[i].type));
         }
-        default:
-            break;
+        symbolTable.declareFunction(symbol.name, resolveType(symbol.type),
+            TypeSpan{paramScratch.data(), static_cast<uint32_t>(paramScratch.size())});
     }
+    return &types::Void;
 }
 
 
 void ccfn analyze(Program* program) {
-    for (const auto& stmt : program->statements) {
-        analyzeStatement(stmt.get());
-    }
+    runFused(program->statements, *this);
 }
-
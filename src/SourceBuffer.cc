@@ -0,0 +1,82 @@
+#include <SourceBuffer.hh>
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ZUST_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+SourceBuffer::SourceBuffer(std::string src) : owned(std::move(src)), text(owned) {}
+
+SourceBuffer::~SourceBuffer() {
+    release();
+}
+
+void SourceBuffer::release() {
+#ifdef ZUST_HAS_MMAP
+    if (mapping) munmap(mapping, mappingSize);
+#endif
+    mapping = nullptr;
+    mappingSize = 0;
+}
+
+SourceBuffer::SourceBuffer(SourceBuffer&& other) noexcept {
+    *this = std::move(other);
+}
+
+SourceBuffer& SourceBuffer::operator=(SourceBuffer&& other) noexcept {
+    if (this == &other) return *this;
+    release();
+    bool ownsText = other.mapping == nullptr;
+    owned = std::move(other.owned);
+    mapping = other.mapping;
+    mappingSize = other.mappingSize;
+    // 짧은 문자열(SSO)은 이동하면 주소가 바뀌므로 view 를 다시 잡는다
+    text = ownsText ? std::string_view(owned) : other.text;
+    other.mapping = nullptr;
+    other.mappingSize = 0;
+    other.text = std::string_view();
+    return *this;
+}
+
+SourceBuffer SourceBuffer::map(const std::string& path) {
+#ifdef ZUST_HAS_MMAP
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open input file: " + path);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        throw std::runtime_error("Cannot open input file: " + path);
+    }
+
+    SourceBuffer buffer;
+    if (st.st_size > 0) {
+        void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("Cannot map input file: " + path);
+        }
+        madvise(p, st.st_size, MADV_SEQUENTIAL);
+        buffer.mapping = p;
+        buffer.mappingSize = st.st_size;
+        buffer.text = std::string_view(static_cast<const char*>(p), st.st_size);
+    }
+    close(fd);
+    return buffer;
+#else
+    std::ifstream inFile(path, std::ios::binary);
+    if (!inFile) {
+        throw std::runtime_error("Cannot open input file: " + path);
+    }
+    return SourceBuffer(std::string((std::istreambuf_iterator<char>(inFile)),
+                                    std::istreambuf_iterator<char>()));
+#endif
+}
@@ -0,0 +1,55 @@
+#include <Symbol.hh>
+
+#undef ccfn
+#define ccfn SymbolTable::
+
+void ccfn grow() {
+    std::vector<Slot> old(slots.size() * 2);
+    old.swap(slots);
+    for (const Slot& slot : old) {
+        if (slot.key != 0) {
+            slotFor(Name(slot.key - 1)) = slot;
+        }
+    }
+}
+
+Symbol& ccfn insert(Symbol symbol) {
+    if ((used + 1) * 2 > slots.size()) {
+        grow();
+    }
+    
+    Slot& slot = slotFor(symbol.name);
+    if (slot.key == 0) {
+        slot.key = symbol.name.id + 1;
+        used++;
+    }
+    
+    uint32_t depth = static_cast<uint32_t>(scopes.size());
+    if (slot.head != None && symbols[slot.head].depth == depth) {
+        throw std::runtime_error("Variable '" + std::string(symbol.name.str()) + "' already declared in this scope");
+    }
+    
+    symbol.depth = depth;
+    symbol.shadowed = slot.head;
+    slot.head = static_cast<uint32_t>(symbols.size());
+    symbols.push_back(symbol);
+    declaredTotal++;
+    return symbols.back();
+}
+
+void ccfn popScope() {
+    if (scopes.size() <= 1) {
+        return;
+    }
+    
+    ScopeMark mark = scopes.back();
+    scopes.pop_back();
+    
+    // 이 스코프에서 선언된 심볼을 역순으로 되돌린다
+    while (symbols.size() > mark.symbols) {
+        const Symbol& symbol = symbols.back();
+        slotFor(symbol.name).head = symbol.shadowed;
+        symbols.pop_back();
+    }
+    params.resize(mark.params);
+}
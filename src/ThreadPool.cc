@@ -0,0 +1,118 @@
+#include <ThreadPool.hh>
+
+#include <algorithm>
+
+#undef ccfn
+#define ccfn ThreadPool::
+
+namespace {
+// 지금 스레드가 어느 풀의 몇 번째 작업자인지
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local size_t currentWorker = 0;
+}
+
+ccfn ThreadPool(size_t count) {
+    if (count == 0) {
+        count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    queues.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    threads.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        threads.emplace_back([this, i] { work(i); });
+    }
+}
+
+ccfn ~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void ccfn submit(Task task) {
+    size_t target = currentPool == this
+        ? currentWorker
+        : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+
+    pending.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(queues[target]->mutex);
+        queues[target]->tasks.push_back(std::move(task));
+    }
+    {
+        // sleepMutex 아래에서 세야 잠들려는 작업자가 알림을 놓치지 않는다
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queued.fetch_add(1);
+    }
+    wake.notify_one();
+}
+
+bool ccfn pop(size_t self, Task& task) {
+    Queue& queue = *queues[self];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ccfn steal(size_t self, Task& task) {
+    for (size_t k = 1; k < queues.size(); ++k) {
+        Queue& victim = *queues[(self + k) % queues.size()];
+        std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+        if (!lock.owns_lock() || victim.tasks.empty()) continue;
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void ccfn work(size_t self) {
+    currentPool = this;
+    currentWorker = self;
+
+    Task task;
+    for (;;) {
+        if (pop(self, task) || steal(self, task)) {
+            queued.fetch_sub(1);
+            try {
+                task();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(sleepMutex);
+                if (!failure) failure = std::current_exception();
+            }
+            task = nullptr;
+
+            if (pending.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(sleepMutex);
+                idle.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        if (stopping) return;
+        // 다른 작업자가 try_to_lock 에 실패해서 놓친 작업이 있을 수 있으므로
+        // 큐에 남은 작업이 있으면 자지 않고 다시 돈다
+        wake.wait(lock, [this] { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() <= 0) return;
+    }
+}
+
+void ccfn wait() {
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    idle.wait(lock, [this] { return pending.load() == 0; });
+    if (failure) {
+        std::exception_ptr error = failure;
+        failure = nullptr;
+        std::rethrow_exception(error);
+    }
+}
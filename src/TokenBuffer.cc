@@ -0,0 +1,79 @@
+#include <TokenBuffer.hh>
+#include <Scan.hh>
+
+#include <algorithm>
+
+#undef ccfn
+#define ccfn TokenBuffer::
+
+static_assert(static_cast<size_t>(TokenType::IDENTIFIER) <= UINT8_MAX, "token types must fit in a byte");
+
+ccfn TokenBuffer(Lexer& lexer) {
+    source = lexer.text();
+    lex(lexer, SIZE_MAX);
+}
+
+void ccfn push(const Token& tok, size_t offset) {
+    if (count == types.size()) {
+        size_t grown = std::max<size_t>(64, types.size() * 2);
+        types.resize(grown);
+        offsets.resize(grown);
+        names.resize(grown);
+        values.resize(grown);
+    }
+    types[count] = static_cast<uint8_t>(tok.type);
+    offsets[count] = static_cast<uint32_t>(offset);
+    names[count] = tok.name;
+    values[count] = tok.value;
+    count++;
+}
+
+void ccfn lex(Lexer& lexer, size_t limit) {
+    // 배열은 줄이지 않고 count 뒤를 덮어쓴다 (지난번 패딩 자리도)
+    while (count < limit) {
+        Token tok = lexer.next();
+        push(tok, lexer.tokenStart());
+        if (tok.type == TokenType::EOF_TOKEN) {
+            complete = true;
+            break;
+        }
+    }
+
+    // 패딩은 count 에 넣지 않는다.
+    // 끝까지 읽지 않았을 때의 패딩은 읽는 쪽이 닿기 전에 다시 채우므로 보이지 않는다.
+    Token eof;
+    size_t end = complete ? offsets[count - 1] : source.size();
+    for (size_t i = 0; i < Padding; ++i) push(eof, end);
+    count -= Padding;
+}
+
+void ccfn refill(Lexer& lexer, size_t keep) {
+    source = lexer.text();
+    if (complete) return;
+    keep = std::min(keep, count);
+
+    size_t kept = count - keep;
+    std::move(types.begin() + keep, types.begin() + count, types.begin());
+    std::move(offsets.begin() + keep, offsets.begin() + count, offsets.begin());
+    std::move(names.begin() + keep, names.begin() + count, names.begin());
+    std::move(values.begin() + keep, values.begin() + count, values.begin());
+    first += keep;
+    count = kept;
+    lex(lexer, kept + Chunk);
+}
+
+// ===== 줄/열 =====
+
+SourceLocation ccfn location(size_t i) const {
+    if (lineStarts.empty()) {
+        const char* begin = source.data();
+        const char* end = begin + source.size();
+        lineStarts.push_back(0);
+        for (const char* p = scan::findNewline(begin, end); p < end; p = scan::findNewline(p + 1, end)) {
+            lineStarts.push_back(static_cast<uint32_t>(p + 1 - begin));
+        }
+    }
+    uint32_t offset = offsets[i];
+    auto it = std::upper_bound(lineStarts.begin(), lineStarts.end(), offset) - 1;
+    return SourceLocation{static_cast<int>(it - lineStarts.begin()) + 1, static_cast<int>(offset - *it) + 1};
+}
@@ -0,0 +1,68 @@
+#include <Type.hh>
+
+#include <string>
+
+TypeTable& TypeTable::global() {
+    static TypeTable instance;
+    return instance;
+}
+
+const Type* TypeTable::arrayOfLocked(const Type* element) {
+    auto& slot = arrays[element];
+    if (!slot) {
+        Name spelling = intern(std::string(element->name.str()) + "[]");
+        slot = std::make_unique<Type>(Type::ARRAY, spelling, element);
+        bySpelling.emplace(spelling, slot.get());
+    }
+    return slot.get();
+}
+
+const Type* TypeTable::namedLocked(Name name) {
+    auto& slot = namedTypes[name];
+    if (!slot) {
+        slot = std::make_unique<Type>(Type::NAMED, name);
+        bySpelling.emplace(name, slot.get());
+    }
+    return slot.get();
+}
+
+const Type* TypeTable::arrayOf(const Type* element) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return arrayOfLocked(element);
+}
+
+const Type* TypeTable::named(Name name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return namedLocked(name);
+}
+
+const Type* TypeTable::fromName(Name spelling) {
+    switch (spelling.id) {
+        case names::Empty.id: return nullptr;
+        case names::Auto.id: return &types::Auto;
+        case names::Void.id: return &types::Void;
+        case names::Bool.id: return &types::Bool;
+        case names::Byte.id: return &types::Byte;
+        case names::Char.id: return &types::Char;
+        case names::Short.id: return &types::Short;
+        case names::Int.id: return &types::Int;
+        case names::Long.id: return &types::Long;
+        case names::Float.id: return &types::Float;
+        case names::Double.id: return &types::Double;
+        case names::String.id: return &types::String;
+        default: break;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = bySpelling.find(spelling);
+        if (found != bySpelling.end()) return found->second;
+    }
+
+    std::string_view text = spelling.str();
+    if (text.size() > 2 && text.substr(text.size() - 2) == "[]") {
+        const Type* element = fromName(intern(text.substr(0, text.size() - 2)));
+        return arrayOf(element);
+    }
+    return named(spelling);
+}
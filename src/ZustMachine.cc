@@ -0,0 +1,219 @@
+#include <ZustMachine.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#undef ccfn
+#define ccfn ZustMachine::
+
+// Zust int 는 C++ 백엔드와 상수 접기처럼 32비트다. 레지스터는 64비트지만 정수 산술의 결과는
+// 32비트 2의 보수로 감싸서 컴파일한 C++ 과 같은 값을 낸다.
+static inline int64_t wrap32(uint64_t value) { return static_cast<int32_t>(static_cast<uint32_t>(value)); }
+
+#if defined(__GNUC__)
+#define ZUST_THREADED_DISPATCH 1
+#endif
+
+ccfn ZustMachine(const Module& m) : module(m) {
+    strings.reserve(module.constants.size());
+    constants.resize(module.constants.size());
+    for (size_t i = 0; i < module.constants.size(); ++i) {
+        const Constant& k = module.constants[i];
+        switch (k.kind) {
+            case Constant::INT: constants[i].i = k.i; break;
+            case Constant::FLOAT: constants[i].f = k.f; break;
+            case Constant::STRING:
+                strings.push_back(k.s);
+                constants[i].s = &strings.back();
+                break;
+        }
+    }
+    globals.assign(module.numGlobals, Value{0});
+    stack.resize(1 << 16);
+}
+
+Value ccfn run() {
+    if (module.initFunction != Module::NoFunction) {
+        execute(module.initFunction, nullptr, 0);
+    }
+    if (module.entryFunction == Module::NoFunction) {
+        return Value{0};
+    }
+    return execute(module.entryFunction, nullptr, 0);
+}
+
+Value ccfn call(uint32_t function, const std::vector<Value>& args) {
+    if (function >= module.functions.size()) {
+        throw std::runtime_error("No such function in module");
+    }
+    return execute(function, args.data(), args.size());
+}
+
+const std::string* ccfn concat(const std::string* a, const std::string* b) {
+    heap.emplace_back();
+    std::string& s = heap.back();
+    s.reserve(a->size() + b->size());
+    s.append(*a).append(*b);
+    return &s;
+}
+
+Value ccfn execute(uint32_t function, const Value* args, size_t count) {
+    const Function* fn = &module.functions[function];
+    if (count != fn->numParams) {
+        throw std::runtime_error("Argument count mismatch for function: " + fn->name);
+    }
+    if (stack.size() < fn->numRegisters) {
+        stack.resize(fn->numRegisters);
+    }
+
+    frames.clear();
+    frames.push_back(Frame{fn, fn->code.data(), 0, 0});
+    Value* R = stack.data();
+    for (size_t i = 0; i < count; ++i) {
+        R[i] = args[i];
+    }
+    const Instruction* pc = fn->code.data();
+    const Value* K = constants.data();
+    Value* G = globals.data();
+    Instruction ins;
+
+#define A R[ins.a]
+#define B R[ins.b]
+#define C R[ins.c]
+
+#ifdef ZUST_THREADED_DISPATCH
+    static void* const dispatch[] = {
+#define ZUST_OPCODE_LABEL(name) &&op_##name,
+        ZUST_OPCODES(ZUST_OPCODE_LABEL)
+#undef ZUST_OPCODE_LABEL
+    };
+#define VM_NEXT() do { ins = *pc++; goto *dispatch[static_cast<size_t>(ins.op)]; } while (0)
+#define VM_CASE(name) op_##name:
+    VM_NEXT();
+    {
+#else
+#define VM_NEXT() continue
+#define VM_CASE(name) case Opcode::name:
+    for (;;) {
+        ins = *pc++;
+        switch (ins.op) {
+#endif
+
+    VM_CASE(LOAD_INT) A.i = ins.sbx(); VM_NEXT();
+    VM_CASE(LOAD_CONST) A = K[ins.bx()]; VM_NEXT();
+    VM_CASE(LOAD_GLOBAL) A = G[ins.bx()]; VM_NEXT();
+    VM_CASE(STORE_GLOBAL) G[ins.bx()] = A; VM_NEXT();
+    VM_CASE(MOVE) A = B; VM_NEXT();
+    VM_CASE(I2F) A.f = static_cast<double>(B.i); VM_NEXT();
+
+    VM_CASE(ADD_I) A.i = wrap32(static_cast<uint64_t>(B.i) + static_cast<uint64_t>(C.i)); VM_NEXT();
+    VM_CASE(SUB_I) A.i = wrap32(static_cast<uint64_t>(B.i) - static_cast<uint64_t>(C.i)); VM_NEXT();
+    VM_CASE(MUL_I) A.i = wrap32(static_cast<uint64_t>(B.i) * static_cast<uint64_t>(C.i)); VM_NEXT();
+    VM_CASE(DIV_I)
+        if (C.i == 0) throw std::runtime_error("Division by zero");
+        A.i = (C.i == -1) ? wrap32(0 - static_cast<uint64_t>(B.i)) : B.i / C.i;
+        VM_NEXT();
+    VM_CASE(MOD_I)
+        if (C.i == 0) throw std::runtime_error("Division by zero");
+        A.i = (C.i == -1) ? 0 : B.i % C.i;
+        VM_NEXT();
+
+    VM_CASE(ADD_F) A.f = B.f + C.f; VM_NEXT();
+    VM_CASE(SUB_F) A.f = B.f - C.f; VM_NEXT();
+    VM_CASE(MUL_F) A.f = B.f * C.f; VM_NEXT();
+    VM_CASE(DIV_F) A.f = B.f / C.f; VM_NEXT();
+    VM_CASE(MOD_F) A.f = std::fmod(B.f, C.f); VM_NEXT();
+
+    VM_CASE(BAND) A.i = B.i & C.i; VM_NEXT();
+    VM_CASE(BOR) A.i = B.i | C.i; VM_NEXT();
+    VM_CASE(BXOR) A.i = B.i ^ C.i; VM_NEXT();
+    VM_CASE(SHL) A.i = wrap32(static_cast<uint64_t>(B.i) << (C.i & 31)); VM_NEXT();
+    VM_CASE(SHR) A.i = B.i >> (C.i & 31); VM_NEXT();
+
+    VM_CASE(EQ_I) A.i = B.i == C.i; VM_NEXT();
+    VM_CASE(NE_I) A.i = B.i != C.i; VM_NEXT();
+    VM_CASE(LT_I) A.i = B.i < C.i; VM_NEXT();
+    VM_CASE(LE_I) A.i = B.i <= C.i; VM_NEXT();
+    VM_CASE(GT_I) A.i = B.i > C.i; VM_NEXT();
+    VM_CASE(GE_I) A.i = B.i >= C.i; VM_NEXT();
+    VM_CASE(EQ_F) A.i = B.f == C.f; VM_NEXT();
+    VM_CASE(NE_F) A.i = B.f != C.f; VM_NEXT();
+    VM_CASE(LT_F) A.i = B.f < C.f; VM_NEXT();
+    VM_CASE(LE_F) A.i = B.f <= C.f; VM_NEXT();
+    VM_CASE(GT_F) A.i = B.f > C.f; VM_NEXT();
+    VM_CASE(GE_F) A.i = B.f >= C.f; VM_NEXT();
+    VM_CASE(EQ_S) A.i = *B.s == *C.s; VM_NEXT();
+    VM_CASE(NE_S) A.i = *B.s != *C.s; VM_NEXT();
+    VM_CASE(CONCAT) A.s = concat(B.s, C.s); VM_NEXT();
+
+    VM_CASE(NEG_I) A.i = wrap32(0 - static_cast<uint64_t>(B.i)); VM_NEXT();
+    VM_CASE(NEG_F) A.f = -B.f; VM_NEXT();
+    VM_CASE(NOT) A.i = !B.i; VM_NEXT();
+    VM_CASE(BNOT) A.i = ~B.i; VM_NEXT();
+
+    VM_CASE(JMP) pc += ins.sbx(); VM_NEXT();
+    VM_CASE(JMP_FALSE) if (!A.i) pc += ins.sbx(); VM_NEXT();
+    VM_CASE(JMP_TRUE) if (A.i) pc += ins.sbx(); VM_NEXT();
+
+    VM_CASE(CALL) {
+        const Function* callee = &module.functions[ins.b];
+        Frame& caller = frames.back();
+        caller.pc = pc;
+        if (frames.size() >= MaxFrames) {
+            throw std::runtime_error("Stack overflow in function: " + callee->name);
+        }
+
+        // 피호출자의 레지스터는 호출자 레지스터 바로 뒤에 놓인다
+        size_t base = caller.base + caller.function->numRegisters;
+        if (base + callee->numRegisters > stack.size()) {
+            stack.resize(std::max(stack.size() * 2, base + callee->numRegisters));
+            R = stack.data() + caller.base;
+        }
+        Value* callerArgs = R + ins.c;
+        frames.push_back(Frame{callee, callee->code.data(), base, ins.a});
+        R = stack.data() + base;
+        for (uint16_t i = 0; i < callee->numParams; ++i) {
+            R[i] = callerArgs[i];
+        }
+        pc = callee->code.data();
+        VM_NEXT();
+    }
+    VM_CASE(RET) {
+        Value result = A;
+        uint16_t slot = frames.back().result;
+        frames.pop_back();
+        if (frames.empty()) return result;
+        const Frame& caller = frames.back();
+        R = stack.data() + caller.base;
+        pc = caller.pc;
+        R[slot] = result;
+        VM_NEXT();
+    }
+    VM_CASE(RET_VOID) {
+        uint16_t slot = frames.back().result;
+        frames.pop_back();
+        if (frames.empty()) return Value{0};
+        const Frame& caller = frames.back();
+        R = stack.data() + caller.base;
+        pc = caller.pc;
+        R[slot].i = 0;
+        VM_NEXT();
+    }
+
+#ifdef ZUST_THREADED_DISPATCH
+    }
+    __builtin_unreachable();
+#else
+        default:
+            throw std::runtime_error("Bad opcode");
+        }
+    }
+#endif
+
+#undef VM_NEXT
+#undef VM_CASE
+#undef A
+#undef B
+#undef C
+}
@@ -1,16 +1,117 @@
+#include <CompileCache.hh>
 #include <Compiler.hh>
+#include <Driver.hh>
+#include <Evaluator.hh>
+#include <Profiler.hh>
+#include <Program.hh>
+#include <ZustMachine.hh>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <memory>
+#include <string_view>
+#include <vector>
+
+// .zbc 파일은 그대로 읽고, 소스 파일은 바이트코드로 컴파일한다
+static Module loadModule(Compiler& compiler, const std::string& path) {
+    SourceBuffer file = SourceBuffer::map(path);
+    if (file.view().substr(0, 4) == std::string_view("ZBC\0", 4)) {
+        return Module::deserialize(file.view());
+    }
+    return compiler.compileToBytecode(std::move(file), path);
+}
 
 // ===== 메인 함수 및 테스트 =====
 int main(int argc, char* argv[]) {
+    // 어느 모드에서나 쓸 수 있는 옵션(캐시, 계측, 최적화 수준)을 먼저 뽑아낸다
+    CompilerOptions compilerOptions;
+    bool cacheStats = false;
+    bool timeReport = false;
+    const char* traceFile = nullptr;
+    const char* cacheDir = std::getenv("ZUST_CACHE_DIR");
+    std::vector<char*> args;
+    for (int i = 0; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "--cache-dir" && i + 1 < argc) {
+            cacheDir = argv[++i];
+        } else if (arg == "--no-cache") {
+            cacheDir = nullptr;
+        } else if (arg == "--cache-stats") {
+            cacheStats = true;
+        } else if (arg == "--time-report") {
+            timeReport = true;
+        } else if (arg == "--time-trace" && i + 1 < argc) {
+            traceFile = argv[++i];
+        } else if (arg == "-O0" || arg == "-O1" || arg == "-O2") {
+            compilerOptions.optimizationLevel = arg[2] - '0';
+        } else if (arg == "--export" && i + 1 < argc) {
+            compilerOptions.exports.push_back(argv[++i]);
+        } else if (arg == "-I" && i + 1 < argc) {
+            compilerOptions.modulePaths.push_back(argv[++i]);
+        } else if (arg.size() > 2 && arg.substr(0, 2) == "-I") {
+            compilerOptions.modulePaths.emplace_back(arg.substr(2));   // -Ilib
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+    argc = static_cast<int>(args.size());
+    args.push_back(nullptr);
+    argv = args.data();
+    if (cacheDir && *cacheDir) {
+        compilerOptions.cache = std::make_shared<CompileCache>(cacheDir);
+    }
+    
+    // 계측은 켰을 때만 설치한다. 설치하지 않으면 각 단계의 ProfileScope 는 아무것도 하지 않는다.
+    Profiler profiler;
+    if (timeReport || traceFile) {
+#ifndef ZUST_PROFILING
+        std::cerr << "warning: zust was built without ZUST_PROFILING; timing is unavailable" << std::endl;
+#endif
+        Profiler::install(&profiler);
+    }
+    
+    int status = 0;
     try {
-        Compiler compiler;
+        Compiler compiler(compilerOptions);
+        
+        std::string_view mode = argc > 1 ? argv[1] : "";
         
-        if (argc == 3) {
-            // 파일 컴파일 모드
+        if (argc == 4 && mode == "--emit-bytecode") {
+            // 바이트코드 파일 생성
+            compiler.compileFileToBytecode(argv[2], argv[3]);
+            std::cout << "Compilation successful: " << argv[2] << " -> " << argv[3] << std::endl;
+        } else if (argc == 4 && mode == "--emit-ast") {
+            // 파싱한 AST 를 .zast 이미지로 저장
+            compiler.compileFileToAst(argv[2], argv[3]);
+            std::cout << "Compilation successful: " << argv[2] << " -> " << argv[3] << std::endl;
+        } else if (argc == 3 && mode == "--dump-bytecode") {
+            std::cout << loadModule(compiler, argv[2]).disassemble();
+        } else if (argc == 3 && mode == "--dump-ir") {
+            // 함수 본문을 내린 SSA IR (-O0 이면 패스를 돌리기 전)
+            std::cout << compiler.dumpIr(SourceBuffer::map(argv[2]), argv[2]);
+        } else if (argc == 3 && mode == "--vm") {
+            // Zust Machine 에서 실행. main 의 반환값이 종료 코드가 된다
+            Module module = loadModule(compiler, argv[2]);
+            ZustMachine machine(module);
+            status = static_cast<int>(machine.run().i);
+        } else if (argc == 3 && mode == "--run") {
+            // 클로저 평가기로 바로 실행. main 의 반환값이 종료 코드가 된다
+            std::unique_ptr<Program> program = compiler.analyze(SourceBuffer::map(argv[2]), argv[2]);
+            Evaluator evaluator;
+            evaluator.load(program.get());
+            status = static_cast<int>(evaluator.run());
+        } else if (argc == 3 && mode[0] != '-' && !Driver::isBatchInput(argv[1]) && !Driver::isSourceFile(argv[2])) {
+            // 파일 컴파일 모드. zust a.zs b.zs 는 b.zs 를 덮어쓰지 않고 두 파일짜리 배치로 넘긴다.
             compiler.compileFile(argv[1], argv[2]);
             std::cout << "Compilation successful: " << argv[1] << " -> " << argv[2] << std::endl;
+        } else if (argc >= 2) {
+            // 다중 파일 모드: zust [-j N] [-o dir] 파일|디렉터리|@목록 ...
+            DriverOptions options = Driver::parseArguments(argc - 1, argv + 1);
+            std::vector<CompileJob> jobs = Driver::collect(options);
+            Driver driver(compilerOptions);
+            size_t failed = driver.run(jobs, options.threads, std::cerr);
+            std::cout << "Compiled " << jobs.size() - failed << " of " << jobs.size() << " files" << std::endl;
+            status = failed == 0 ? 0 : 1;
         } else {
             // 테스트 모드
             std::string testCode = R"(
@@ -46,8 +147,29 @@ namespace TestNamespace {
         
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
-        return 1;
+        status = 1;
     }
     
-    return 0;
+    Profiler::install(nullptr);
+    if (timeReport) {
+        std::cerr << profiler.table();
+    }
+    if (traceFile) {
+        std::ofstream trace(traceFile);
+        trace << profiler.chromeTrace();
+        if (!trace) {
+            std::cerr << "Error: Cannot write trace file: " << traceFile << std::endl;
+            status = 1;
+        }
+    }
+    if (cacheStats) {
+        if (compilerOptions.cache) {
+            std::cerr << "cache: " << compilerOptions.cache->hits() << " hits, "
+                      << compilerOptions.cache->misses() << " misses ("
+                      << compilerOptions.cache->path() << ")" << std::endl;
+        } else {
+            std::cerr << "cache: disabled (use --cache-dir or ZUST_CACHE_DIR)" << std::endl;
+        }
+    }
+    return status;
 }
@@ -0,0 +1,104 @@
+// AST 이미지 검증 테스트
+// 올바른 이미지를 만든 뒤 한 곳씩 망가뜨려서 AstImage 가 열 때 던지는지 본다.
+// 검증을 통과한 이미지는 걸어도 안전해야 하므로, 통과하면 안 되는 이미지가 하나라도 통과하면 실패다.
+#include <AstImage.hh>
+#include <Compiler.hh>
+#include <Program.hh>
+
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+using NodeRef = AstImage::NodeRef;
+
+static const char* Source = R"(
+fn f(int x) : int {
+    return x;
+}
+
+fn main() : int {
+    let a: int = 1;
+    if (a > 0) {
+        a = 2;
+    }
+    f(a);
+    return a;
+}
+)";
+
+static int failures = 0;
+
+static void putWord(std::string& image, uint32_t offset, uint32_t value) {
+    std::memcpy(&image[offset], &value, sizeof value);
+}
+
+// 올바른 이미지에서 고칠 자리를 찾는다
+struct Offsets {
+    uint32_t function = 0;      // main 의 FUNCTION_DECLARATION
+    uint32_t variable = 0;      // let a
+    uint32_t ifStatement = 0;
+    uint32_t call = 0;          // f(a)
+};
+
+static Offsets locate(const std::string& bytes) {
+    AstImage image{SourceBuffer(bytes)};
+    Offsets at;
+    NodeRef main = image.root().list(0)[1];
+    at.function = main.position();
+    AstImage::ListRef body = main.child(3).list(0);
+    at.variable = body[0].position();
+    at.ifStatement = body[1].position();
+    at.call = body[2].child(0).position();
+    return at;
+}
+
+static void expectRejected(const char* name, const std::string& bytes) {
+    try {
+        AstImage image{SourceBuffer(bytes)};
+        std::printf("FAIL %s: corrupt image was accepted\n", name);
+        failures++;
+    } catch (const std::runtime_error& e) {
+        std::printf("ok   %s (%s)\n", name, e.what());
+    }
+}
+
+static void corrupt(const char* name, const std::string& valid, const std::function<void(std::string&)>& edit) {
+    std::string bytes = valid;
+    edit(bytes);
+    expectRejected(name, bytes);
+}
+
+int main() {
+    std::string valid = AstImage::serialize(Compiler::parse(SourceBuffer(Source)).get());
+
+    // 올바른 이미지는 열리고 되살아나야 한다
+    try {
+        AstImage image{SourceBuffer(valid)};
+        std::unique_ptr<Program> program = image.materialize();
+        std::printf("ok   valid image (%zu nodes)\n", image.nodeCount());
+    } catch (const std::exception& e) {
+        std::printf("FAIL valid image: %s\n", e.what());
+        return 1;
+    }
+    Offsets at = locate(valid);
+
+    corrupt("string table past the end", valid, [](std::string& b) { b[18] = static_cast<char>(b[18] ^ 0xFF); });
+    corrupt("truncated", valid, [](std::string& b) { b.resize(b.size() - 4); });
+    corrupt("null callee", valid, [&](std::string& b) { putWord(b, at.call + 4, 0); });
+    corrupt("null call arguments", valid, [&](std::string& b) { putWord(b, at.call + 8, 0); });
+    corrupt("null if condition", valid, [&](std::string& b) { putWord(b, at.ifStatement + 4, 0); });
+    corrupt("null if body", valid, [&](std::string& b) { putWord(b, at.ifStatement + 8, 0); });
+    corrupt("statement as if condition", valid, [&](std::string& b) { putWord(b, at.ifStatement + 4, at.variable); });
+    corrupt("statement as callee", valid, [&](std::string& b) { putWord(b, at.call + 4, at.variable); });
+    corrupt("if statement as function body", valid, [&](std::string& b) { putWord(b, at.function + 16, at.ifStatement); });
+    corrupt("forward child offset", valid, [&](std::string& b) { putWord(b, at.variable + 12, at.call); });
+    corrupt("bad node type", valid, [&](std::string& b) { b[at.call] = static_cast<char>(NodeType::FOR_STATEMENT); });
+
+    if (failures) {
+        std::printf("%d case(s) failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
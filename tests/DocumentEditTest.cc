@@ -0,0 +1,168 @@
+// 문서 편집 테스트
+// 무작위 편집을 Document 에 하나씩 넣으면서, 매번 같은 텍스트로 새로 연 Document 와
+// 조각 경계, 진단, 조립한 프로그램, 줄/열 위치가 모두 같은지 본다.
+// 닫히지 않은 namespace 처럼 조각 경계에 걸친 오류는 문서 전체를 파싱한 결과와도 비교한다.
+#include "../bench/SourceGenerator.hh"
+
+#include <CodeGenerator.hh>
+#include <Document.hh>
+#include <Lexer.hh>
+#include <Parser.hh>
+#include <Program.hh>
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static constexpr int Trials = 3000;
+
+static std::string generate(Program* program) {
+    CodeGenerator generator;
+    return generator.generate(program);
+}
+
+static bool sameDiagnostics(const std::vector<Diagnostic>& a, const std::vector<Diagnostic>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].line != b[i].line || a[i].column != b[i].column || a[i].message != b[i].message) return false;
+    }
+    return true;
+}
+
+static std::string describe(const std::vector<Diagnostic>& diagnostics) {
+    std::string text;
+    for (const Diagnostic& d : diagnostics) {
+        text += "  " + std::to_string(d.line) + ":" + std::to_string(d.column) + " " + d.message + "\n";
+    }
+    return text;
+}
+
+// 고친 문서와 새로 연 문서가 다르면 무엇이 다른지 돌려준다
+static std::string compare(Document& edited, Document& fresh) {
+    if (edited.segmentCount() != fresh.segmentCount()) {
+        return "segment count " + std::to_string(edited.segmentCount()) + " vs " + std::to_string(fresh.segmentCount());
+    }
+    for (size_t i = 0; i < edited.segmentCount(); ++i) {
+        const auto& a = edited.segment(i);
+        const auto& b = fresh.segment(i);
+        if (a.text() != b.text() || a.kind != b.kind || a.nested != b.nested || a.offset != b.offset ||
+            a.line != b.line || a.column != b.column || a.lead != b.lead) {
+            return "segment " + std::to_string(i);
+        }
+    }
+    if (!sameDiagnostics(edited.diagnostics(), fresh.diagnostics())) {
+        return "diagnostics\n" + describe(edited.diagnostics()) + "vs\n" + describe(fresh.diagnostics());
+    }
+    if (generate(edited.program()) != generate(fresh.program())) return "program";
+    return "";
+}
+
+static void randomEdits() {
+    SourceGenerator::Shape shape;
+    shape.functions = 30;
+    shape.namespaces = 1;
+    shape.globals = 20;
+    shape.commentLines = 1;
+    std::string text = "fn pre() : int { if (1 < 2) { return 1; } else { return 2; } }\n" +
+                       SourceGenerator(shape).generate() + "\nlet z: int = 3;\n";
+    Document document(text);
+
+    // 조각 경계를 만들거나 없애는 조각들
+    static const char* const Snippets[] = {
+        "{", "}", ";", " ", "else", "namespace Q {", "\n", "fn g() : int { return 1; }",
+        "x", "if (1) { ", "#c\n", "\"s\\n\"",
+    };
+    constexpr size_t SnippetCount = sizeof(Snippets) / sizeof(Snippets[0]);
+
+    std::mt19937 rng(1);
+    // 직전 편집을 되돌리는 편집도 섞는다 (편집기의 실행 취소)
+    size_t undoOffset = 0, undoLength = 0;
+    std::string undoText;
+    bool canUndo = false;
+
+    for (int trial = 0; trial < Trials; ++trial) {
+        size_t offset, removed;
+        std::string inserted;
+        if (canUndo && rng() % 2) {
+            offset = undoOffset;
+            removed = undoLength;
+            inserted = undoText;
+            canUndo = false;
+        } else {
+            offset = rng() % (text.size() + 1);
+            removed = std::min<size_t>(rng() % 4 == 0 ? rng() % 40 : rng() % 2, text.size() - offset);
+            inserted = rng() % 3 == 0 ? "" : Snippets[rng() % SnippetCount];
+            undoOffset = offset;
+            undoLength = inserted.size();
+            undoText = text.substr(offset, removed);
+            canUndo = true;
+        }
+        text.replace(offset, removed, inserted);
+        document.edit(offset, removed, inserted);
+
+        std::string problem;
+        if (document.text() != text) {
+            problem = "text";
+        } else {
+            Document fresh(text);
+            problem = compare(document, fresh);
+        }
+        if (problem.empty()) {
+            // 아무 위치나 골라 줄/열로 바꾼 뒤 다시 오프셋으로 돌아오는지
+            size_t probe = rng() % (text.size() + 1);
+            int line = 1, column = 1;
+            for (size_t i = 0; i < probe; ++i) {
+                if (text[i] == '\n') {
+                    line++;
+                    column = 1;
+                } else {
+                    column++;
+                }
+            }
+            if (document.offsetOf(line, column) != probe) problem = "offsetOf " + std::to_string(probe);
+        }
+        if (!problem.empty()) {
+            std::printf("FAIL random edit %d (offset %zu, removed %zu, \"%s\"): %s\n", trial, offset, removed,
+                        inserted.c_str(), problem.c_str());
+            failures++;
+            return;
+        }
+    }
+    std::printf("ok   %d random edits match a fresh document\n", Trials);
+}
+
+// 문서를 조각으로 나눠 파싱해도 한 번에 파싱한 것과 같은 진단이 나오는지
+static void matchesWholeFile(const char* name, const std::string& text) {
+    Document document(text);
+    Lexer lexer(text);
+    Parser parser(lexer);
+    parser.parse();
+    std::vector<Diagnostic> expected = parser.diagnostics();
+    std::vector<Diagnostic> actual = document.diagnostics();
+    if (sameDiagnostics(actual, expected)) {
+        std::printf("ok   %s\n", name);
+    } else {
+        std::printf("FAIL %s: document\n%swhole file\n%s", name, describe(actual).c_str(), describe(expected).c_str());
+        failures++;
+    }
+}
+
+int main() {
+    try {
+        matchesWholeFile("unclosed namespace", "namespace N {\nfn a() : int { return 1; }\n");
+        matchesWholeFile("unclosed function in namespace", "namespace N {\nfn a() : int { return 1; \n");
+        randomEdits();
+    } catch (const std::exception& e) {
+        std::printf("FAIL %s\n", e.what());
+        failures++;
+    }
+    if (failures) {
+        std::printf("%d case(s) failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
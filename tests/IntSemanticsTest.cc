@@ -0,0 +1,131 @@
+// 정수 의미 테스트
+// 같은 프로그램을 컴파일한 C++, Zust Machine(--vm), 클로저 평가기(--run) 로 돌려
+// 결과가 같은지 본다. Zust int 는 32비트이므로 오버플로는 세 백엔드 모두 32비트에서 감싸야 한다.
+#include <Compiler.hh>
+#include <Evaluator.hh>
+#include <Program.hh>
+#include <ZustMachine.hh>
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#if !defined(_WIN32)
+#include <sys/wait.h>
+#endif
+
+namespace fs = std::filesystem;
+
+static int failures = 0;
+
+// id 를 거치면 상수 접기가 끼어들지 못해 실행 중에 계산된다
+static const char* Prelude = "fn id(int x) : int { return x; }\n";
+
+struct Case {
+    const char* name;
+    const char* body; // main 의 본문
+};
+
+static const Case Cases[] = {
+    {"add overflow",
+        "let b: int = id(2147483647) + 1;\n"
+        "if (b < 0) { return 146; }\n"
+        "return 46;\n"},
+    {"sub overflow",
+        "let b: int = id(-2147483647) - 2;\n"
+        "if (b > 0) { return 1; }\n"
+        "return 2;\n"},
+    {"mul overflow",
+        "let b: int = id(65536) * id(65536);\n"
+        "if (b == 0) { return 3; }\n"
+        "return 4;\n"},
+    {"negate min",
+        "let m: int = id(-2147483647) - 1;\n"
+        "if (-m < 0) { return 5; }\n"
+        "return 6;\n"},
+    {"shift into sign bit",
+        "let s: int = id(1) << 31;\n"
+        "if (s < 0 && (s >> 31) == -1) { return 7; }\n"
+        "return 8;\n"},
+    {"rolling hash",
+        "let h: int = id(17);\n"
+        "let i: int = 0;\n"
+        "while (i < 1000) {\n"
+        "    h = h * 31 + i;\n"
+        "    i = i + 1;\n"
+        "}\n"
+        "if (h < 0) { return 128 + (h & 127); }\n"
+        "return h & 127;\n"},
+};
+
+static std::string program(const Case& c) {
+    return std::string(Prelude) + "fn main() : int {\n" + c.body + "}\n";
+}
+
+// 컴파일한 C++ 의 종료 코드. 부호 있는 오버플로를 정의된 동작으로 만들려고 -fwrapv 로 빌드한다.
+static int compiled(const std::string& source, const fs::path& dir, int index) {
+    Compiler compiler;
+    std::string cpp = compiler.compile(source);
+    fs::path file = dir / ("case" + std::to_string(index) + ".cpp");
+    fs::path exe = dir / ("case" + std::to_string(index));
+    std::ofstream(file) << cpp;
+    std::string build = std::string("\"") + ZUST_TEST_CXX + "\" -std=c++17 -fwrapv -o \"" +
+                        exe.string() + "\" \"" + file.string() + "\"";
+    if (std::system(build.c_str()) != 0) {
+        throw std::runtime_error("C++ build failed: " + file.string());
+    }
+    int status = std::system(("\"" + exe.string() + "\"").c_str());
+#if defined(_WIN32)
+    return status;
+#else
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+#endif
+}
+
+static int evaluate(const std::string& source) {
+    Compiler compiler;
+    std::unique_ptr<Program> ast = compiler.analyze(SourceBuffer(source));
+    Evaluator evaluator;
+    evaluator.load(ast.get());
+    return static_cast<int>(evaluator.run() & 255);
+}
+
+static int interpret(const std::string& source) {
+    Compiler compiler;
+    Module module = compiler.compileToBytecode(SourceBuffer(source));
+    ZustMachine machine(module);
+    return static_cast<int>(machine.run().i & 255);
+}
+
+int main() {
+    fs::path dir = fs::temp_directory_path() / ("zust_int_test_" + std::to_string(fs::file_time_type::clock::now().time_since_epoch().count()));
+    fs::create_directories(dir);
+
+    int index = 0;
+    for (const Case& c : Cases) {
+        try {
+            std::string source = program(c);
+            int native = compiled(source, dir, index++);
+            int machine = interpret(source);
+            int closure = evaluate(source);
+            bool ok = native == machine && native == closure;
+            std::printf("%s %s: c++ %d, machine %d, evaluator %d\n", ok ? "ok  " : "FAIL", c.name,
+                        native, machine, closure);
+            if (!ok) failures++;
+        } catch (const std::exception& e) {
+            std::printf("FAIL %s: %s\n", c.name, e.what());
+            failures++;
+        }
+    }
+
+    std::error_code ignored;
+    fs::remove_all(dir, ignored);
+    if (failures) {
+        std::printf("%d case(s) failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
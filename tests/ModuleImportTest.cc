@@ -0,0 +1,87 @@
+// 모듈 간 호출 테스트
+// return 이 없는 함수를 내보내는 모듈과 그 함수를 부르는 파일을 임시 디렉터리에 만들고
+// 양쪽 C++ 출력에 void 원형이 나오는지 본다. auto 원형은 g++ 가 선언만 보고 부를 수 없다.
+#include <Compiler.hh>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace fs = std::filesystem;
+
+static int failures = 0;
+
+static void write(const fs::path& path, const char* text) {
+    std::ofstream(path) << text;
+}
+
+static void expectContains(const char* name, const std::string& output, const std::string& text) {
+    if (output.find(text) == std::string::npos) {
+        std::printf("FAIL %s: missing \"%s\" in\n%s\n", name, text.c_str(), output.c_str());
+        failures++;
+    } else {
+        std::printf("ok   %s\n", name);
+    }
+}
+
+static void expectMissing(const char* name, const std::string& output, const std::string& text) {
+    if (output.find(text) != std::string::npos) {
+        std::printf("FAIL %s: unexpected \"%s\" in\n%s\n", name, text.c_str(), output.c_str());
+        failures++;
+    } else {
+        std::printf("ok   %s\n", name);
+    }
+}
+
+int main() {
+    fs::path dir = fs::temp_directory_path() / ("zust_module_test_" + std::to_string(fs::file_time_type::clock::now().time_since_epoch().count()));
+    fs::create_directories(dir);
+    write(dir / "counter.zs",
+        "let hits: int = 0;\n"
+        "fn touch() {\n"
+        "    hits = hits + 1;\n"
+        "}\n");
+    write(dir / "app.zs",
+        "import counter;\n"
+        "fn main() : int {\n"
+        "    touch();\n"
+        "    return hits;\n"
+        "}\n");
+
+    try {
+        // 두 번 컴파일한다. 두 번째는 처음에 쓴 counter.zsi 만 읽는다.
+        for (const char* pass : {"fresh", "cached interface"}) {
+            Compiler compiler;
+            std::string app = compiler.compile(SourceBuffer::map((dir / "app.zs").string()), (dir / "app.zs").string());
+            std::string prefix = std::string(pass) + ": ";
+            expectContains((prefix + "importer declares void touch").c_str(), app, "void touch();");
+            expectMissing((prefix + "importer has no auto prototype").c_str(), app, "auto touch");
+        }
+
+        Compiler compiler;
+        std::string counter = compiler.compile(SourceBuffer::map((dir / "counter.zs").string()), (dir / "counter.zs").string());
+        expectContains("module defines void touch", counter, "void touch()");
+    } catch (const std::exception& e) {
+        std::printf("FAIL %s\n", e.what());
+        failures++;
+    }
+
+    // 바이트코드 백엔드는 import 를 찾아낸 뒤 --run 처럼 지원하지 않는다고 거절해야 한다
+    try {
+        Compiler compiler;
+        compiler.compileToBytecode(SourceBuffer::map((dir / "app.zs").string()), (dir / "app.zs").string());
+        std::printf("FAIL bytecode backend accepted an import\n");
+        failures++;
+    } catch (const std::exception& e) {
+        expectContains("bytecode backend rejects imports", e.what(), "Imports are only supported by the C++ backend");
+    }
+
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+    if (failures) {
+        std::printf("%d case(s) failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
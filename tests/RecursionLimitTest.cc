@@ -0,0 +1,89 @@
+// 재귀 깊이 테스트
+// 클로저 평가기(Evaluator)와 Zust Machine 이 같은 깊이까지 재귀를 돌리고,
+// 한도를 넘으면 둘 다 "Stack overflow" 로 멈추는지 본다.
+#include <CallDepth.hh>
+#include <Compiler.hh>
+#include <Evaluator.hh>
+#include <Program.hh>
+#include <ZustMachine.hh>
+
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+static int failures = 0;
+
+static std::string program(int depth) {
+    return "fn down(int n) : int {\n"
+           "    if (n == 0) { return 0; }\n"
+           "    return down(n - 1) + 1;\n"
+           "}\n"
+           "fn main() : int { return down(" + std::to_string(depth) + "); }\n";
+}
+
+// 돌린 결과. 넘쳤으면 overflow 가 켜진다.
+struct Outcome {
+    bool overflow = false;
+    int64_t value = 0;
+};
+
+static Outcome evaluate(const std::string& source) {
+    Compiler compiler;
+    std::unique_ptr<Program> ast = compiler.analyze(SourceBuffer(source));
+    Evaluator evaluator;
+    evaluator.load(ast.get());
+    Outcome outcome;
+    try {
+        // 같은 평가기를 두 번 돌린다. 두 번째는 처음에 만든 깊은 스택 스레드를 다시 쓴다.
+        outcome.value = evaluator.run();
+        if (evaluator.run() != outcome.value) throw std::logic_error("second run differs");
+    } catch (const std::runtime_error& e) {
+        if (std::string(e.what()).find("Stack overflow") == std::string::npos) throw;
+        outcome.overflow = true;
+    }
+    return outcome;
+}
+
+static Outcome interpret(const std::string& source) {
+    Compiler compiler;
+    Module module = compiler.compileToBytecode(SourceBuffer(source));
+    ZustMachine machine(module);
+    Outcome outcome;
+    try {
+        outcome.value = machine.run().i;
+    } catch (const std::runtime_error& e) {
+        if (std::string(e.what()).find("Stack overflow") == std::string::npos) throw;
+        outcome.overflow = true;
+    }
+    return outcome;
+}
+
+static void check(int depth, bool overflow) {
+    std::string source = program(depth);
+    Outcome closure = evaluate(source);
+    Outcome machine = interpret(source);
+    bool ok = closure.overflow == overflow && machine.overflow == overflow &&
+              (overflow || (closure.value == depth && machine.value == depth));
+    std::printf("%s depth %d: evaluator %s, machine %s\n", ok ? "ok  " : "FAIL", depth,
+                closure.overflow ? "overflow" : std::to_string(closure.value).c_str(),
+                machine.overflow ? "overflow" : std::to_string(machine.value).c_str());
+    if (!ok) failures++;
+}
+
+int main() {
+    try {
+        check(10000, false);
+        // main 도 한 프레임이므로 down 은 MaxCallDepth - 1 번까지 겹칠 수 있다
+        check(static_cast<int>(MaxCallDepth) - 2, false);
+        check(static_cast<int>(MaxCallDepth), true);
+    } catch (const std::exception& e) {
+        std::printf("FAIL %s\n", e.what());
+        failures++;
+    }
+    if (failures) {
+        std::printf("%d case(s) failed\n", failures);
+        return 1;
+    }
+    return 0;
+}